@@ -27,6 +27,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 - (void)stop;
 
 - (void)pushVideoFrame:(ECVVideoFrame *const)frame;
-- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue;
+- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue presentationTime:(NSTimeInterval const)time; // Of the first sample, on the same clock as -[ECVVideoFrame presentationTime].
 
 @end
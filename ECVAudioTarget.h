@@ -56,7 +56,7 @@ extern NSString *const ECVCaptureDeviceVolumeDidChangeNotification;
 - (void)play;
 - (void)stop;
 
-- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue;
+- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue presentationTime:(NSTimeInterval const)time;
 
 @end
 
@@ -148,7 +148,7 @@ static NSString *const ECVUpconvertsFromMonoKey = @"ECVUpconvertsFromMono";
 	_audioPipe = nil;
 }
 - (void)pushVideoFrame:(ECVVideoFrame *const)frame {}
-- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue
+- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue presentationTime:(NSTimeInterval const)time
 {
 	[_audioPipe receiveInputBufferList:[bufferListValue pointerValue]];
 }
@@ -28,6 +28,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 @class ECVVideoFormat;
 @class ECVVideoFrame;
 @class ECVMovieRecorder;
+@class ECVStreamWriter;
+@class ECVHistoryBuffer;
+@class ECVMotionDetector;
+@class ECVPreviewRenderer;
 
 // Views
 #import "ECVVideoView.h"
@@ -67,6 +71,13 @@ typedef NSInteger ECVCropBorder;
 	BOOL _fullScreen;
 	ECVPlayButtonCell *_playButtonCell;
 	ECVMovieRecorder *_movieRecorder;
+	ECVStreamWriter *_streamWriter;
+	ECVHistoryBuffer *_historyBuffer;
+	ECVMotionDetector *_motionDetector; // Set while armed for motion-triggered recording.
+	NSURL *_motionRecordingURL;
+	NSUInteger _motionRecordingCount;
+	BOOL _recordingPaused; // Between stretches of motion. The movie recorder stays open with its segment closed.
+	ECVPreviewRenderer *_previewRenderer;
 
 	ECVCropBorder _cropBorder;
 	ECVAspectRatio _cropSourceAspectRatio;
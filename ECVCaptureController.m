@@ -32,8 +32,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVVideoStorage.h"
 #import "ECVVideoFrame.h"
 #import "ECVMovieRecorder.h"
+#import "ECVStreamWriter.h"
+#import "ECVHistoryBuffer.h"
+#import "ECVMotionDetector.h"
 #import "ECVFrameRateConverter.h"
 #import "ECVAudioTarget.h"
+#import "ECVPreviewRenderer.h"
 
 // Views
 #import "MPLWindow.h"
@@ -44,20 +48,47 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 // Controllers
 #import "ECVConfigController.h"
 
+// Other Sources
+#import "ECVDebug.h"
+#import "ECVLosslessCodec.h"
+
 static NSString *const ECVAspectRatio2Key = @"ECVAspectRatio2";
 static NSString *const ECVVsyncKey = @"ECVVsync";
 static NSString *const ECVMagFilterKey = @"ECVMagFilter";
 static NSString *const ECVShowDroppedFramesKey = @"ECVShowDroppedFrames";
+static NSString *const ECVVideoLatencyKey = @"ECVVideoLatency"; // Seconds of jitter buffering. The view adds more if frames arrive unevenly.
 static NSString *const ECVVideoCodecKey = @"ECVVideoCodec";
 static NSString *const ECVVideoQualityKey = @"ECVVideoQuality";
+static NSString *const ECVRecordingOverflowPolicyKey = @"ECVRecordingOverflowPolicy";
+static NSString *const ECVRecordingEncoderCountKey = @"ECVRecordingEncoderCount";
+static NSString *const ECVRecordingSegmentDurationKey = @"ECVRecordingSegmentDuration";
+static NSString *const ECVRecordingSegmentSizeKey = @"ECVRecordingSegmentSize";
+static NSString *const ECVRecordingScalesInCodecKey = @"ECVRecordingScalesInCodec";
+static NSString *const ECVRecordingScalingFilterKey = @"ECVRecordingScalingFilter"; // ECVPixelBufferScalingFilter.
+static NSString *const ECVRecordingProxyWidthKey = @"ECVRecordingProxyWidth"; // Also record a smaller copy for editing, named "<name> Proxy". 0 disables.
+static NSString *const ECVRecordingProxyCodecKey = @"ECVRecordingProxyCodec";
+static NSString *const ECVRecordingProxyQualityKey = @"ECVRecordingProxyQuality";
+static NSString *const ECVRecordingProxyFrameRateDivisorKey = @"ECVRecordingProxyFrameRateDivisor"; // 2 records every other frame.
+static NSString *const ECVRecordingAdaptiveQualityKey = @"ECVRecordingAdaptiveQuality";
+static NSString *const ECVRecordingUnchangedFrameThresholdKey = @"ECVRecordingUnchangedFrameThreshold"; // About 2.0 suits static sources like cameras and slides.
+static NSString *const ECVRecordingPreRollKey = @"ECVRecordingPreRoll"; // Seconds of history kept so recordings start in the past. Read when the window opens.
+static NSString *const ECVRecordingPreRollCompressesKey = @"ECVRecordingPreRollCompresses";
+static NSString *const ECVRecordingMotionTriggeredKey = @"ECVRecordingMotionTriggered"; // Record only while something moves, combined with the pre-roll above.
+static NSString *const ECVRecordingMotionPostRollKey = @"ECVRecordingMotionPostRoll";
+static NSString *const ECVRecordingMotionSensitivityKey = @"ECVRecordingMotionSensitivity";
 static NSString *const ECVCropRectKey = @"ECVCropRect";
 static NSString *const ECVCropSourceAspectRatioKey = @"ECVCropSourceAspectRatio";
 static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 
-@interface ECVCaptureController(Private)
+@interface ECVCaptureController(Private) <ECVPreviewRendererDelegate, ECVMotionDetectorDelegate>
 
+- (BOOL)_startRecordingToURL:(NSURL *const)URL error:(out NSError **const)outError;
+- (void)_stopRecording;
+- (void)_motionDidStart;
+- (void)_motionDidStop;
 - (void)_hideMenuBar;
 - (void)_updateCropRect;
+- (void)_stopPreviewRenderer;
 
 @end
 
@@ -92,23 +123,21 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 
 - (IBAction)startRecording:(id)sender
 {
-#if __LP64__
-	NSAlert *const alert = [[[NSAlert alloc] init] autorelease];
-	[alert setMessageText:NSLocalizedString(@"Recording is not supported in 64-bit mode.", nil)];
-	[alert setInformativeText:NSLocalizedString(@"Relaunch EasyCapViewer in 32-bit mode to record.", nil)];
-	[alert addButtonWithTitle:NSLocalizedString(@"OK", nil)];
-	[alert runModal];
-#else
-	if(_movieRecorder) return;
+	if(_movieRecorder || _streamWriter || _motionDetector) return;
 
 	NSUserDefaults *const d = [NSUserDefaults standardUserDefaults];
 
 	NSSavePanel *const savePanel = [NSSavePanel savePanel];
-	[savePanel setAllowedFileTypes:[NSArray arrayWithObject:@"mov"]];
+#if __LP64__
+	[savePanel setAllowedFileTypes:[NSArray arrayWithObjects:@"mkv", @"y4m", nil]]; // QuickTime movies need the 32-bit Movie Toolbox.
+#else
+	[savePanel setAllowedFileTypes:[NSArray arrayWithObjects:@"mov", @"mkv", @"y4m", nil]];
+#endif
 	[savePanel setCanCreateDirectories:YES];
 	[savePanel setCanSelectHiddenExtension:YES];
 	[savePanel setPrompt:NSLocalizedString(@"Record", nil)];
 	[savePanel setAccessoryView:exportAccessoryView];
+	[savePanel setDelegate:self];
 
 	[videoCodecPopUp removeAllItems];
 	NSArray *const videoCodecs = [[NSBundle mainBundle] objectForInfoDictionaryKey:@"ECVVideoCodecs"];
@@ -128,39 +157,31 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 	[d setObject:[NSNumber numberWithDouble:[videoQualitySlider doubleValue]] forKey:ECVVideoQualityKey];
 	if(NSFileHandlingPanelOKButton != returnCode) return;
 
-	ECVMovieRecordingOptions *const options = [[[ECVMovieRecordingOptions alloc] init] autorelease];
-	[options setURL:[savePanel URL]];
-	[options setVideoStorage:[[[self captureDocument] videoDevice] videoStorage]];
-	[options setAudioInput:[[self captureDocument] audioDevice]];
-
-	[options setVideoCodec:(OSType)[videoCodecPopUp selectedTag]];
-	[options setVideoQuality:[videoQualitySlider doubleValue]];
-	[options setOutputSize:ECVIntegerSizeFromNSSize([self outputSize])];
-	[options setCropRect:[self cropRect]];
-	[options setUpconvertsFromMono:[[[self captureDocument] audioTarget] upconvertsFromMono]];
-	[options setFrameRate:[[self videoFormat] frameRate]];
-
-	NSError *error = nil;
-	ECVMovieRecorder *const recorder = [[[ECVMovieRecorder alloc] initWithOptions:options error:&error] autorelease];
-	if(recorder) {
-		@synchronized(self) {
-			_movieRecorder = [recorder retain];
-		}
+	if([d boolForKey:ECVRecordingMotionTriggeredKey]) {
+		// Armed: each stretch of motion is recorded to its own numbered file.
+		_motionRecordingURL = [[savePanel URL] copy];
+		_motionRecordingCount = 0;
+		_motionDetector = [[ECVMotionDetector alloc] initWithPostRoll:[d doubleForKey:ECVRecordingMotionPostRollKey] sensitivity:[d doubleForKey:ECVRecordingMotionSensitivityKey]];
+		[_motionDetector setDelegate:self];
+		[[self captureDocument] addTarget:_motionDetector];
 		[[self window] setDocumentEdited:YES];
-	} else [[NSAlert alertWithError:error] runModal];
-#endif
+		return;
+	}
+	NSError *error = nil;
+	if(![self _startRecordingToURL:[savePanel URL] error:&error] && error) [[NSAlert alertWithError:error] runModal];
 }
 - (IBAction)stopRecording:(id)sender
 {
-#if !__LP64__
-	if(!_movieRecorder) return;
-	[_movieRecorder stopRecording];
-	@synchronized(self) {
-		[_movieRecorder release];
-		_movieRecorder = nil;
+	if(_motionDetector) {
+		[[self captureDocument] removeTarget:_motionDetector];
+		[_motionDetector setDelegate:nil];
+		[_motionDetector release];
+		_motionDetector = nil;
+		[_motionRecordingURL release];
+		_motionRecordingURL = nil;
 	}
+	[self _stopRecording];
 	[[self window] setDocumentEdited:NO];
-#endif
 }
 - (IBAction)changeCodec:(id)sender
 {
@@ -361,6 +382,159 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 
 #pragma mark -ECVCaptureController(Private)
 
+- (BOOL)_startRecordingToURL:(NSURL *const)URL error:(out NSError **const)outError
+{
+	if(outError) *outError = nil;
+	Class const writerClass = [ECVStreamWriter writerClassForPathExtension:[[URL path] pathExtension]];
+	if(writerClass) {
+		NSUserDefaults *const d = [NSUserDefaults standardUserDefaults];
+		if([d doubleForKey:ECVRecordingSegmentDurationKey] > 0.0 || [[d objectForKey:ECVRecordingSegmentSizeKey] unsignedLongLongValue]) ECVLog(ECVWarning, @"%@ files aren't split into segments; recording one file.", [[[URL path] pathExtension] uppercaseString]); // Only the QuickTime recorder switches files on key frames.
+		ECVStreamWriter *const writer = [[[writerClass alloc] initWithURL:URL videoStorage:[[[self captureDocument] videoDevice] videoStorage] videoCodec:(OSType)[videoCodecPopUp selectedTag] audioInput:[[self captureDocument] audioDevice] upconvertsFromMono:[[[self captureDocument] audioTarget] upconvertsFromMono] error:outError] autorelease];
+		if(writer) {
+			@synchronized(self) {
+				_streamWriter = [writer retain];
+			}
+			[_historyBuffer startReplayingToRecipient:writer];
+			[[self window] setDocumentEdited:YES];
+		}
+		return !!writer;
+	}
+
+#if !__LP64__
+	NSUserDefaults *const d = [NSUserDefaults standardUserDefaults];
+	ECVMovieRecordingOptions *const options = [[[ECVMovieRecordingOptions alloc] init] autorelease];
+	[options setURL:URL];
+	[options setVideoStorage:[[[self captureDocument] videoDevice] videoStorage]];
+	[options setAudioInput:[[self captureDocument] audioDevice]];
+
+	[options setVideoCodec:(OSType)[videoCodecPopUp selectedTag]];
+	[options setVideoQuality:[videoQualitySlider doubleValue]];
+	[options setOutputSize:ECVIntegerSizeFromNSSize([self outputSize])];
+	[options setCropRect:[self cropRect]];
+	[options setUpconvertsFromMono:[[[self captureDocument] audioTarget] upconvertsFromMono]];
+	[options setFrameRate:[[self videoFormat] frameRate]];
+	[options setOverflowPolicy:[d integerForKey:ECVRecordingOverflowPolicyKey]];
+	[options setEncoderCount:(NSUInteger)MAX([d integerForKey:ECVRecordingEncoderCountKey], 0)];
+	[options setSegmentDuration:MAX([d doubleForKey:ECVRecordingSegmentDurationKey], 0.0)];
+	[options setSegmentSize:[[d objectForKey:ECVRecordingSegmentSizeKey] unsignedLongLongValue]];
+	[options setSplitsOnRequest:!!_motionDetector]; // Each stretch of motion gets its own file.
+	[options setBufferSize:(unsigned long long)MAX([d integerForKey:ECVRecordingBufferSizeKey], 0)];
+	[options setScalesInCodec:[d boolForKey:ECVRecordingScalesInCodecKey]];
+	[options setScalingFilter:[d integerForKey:ECVRecordingScalingFilterKey]];
+	[options setAdaptsQuality:[d boolForKey:ECVRecordingAdaptiveQualityKey]];
+	[options setUnchangedFrameThreshold:MAX([d doubleForKey:ECVRecordingUnchangedFrameThresholdKey], 0.0)];
+
+	NSInteger const proxyWidth = [d integerForKey:ECVRecordingProxyWidthKey];
+	if(proxyWidth > 0) {
+		NSString *const path = [URL path];
+		NSString *const name = [NSString stringWithFormat:@"%@ Proxy", [[path lastPathComponent] stringByDeletingPathExtension]];
+		ECVIntegerSize const outputSize = [options outputSize];
+		ECVMovieRecordingOptions *const proxyOptions = [[[ECVMovieRecordingOptions alloc] init] autorelease];
+		[proxyOptions setURL:[NSURL fileURLWithPath:[[[path stringByDeletingLastPathComponent] stringByAppendingPathComponent:name] stringByAppendingPathExtension:[path pathExtension]]]];
+		[proxyOptions setVideoStorage:[options videoStorage]];
+		[proxyOptions setAudioInput:[options audioInput]];
+
+		[proxyOptions setVideoCodec:NSHFSTypeCodeFromFileType([d objectForKey:ECVRecordingProxyCodecKey])];
+		[proxyOptions setVideoQuality:[d doubleForKey:ECVRecordingProxyQualityKey]];
+		[proxyOptions setOutputSize:(ECVIntegerSize){(NSUInteger)proxyWidth, round(proxyWidth * outputSize.height / (double)MAX(outputSize.width, 1) / 2.0) * 2.0}];
+		[proxyOptions setCropRect:[options cropRect]];
+		[proxyOptions setUpconvertsFromMono:[options upconvertsFromMono]];
+		[proxyOptions setFrameRate:[ECVFrameRateConverter frameRateWithRatio:ECVMakeRational(1, MAX([d integerForKey:ECVRecordingProxyFrameRateDivisorKey], 1)) ofFrameRate:[options frameRate]]];
+		[proxyOptions setOverflowPolicy:[options overflowPolicy]];
+		[proxyOptions setEncoderCount:2]; // Proxies are small, so a session per core would mostly compete with the main recording.
+		[proxyOptions setSegmentDuration:[options segmentDuration]];
+		[proxyOptions setSegmentSize:[options segmentSize]];
+		[proxyOptions setSplitsOnRequest:[options splitsOnRequest]];
+		[proxyOptions setBufferSize:[options bufferSize]];
+		[proxyOptions setScalingFilter:[options scalingFilter]];
+		[proxyOptions setAdaptsQuality:[options adaptsQuality]];
+		[options setProxies:[NSArray arrayWithObject:proxyOptions]];
+	}
+
+	ECVMovieRecorder *const recorder = [[[ECVMovieRecorder alloc] initWithOptions:options error:outError] autorelease];
+	if(recorder) {
+		@synchronized(self) {
+			_movieRecorder = [recorder retain];
+		}
+		[_historyBuffer startReplayingToRecipient:recorder];
+		[[self window] setDocumentEdited:YES];
+	}
+	return !!recorder;
+#else
+	if(outError) *outError = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileWriteUnknownError userInfo:[NSDictionary dictionaryWithObjectsAndKeys:
+		[NSString stringWithFormat:NSLocalizedString(@"The recording could not be saved as \"%@\".", nil), [[URL path] lastPathComponent]], NSLocalizedDescriptionKey,
+		NSLocalizedString(@"QuickTime movies can only be recorded by the 32-bit version. Use the .mkv or .y4m extension instead.", nil), NSLocalizedRecoverySuggestionErrorKey,
+		URL, NSURLErrorKey,
+		nil]];
+	return NO;
+#endif
+}
+- (void)_stopRecording
+{
+	[_historyBuffer stopReplaying];
+	[_historyBuffer empty]; // It's all in the file now, so the next recording mustn't replay any of it.
+	@synchronized(self) {
+		_recordingPaused = NO;
+	}
+	if(_streamWriter) {
+		[_streamWriter stopRecording];
+		@synchronized(self) {
+			[_streamWriter release];
+			_streamWriter = nil;
+		}
+	}
+#if !__LP64__
+	if(!_movieRecorder) return;
+	[_movieRecorder stopRecording];
+	@synchronized(self) {
+		[_movieRecorder release];
+		_movieRecorder = nil;
+	}
+#endif
+}
+- (void)_motionDidStart
+{
+	if(!_motionDetector || _streamWriter) return;
+#if !__LP64__
+	if(_movieRecorder) {
+		// Still open from earlier motion. Its next frame starts the next numbered file.
+		@synchronized(self) {
+			_recordingPaused = NO;
+		}
+		[_historyBuffer startReplayingToRecipient:_movieRecorder];
+		ECVLog(ECVNotice, @"Motion detected, recording file %lu.", (unsigned long)[_movieRecorder segmentCount] + 1);
+		return;
+	}
+#endif
+	NSURL *URL = _motionRecordingURL; // The movie recorder numbers its own files.
+	if([ECVStreamWriter writerClassForPathExtension:[[URL path] pathExtension]]) {
+		// Stream writers can't split, so each stretch of motion gets a new one.
+		NSString *const path = [URL path];
+		NSString *const name = [NSString stringWithFormat:@"%@ %03lu", [[path lastPathComponent] stringByDeletingPathExtension], (unsigned long)++_motionRecordingCount];
+		URL = [NSURL fileURLWithPath:[[[path stringByDeletingLastPathComponent] stringByAppendingPathComponent:name] stringByAppendingPathExtension:[path pathExtension]]];
+	}
+	NSError *error = nil;
+	if([self _startRecordingToURL:URL error:&error]) ECVLog(ECVNotice, @"Motion detected, recording to %@.", [URL path]);
+	else ECVLog(ECVError, @"Motion recording could not be started: %@", error);
+}
+- (void)_motionDidStop
+{
+	if(!_motionDetector) return;
+#if !__LP64__
+	if(_movieRecorder) {
+		[_historyBuffer stopReplaying];
+		@synchronized(self) {
+			_recordingPaused = YES; // Before closing, so no live frame slips into the next file.
+		}
+		[_movieRecorder closeSegment];
+		[_historyBuffer empty]; // Already recorded, so the next stretch of motion only reaches back past this point.
+		ECVLog(ECVNotice, @"Motion stopped.");
+		return;
+	}
+#endif
+	[self _stopRecording];
+	ECVLog(ECVNotice, @"Motion stopped.");
+}
 - (void)_hideMenuBar
 {
 #if __LP64__
@@ -382,6 +556,15 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 	[[NSUserDefaults standardUserDefaults] setInteger:_cropSourceAspectRatio forKey:ECVCropSourceAspectRatioKey];
 	[[NSUserDefaults standardUserDefaults] setInteger:_cropBorder forKey:ECVCropBorderKey];
 }
+- (void)_stopPreviewRenderer
+{
+	if(!_previewRenderer) return;
+	[[self captureDocument] removeTarget:_previewRenderer];
+	[_previewRenderer setDelegate:nil];
+	[_previewRenderer release];
+	_previewRenderer = nil;
+	[[self window] setMiniwindowImage:nil];
+}
 
 #pragma mark -NSWindowController
 
@@ -393,8 +576,28 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 		[NSNumber numberWithBool:YES], ECVVsyncKey,
 		[NSNumber numberWithInteger:GL_LINEAR], ECVMagFilterKey,
 		[NSNumber numberWithBool:NO], ECVShowDroppedFramesKey,
+		[NSNumber numberWithDouble:0.0], ECVVideoLatencyKey,
 		NSFileTypeForHFSTypeCode("jpeg"), ECVVideoCodecKey,
 		[NSNumber numberWithDouble:0.5f], ECVVideoQualityKey,
+		[NSNumber numberWithInteger:ECVRecordingRepeatFrames], ECVRecordingOverflowPolicyKey,
+		[NSNumber numberWithUnsignedInteger:0], ECVRecordingEncoderCountKey,
+		[NSNumber numberWithDouble:0.0], ECVRecordingSegmentDurationKey,
+		[NSNumber numberWithUnsignedLongLong:0], ECVRecordingSegmentSizeKey,
+		[NSNumber numberWithBool:NO], ECVRecordingScalesInCodecKey,
+		[NSNumber numberWithUnsignedInteger:ECVScaleArea], ECVRecordingScalingFilterKey,
+		[NSNumber numberWithInteger:0], ECVRecordingProxyWidthKey,
+		NSFileTypeForHFSTypeCode("jpeg"), ECVRecordingProxyCodecKey,
+		[NSNumber numberWithDouble:0.5], ECVRecordingProxyQualityKey,
+		[NSNumber numberWithInteger:1], ECVRecordingProxyFrameRateDivisorKey,
+		[NSNumber numberWithBool:NO], ECVRecordingAdaptiveQualityKey,
+		[NSNumber numberWithDouble:0.0], ECVRecordingUnchangedFrameThresholdKey,
+		[NSNumber numberWithDouble:0.0], ECVRecordingPreRollKey,
+		[NSNumber numberWithBool:YES], ECVRecordingPreRollCompressesKey,
+		[NSNumber numberWithBool:NO], ECVRecordingMotionTriggeredKey,
+		[NSNumber numberWithDouble:5.0], ECVRecordingMotionPostRollKey,
+		[NSNumber numberWithDouble:4.0], ECVRecordingMotionSensitivityKey,
+		[NSNumber numberWithUnsignedInteger:256 * 1024 * 1024], ECVRecordingBufferSizeKey,
+		[NSNumber numberWithDouble:5.0], ECVRecordingSyncIntervalKey,
 		NSStringFromRect(ECVUncroppedRect), ECVCropRectKey,
 		[NSNumber numberWithInteger:ECVAspectRatioUnknown], ECVCropSourceAspectRatioKey,
 		[NSNumber numberWithInteger:ECVCropBorderNone], ECVCropBorderKey,
@@ -405,6 +608,9 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 	[videoView setCropRect:NSRectFromString([d objectForKey:ECVCropRectKey])];
 	[self _updateCropRect];
 
+	NSTimeInterval const preRoll = [d doubleForKey:ECVRecordingPreRollKey];
+	if(preRoll > 0.0) _historyBuffer = [[ECVHistoryBuffer alloc] initWithDuration:preRoll compresses:[d boolForKey:ECVRecordingPreRollCompressesKey]];
+
 	[self setAspectRatio:[self sizeWithAspectRatio:[[d objectForKey:ECVAspectRatio2Key] unsignedIntegerValue]]];
 
 	NSWindow *const w = [self window];
@@ -415,6 +621,7 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 	[videoView setVsync:[d boolForKey:ECVVsyncKey]];
 	[videoView setShowDroppedFrames:[d boolForKey:ECVShowDroppedFramesKey]];
 	[videoView setMagFilter:(GLint)[d integerForKey:ECVMagFilterKey]];
+	[videoView setTargetLatency:[d doubleForKey:ECVVideoLatencyKey]];
 
 	_playButtonCell = [[ECVPlayButtonCell alloc] initWithOpenGLContext:[videoView openGLContext]];
 	[_playButtonCell setImage:[ECVPlayButtonCell playButtonImage]];
@@ -437,6 +644,12 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 {
 	[_playButtonCell release];
 	[_movieRecorder release];
+	[_streamWriter release];
+	[_historyBuffer release];
+	[_motionDetector release];
+	[_motionRecordingURL release];
+	[_previewRenderer setDelegate:nil];
+	[_previewRenderer release];
 	[super dealloc];
 }
 
@@ -444,25 +657,33 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 
 - (void)play
 {
+	[_historyBuffer empty]; // Don't reach back across a pause.
 	[videoView setVideoStorage:[[self videoDevice] videoStorage]];
 	[videoView startDrawing];
 }
 - (void)stop
 {
 	[videoView stopDrawing];
+	ECVLog(ECVNotice, @"Display latency %.0f ms (%.0f ms buffered), %.2f ms rendering per refresh, frames locked %.2f ms.", [videoView displayLatency] * 1000.0, [videoView bufferLatency] * 1000.0, [videoView renderTime] * 1000.0, [videoView framePinTime] * 1000.0);
 	[self stopRecording:self];
 }
 - (void)pushVideoFrame:(ECVVideoFrame *const)frame
 {
 	[videoView pushFrame:frame];
-	if(_movieRecorder) @synchronized(self) {
+	if(_historyBuffer) return [_historyBuffer addVideoFrame:frame]; // Passed on to the recording once it has caught up with the history.
+	if(_movieRecorder || _streamWriter) @synchronized(self) {
+		if(_recordingPaused) return;
 		[_movieRecorder addVideoFrame:frame];
+		[_streamWriter addVideoFrame:frame];
 	}
 }
-- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue
+- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue presentationTime:(NSTimeInterval const)time
 {
-	if(_movieRecorder) @synchronized(self) {
-		[_movieRecorder addAudioBufferList:[bufferListValue pointerValue]];
+	if(_historyBuffer) return [_historyBuffer addAudioBufferList:[bufferListValue pointerValue] presentationTime:time];
+	if(_movieRecorder || _streamWriter) @synchronized(self) {
+		if(_recordingPaused) return;
+		[_movieRecorder addAudioBufferList:[bufferListValue pointerValue] presentationTime:time];
+		[_streamWriter addAudioBufferList:[bufferListValue pointerValue] presentationTime:time];
 	}
 }
 
@@ -493,7 +714,7 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 	if([self isFullScreen]) {
 		if(@selector(changeScale:) == action) return NO;
 	}
-	if(_movieRecorder) {
+	if(_movieRecorder || _streamWriter || _motionDetector) {
 		if(@selector(startRecording:) == action) return NO;
 	} else {
 		if(@selector(stopRecording:) == action) return NO;
@@ -504,6 +725,21 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 	return [self respondsToSelector:action];
 }
 
+#pragma mark -NSObject(NSSavePanelDelegate)
+
+- (BOOL)panel:(id)sender isValidFilename:(NSString *)filename
+{
+	// Our lossless codec is only written to Matroska. QuickTime movies using it wouldn't play anywhere but here.
+	if(ECVLosslessCodecType != (OSType)[videoCodecPopUp selectedTag]) return YES;
+	if([[ECVStreamWriter writerClassForPathExtension:[filename pathExtension]] instancesRespondToSelector:@selector(writeVideoData:)]) return YES;
+	NSAlert *const alert = [[[NSAlert alloc] init] autorelease];
+	[alert setMessageText:NSLocalizedString(@"Lossless (Archival) video can only be recorded to .mkv files.", nil)];
+	[alert setInformativeText:NSLocalizedString(@"Use the .mkv extension, or choose another codec.", nil)];
+	[[alert addButtonWithTitle:NSLocalizedString(@"OK", nil)] setKeyEquivalent:@"\r"];
+	[alert runModal];
+	return NO;
+}
+
 #pragma mark -<ECVCropCellDelegate>
 
 - (void)cropCellDidFinishCropping:(ECVCropCell *)sender
@@ -565,7 +801,40 @@ static NSString *const ECVCropBorderKey = @"ECVCropBorder";
 }
 - (void)windowWillClose:(NSNotification *)aNotif
 {
-	if([aNotif object] == [self window]) [self stopRecording:self];
+	if([aNotif object] != [self window]) return;
+	[self stopRecording:self];
+	[self _stopPreviewRenderer];
+}
+- (void)windowWillMiniaturize:(NSNotification *)aNotif
+{
+	if(_previewRenderer) return;
+	NSSize const s = [self outputSize];
+	_previewRenderer = [[ECVPreviewRenderer alloc] initWithOutputSize:(ECVIntegerSize){128, MAX(1, round(128.0 * s.height / s.width))} interval:1.0];
+	[_previewRenderer setDelegate:self];
+	[[self captureDocument] addTarget:_previewRenderer];
+}
+- (void)windowDidDeminiaturize:(NSNotification *)aNotif
+{
+	[self _stopPreviewRenderer];
+}
+
+#pragma mark -<ECVPreviewRendererDelegate>
+
+- (void)previewRenderer:(ECVPreviewRenderer *const)sender didRenderImage:(CGImageRef const)image
+{
+	if(sender != _previewRenderer || ![[self window] isMiniaturized]) return; // Rendered before we stopped or deminiaturized.
+	[[self window] setMiniwindowImage:[[[NSImage alloc] initWithCGImage:image size:NSZeroSize] autorelease]];
+}
+
+#pragma mark -<ECVMotionDetectorDelegate>
+
+- (void)motionDetectorDidStartDetectingMotion:(ECVMotionDetector *const)sender
+{
+	[self performSelectorOnMainThread:@selector(_motionDidStart) withObject:nil waitUntilDone:NO];
+}
+- (void)motionDetectorDidStopDetectingMotion:(ECVMotionDetector *const)sender
+{
+	[self performSelectorOnMainThread:@selector(_motionDidStop) withObject:nil waitUntilDone:NO];
 }
 
 #pragma mark -
@@ -33,8 +33,37 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 // Models
 @class ECVCaptureDocument;
 @class ECVVideoFrame;
+@class ECVUSBTransferDepthController;
 
 extern NSString *const ECVDeinterlacingModeKey;
+extern NSString *const ECVUSBTransferProfileKey;
+extern NSString *const ECVReadThreadAffinityKey; // When set, each device's read thread gets its own affinity tag so the scheduler spreads devices across caches.
+
+enum {
+	ECVControlWrite = 0,
+	ECVControlRead = 1, // The data is what we expect to read back. Mismatches are logged.
+	ECVControlRegisterWrite = 2, // data[0] is the value. Skipped if the register cache already matches.
+	ECVControlRegisterModify = 3, // data[0] is the bits to set, data[1] the bits to clear.
+	ECVControlUncached = 1 << 7, // Combined with a register write or modify, always sends it. For trigger and GPIO registers, where writing the same value again is the point.
+};
+typedef UInt8 ECVControlRequestType;
+
+#define ECVControlRequestMaximumLength 64
+#define ECVControlRequestDataLength(...) (sizeof((UInt8[]){__VA_ARGS__}) + 0 * sizeof(char[sizeof((UInt8[]){__VA_ARGS__}) <= ECVControlRequestMaximumLength ? 1 : -1])) // A row that doesn't fit fails to compile.
+typedef struct {
+	ECVControlRequestType type;
+	UInt8 request;
+	UInt16 value;
+	UInt16 index;
+	UInt16 length;
+	UInt8 data[ECVControlRequestMaximumLength];
+} ECVControlRequest;
+
+#define ECVControlRequestMake(type, request, value, index, ...) {(type), (request), (value), (index), ECVControlRequestDataLength(__VA_ARGS__), {__VA_ARGS__}}
+#define ECVControlRegisterWriteMake(index, val) {ECVControlRegisterWrite, 0, 0, (index), 1, {(val)}}
+#define ECVControlRegisterModifyMake(index, enable, disable) {ECVControlRegisterModify, 0, 0, (index), 2, {(enable), (disable)}}
+#define ECVControlRegisterStrobeMake(index, val) {ECVControlRegisterWrite | ECVControlUncached, 0, 0, (index), 1, {(val)}}
+#define ECVControlRegisterStrobeModifyMake(index, enable, disable) {ECVControlRegisterModify | ECVControlUncached, 0, 0, (index), 2, {(enable), (disable)}}
 
 extern NSString *const ECVBrightnessKey;
 extern NSString *const ECVContrastKey;
@@ -67,6 +96,23 @@ extern NSString *const ECVHueKey;
 	NSLock *_readLock;
 	BOOL _read;
 	CFRunLoopSourceRef _ignoredEventSource;
+	NSInteger _USBTransferProfile;
+	ECVUSBTransferDepthController *_transferDepthController;
+	NSTimeInterval _playTime;
+	NSTimeInterval _timeToSignalLock;
+	NSTimeInterval _initStartTime;
+	NSRecursiveLock *_controlRequestLock;
+	NSLock *_registerLock;
+	NSMutableDictionary *_registerCache;
+	int32_t volatile _controlRequestCount;
+	int32_t volatile _skippedControlRequestCount;
+	NSUInteger _readThreadAffinityTag;
+	unsigned long long _receivedByteCount;
+	NSUInteger _lostMicroframeCount;
+	NSUInteger _frameCount;
+	NSUInteger _fieldCount;
+	NSTimeInterval _playDuration;
+	NSTimeInterval _fieldArrivalTime;
 }
 
 + (NSArray *)deviceClasses;
@@ -77,6 +123,8 @@ extern NSString *const ECVHueKey;
 + (NSDictionary *)matchingDictionary;
 + (NSArray *)devicesWithIterator:(io_iterator_t const)iterator;
 
++ (NSString *)statisticsDescription; // One line per open device.
+
 + (IOUSBDeviceInterface320 **)USBDeviceWithService:(io_service_t const)service;
 + (IOUSBInterfaceInterface300 **)USBInterfaceWithDevice:(IOUSBDeviceInterface320 **const)device;
 
@@ -87,11 +135,30 @@ extern NSString *const ECVHueKey;
 - (Class)deinterlacingMode;
 - (void)setDeinterlacingMode:(Class const)mode;
 - (ECVVideoStorage *)videoStorage;
+- (NSInteger)USBTransferProfile; // ECVUSBTransferProfile.
+- (void)setUSBTransferProfile:(NSInteger const)profile;
+- (ECVUSBTransferDepthController *)transferDepthController; // Only while playing.
+- (NSTimeInterval)timeToSignalLock; // Since the last -play, or 0 until the signal locks.
+- (NSUInteger)readThreadAffinityTag; // 0 lets the scheduler decide. Devices sharing a tag share a cache.
+- (void)setReadThreadAffinityTag:(NSUInteger const)tag; // Takes effect on the next -play.
+- (NSString *)statisticsDescription; // Since the last -play.
 
 - (BOOL)setAlternateInterface:(u_int8_t)alternateSetting;
 - (BOOL)controlRequestWithType:(u_int8_t)type request:(UInt8 const)request value:(UInt16 const)v index:(UInt16 const)i length:(UInt16 const)length data:(inout void *const)data;
 - (BOOL)readRequest:(UInt8 const)request value:(UInt16 const)v index:(UInt16 const)i length:(UInt16 const)length data:(out void *const)data;
 - (BOOL)writeRequest:(UInt8 const)request value:(UInt16 const)v index:(UInt16 const)i length:(UInt16 const)length data:(in void *const)data;
+- (void)lockControlRequests; // Hold across requests that other threads must not interleave with, such as an I2C write and its status read. Recursive.
+- (void)unlockControlRequests;
+
+// Register access goes through a cache, so redundant writes are never sent. Subclasses must implement the ECVRegisterAbstract methods to use these.
+- (BOOL)readRegister:(UInt16 const)idx value:(out UInt8 *const)outValue;
+- (BOOL)writeRegister:(UInt16 const)idx value:(UInt8 const)value;
+- (BOOL)modifyRegister:(UInt16 const)idx enable:(UInt8 const)enable disable:(UInt8 const)disable;
+- (void)invalidateRegister:(UInt16 const)idx length:(UInt16 const)length; // Forgets registers idx through idx + length - 1.
+- (void)invalidateRegisterCache;
+
+// Requests are pipelined asynchronously, except where a register modification needs a value we haven't cached. Only call from the read thread.
+- (BOOL)performControlRequests:(ECVControlRequest const *const)requests count:(NSUInteger const)count;
 
 
 
@@ -117,6 +184,7 @@ extern NSString *const ECVHueKey;
 
 - (void)read;
 - (BOOL)keepReading;
+- (void)signalDidLock; // Devices that validate their stream call this once it's trustworthy. Otherwise the first pushed frame counts.
 
 @end
 
@@ -136,3 +204,10 @@ extern NSString *const ECVHueKey;
 - (OSType)pixelFormat;
 
 @end
+
+@interface ECVCaptureDevice(ECVRegisterAbstract)
+
+- (ECVControlRequest)requestForReadingRegister:(UInt16 const)idx;
+- (ECVControlRequest)requestForWritingRegister:(UInt16 const)idx value:(UInt8 const)value;
+
+@end
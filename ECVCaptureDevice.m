@@ -22,10 +22,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVCaptureDevice.h"
 #import <IOKit/IOCFPlugIn.h>
 #import <IOKit/IOMessage.h>
+#import <libkern/OSAtomic.h>
 #import <mach/mach_time.h>
+#import <mach/thread_policy.h>
+#import <pthread.h>
 
 // Models
 #import "ECVCaptureDocument.h"
+#import "ECVClockRecovery.h"
 #import "ECVUSBTransferList.h"
 #import "ECVVideoSource.h"
 #import "ECVVideoFormat.h"
@@ -41,8 +45,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVFoundationAdditions.h"
 
 #define ECVNanosecondsPerMillisecond 1e6
+#define ECVControlRequestWindow 8 // Control transfers in flight at once.
+#define ECVControlRequestTimeout 5.0 // Seconds.
+#define ECVMinimumRestartInterval 0.05 // Seconds.
 
 NSString *const ECVDeinterlacingModeKey = @"ECVDeinterlacingMode";
+NSString *const ECVUSBTransferProfileKey = @"ECVUSBTransferProfile";
+NSString *const ECVReadThreadAffinityKey = @"ECVReadThreadAffinity";
 
 NSString *const ECVBrightnessKey = @"ECVBrightness";
 NSString *const ECVContrastKey = @"ECVContrast";
@@ -57,6 +66,15 @@ typedef struct {
 	UInt8 *data;
 } ECVTransfer;
 
+typedef struct {
+	ECVControlRequest request;
+	UInt8 data[ECVControlRequestMaximumLength];
+	IOUSBDevRequest devRequest;
+	IOReturn result;
+	UInt32 length;
+	BOOL pending;
+} ECVControlTransfer;
+
 @interface ECVCaptureDevice(Private)
 
 - (void)_updateVideoStorage;
@@ -66,21 +84,38 @@ typedef struct {
 - (ECVUSBTransferList *)_transferListWithFrameRequestSize:(NSUInteger const)frameRequestSize;
 
 - (void)_read;
+- (void)_configureReadThread;
 - (BOOL)_keepReading;
 - (BOOL)_readTransfer:(inout ECVUSBTransfer *)transfer numberOfMicroframes:(NSUInteger)numberOfMicroframes pipeRef:(UInt8)pipe frameNumber:(inout UInt64 *)frameNumber microsecondsInFrame:(UInt64)microsecondsInFrame millisecondInterval:(UInt8)millisecondInterval;
 - (BOOL)_parseTransfer:(inout ECVUSBTransfer *)transfer numberOfMicroframes:(NSUInteger)numberOfMicroframes frameRequestSize:(NSUInteger)frameRequestSize millisecondInterval:(UInt8)millisecondInterval;
 - (void)_parseFrame:(inout volatile IOUSBLowLatencyIsocFrame *)frame bytes:(UInt8 const *)bytes previousFrame:(IOUSBLowLatencyIsocFrame *)previous millisecondInterval:(UInt8)millisecondInterval;
 
+- (BOOL)_performControlRequest:(inout ECVControlRequest *const)request;
+- (BOOL)_submitControlTransfer:(inout ECVControlTransfer *const)transfer;
+- (BOOL)_finishControlTransfer:(inout ECVControlTransfer *const)transfer;
+- (BOOL)_getCachedRegister:(UInt16 const)idx value:(out UInt8 *const)outValue;
+- (void)_cacheRegister:(UInt16 const)idx value:(UInt8 const)value;
+- (BOOL)_shouldWriteRegister:(UInt16 const)idx value:(UInt8 const)value;
+
 @end
 
 static NSMutableArray *ECVDeviceClasses = nil;
 static NSDictionary *ECVDevicesDictionary = nil;
+static NSLock *ECVOpenDevicesLock = nil;
+static CFMutableArrayRef ECVOpenDevices = NULL; // Non-retaining.
+static NSUInteger ECVLastReadThreadAffinityTag = 0;
 
 static void ECVDeviceRemoved(ECVCaptureDevice *device, io_service_t service, uint32_t messageType, void *messageArgument)
 {
 	if(kIOMessageServiceIsTerminated == messageType) [device performSelector:@selector(invalidate) withObject:nil afterDelay:0.0f inModes:[NSArray arrayWithObject:NSDefaultRunLoopMode]]; // Make sure we don't do anything during a special run loop mode (eg. NSModalPanelRunLoopMode).
 }
 static void ECVDoNothing(void *refcon, IOReturn result, void *arg0) {}
+static void ECVControlTransferCompleted(ECVControlTransfer *const transfer, IOReturn result, void *arg0)
+{
+	transfer->result = result;
+	transfer->length = (UInt32)(uintptr_t)arg0;
+	transfer->pending = NO;
+}
 
 static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interface, UInt8 *const outPipeIndex, UInt8 *const inoutDirection, UInt8 *const inoutTransferType, UInt16 *const inoutPacketSize, UInt8 *const outMillisecondInterval) // TODO: We should have a separate class for USB-specific devices, and this should probably be a method on it.
 {
@@ -158,6 +193,17 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 
 #pragma mark -
 
++ (NSString *)statisticsDescription
+{
+	NSMutableArray *const lines = [NSMutableArray array];
+	[ECVOpenDevicesLock lock];
+	for(ECVCaptureDevice *const device in (NSArray *)ECVOpenDevices) [lines addObject:[device statisticsDescription]];
+	[ECVOpenDevicesLock unlock];
+	return [lines componentsJoinedByString:@"\n"];
+}
+
+#pragma mark -
+
 + (IOUSBDeviceInterface320 **)USBDeviceWithService:(io_service_t const)service
 {
 	mach_timespec_t delay = {
@@ -216,6 +262,8 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 + (void)initialize
 {
 	if(!ECVDeviceClasses) ECVDeviceClasses = [[NSMutableArray alloc] init];
+	if(!ECVOpenDevicesLock) ECVOpenDevicesLock = [[NSLock alloc] init];
+	if(!ECVOpenDevices) ECVOpenDevices = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
 	if(!ECVDevicesDictionary) {
 		ECVDevicesDictionary = [[NSDictionary alloc] initWithContentsOfFile:[[NSBundle bundleForClass:self] pathForResource:@"ECVDevices" ofType:@"plist"]];
 		for(NSString *const name in ECVDevicesDictionary) [self registerDeviceClass:NSClassFromString(name)];
@@ -236,6 +284,9 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 
 		_readThreadLock = [[NSLock alloc] init];
 		_readLock = [[NSLock alloc] init];
+		_controlRequestLock = [[NSRecursiveLock alloc] init];
+		_registerLock = [[NSLock alloc] init];
+		_registerCache = [[NSMutableDictionary alloc] init];
 
 		NSMutableDictionary *properties = nil;
 		(void)ECVIOReturn(IORegistryEntryCreateCFProperties(_service, (CFMutableDictionaryRef *)&properties, kCFAllocatorDefault, kNilOptions));
@@ -252,9 +303,12 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 			[NSNumber numberWithDouble:0.5f], ECVContrastKey,
 			[NSNumber numberWithDouble:0.5f], ECVHueKey,
 			[NSNumber numberWithDouble:0.5f], ECVSaturationKey,
+			[NSNumber numberWithInteger:ECVUSBTransferRobustProfile], ECVUSBTransferProfileKey,
+			[NSNumber numberWithBool:YES], ECVReadThreadAffinityKey,
 			nil]];
 
 		[self setDeinterlacingMode:[ECVDeinterlacingMode deinterlacingModeWithType:[d integerForKey:ECVDeinterlacingModeKey]]];
+		_USBTransferProfile = [d integerForKey:ECVUSBTransferProfileKey];
 		[self loadPreferredVideoSource];
 		[self loadPreferredVideoFormat]; // FIXME: Devices that use SAA711XChip must load it before they invoke [super initWithSerivce:], which is a bit ugly/nonstandard. Maybe they shouldn't override -initWithService: at all, but instead override a custom method.
 
@@ -276,6 +330,11 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 
 		_valid = YES;
 
+		[ECVOpenDevicesLock lock];
+		CFArrayAppendValue(ECVOpenDevices, self);
+		if([d boolForKey:ECVReadThreadAffinityKey]) _readThreadAffinityTag = ++ECVLastReadThreadAffinityTag;
+		[ECVOpenDevicesLock unlock];
+
 		Class const controller = NSClassFromString(@"ECVController"); // FIXME: Kind of a hack.
 		if(controller) (void)ECVIOReturn(IOServiceAddInterestNotification([[controller sharedController] notificationPort], service, kIOGeneralInterest, (IOServiceInterestCallback)ECVDeviceRemoved, self, &_deviceRemovedNotification));
 	}
@@ -308,6 +367,47 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 	[[NSUserDefaults standardUserDefaults] setInteger:[mode deinterlacingModeType] forKey:ECVDeinterlacingModeKey];
 }
 - (ECVVideoStorage *)videoStorage { return [[_videoStorage retain] autorelease]; }
+- (NSInteger)USBTransferProfile
+{
+	return _USBTransferProfile;
+}
+- (void)setUSBTransferProfile:(NSInteger const)profile
+{
+	if(profile == _USBTransferProfile) return;
+	[_captureDocument setPaused:YES];
+	_USBTransferProfile = profile;
+	[_captureDocument setPaused:NO];
+	[[NSUserDefaults standardUserDefaults] setInteger:profile forKey:ECVUSBTransferProfileKey];
+}
+- (ECVUSBTransferDepthController *)transferDepthController
+{
+	[_readLock lock];
+	ECVUSBTransferDepthController *const controller = [[_transferDepthController retain] autorelease];
+	[_readLock unlock];
+	return controller;
+}
+- (NSTimeInterval)timeToSignalLock
+{
+	[_readLock lock];
+	NSTimeInterval const time = _timeToSignalLock;
+	[_readLock unlock];
+	return time;
+}
+- (NSUInteger)readThreadAffinityTag
+{
+	return _readThreadAffinityTag;
+}
+- (void)setReadThreadAffinityTag:(NSUInteger const)tag
+{
+	_readThreadAffinityTag = tag;
+}
+- (NSString *)statisticsDescription
+{
+	[_readLock lock];
+	NSTimeInterval const duration = _read ? [NSDate ECV_timeIntervalSinceReferenceDate] - _playTime : _playDuration;
+	[_readLock unlock];
+	return [NSString stringWithFormat:@"%@: %lu fields, %lu frames, %lu lost packets, %.2f MB/s", [self name], (unsigned long)_fieldCount, (unsigned long)_frameCount, (unsigned long)_lostMicroframeCount, duration > 0.0 ? _receivedByteCount / duration / (1024.0 * 1024.0) : 0.0];
+}
 
 #pragma mark -
 
@@ -320,30 +420,54 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 	UInt8 millisecondInterval = 0;
 	(void)ECVIOReturn(ECVGetPipeWithProperties((void *)_USBInterface, &pipe, &direction, &transferType, &frameRequestSize, &millisecondInterval));
 
+	ECVLog(ECVNotice, @"Initialized %@ in %.0f ms (%lu control requests, %lu skipped).", [self name], ([NSDate ECV_timeIntervalSinceReferenceDate] - _initStartTime) * 1000.0, (unsigned long)_controlRequestCount, (unsigned long)_skippedControlRequestCount);
+
 	UInt32 const microsecondsInFrame = [self _microsecondsInFrame];
 	ECVUSBTransferList *const transferList = [self _transferListWithFrameRequestSize:frameRequestSize];
-	NSUInteger const numberOfTransfers = [transferList numberOfTransfers];
 	NSUInteger const microframesPerTransfer = [transferList microframesPerTransfer];
 	ECVUSBTransfer *const transfers = [transferList transfers];
+	ECVUSBTransferDepthController *const depthController = [[[ECVUSBTransferDepthController alloc] initWithProfile:_USBTransferProfile transferDuration:(UInt64)microframesPerTransfer * microsecondsInFrame * 1000 bytesPerTransfer:microframesPerTransfer * frameRequestSize] autorelease];
+	[_readLock lock];
+	[_transferDepthController release];
+	_transferDepthController = [depthController retain];
+	[_readLock unlock];
 
 	UInt64 currentFrameNumber = 0;
+	NSUInteger depth = [depthController depth];
 	BOOL read = YES;
 	while(read) {
 		NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+		NSUInteger const previousDepth = depth;
+		depth = [depthController updatedDepth];
 		NSUInteger i;
-		for(i = 0; i < numberOfTransfers; ++i) {
+		for(i = 0; i < MAX(depth, previousDepth); ++i) {
 			ECVUSBTransfer *const transfer = transfers + i;
 			read = read && [self _parseTransfer:transfer numberOfMicroframes:microframesPerTransfer frameRequestSize:frameRequestSize millisecondInterval:millisecondInterval];
-			read = read && [self _readTransfer:transfer numberOfMicroframes:microframesPerTransfer pipeRef:pipe frameNumber:&currentFrameNumber microsecondsInFrame:microsecondsInFrame millisecondInterval:millisecondInterval];
+			if(i < depth) read = read && [self _readTransfer:transfer numberOfMicroframes:microframesPerTransfer pipeRef:pipe frameNumber:&currentFrameNumber microsecondsInFrame:microsecondsInFrame millisecondInterval:millisecondInterval];
+			else [transferList invalidateTransfer:transfer]; // Retired until the depth grows again.
 		}
 		if(![self keepReading]) read = NO;
 		[pool drain];
 	}
+
+	ECVLog(ECVNotice, @"Transfer statistics for %@: %@", [self name], depthController);
+	[_readLock lock];
+	[_transferDepthController release];
+	_transferDepthController = nil;
+	[_readLock unlock];
 }
 - (BOOL)keepReading
 {
 	return [self _keepReading];
 }
+- (void)signalDidLock
+{
+	[_readLock lock];
+	NSTimeInterval const time = _timeToSignalLock ? 0 : [NSDate ECV_timeIntervalSinceReferenceDate] - _playTime;
+	if(time) _timeToSignalLock = time;
+	[_readLock unlock];
+	if(time) ECVLog(ECVNotice, @"Signal from %@ locked after %.0f ms.", [self name], time * 1000.0);
+}
 
 #pragma mark -
 
@@ -362,7 +486,10 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 {
 	if(!_USBInterface) return NO;
 	IOUSBDevRequest r = { type, request, v, i, length, data, 0 };
+	OSAtomicIncrement32Barrier(&_controlRequestCount);
+	[_controlRequestLock lock];
 	IOReturn const error = (*_USBInterface)->ControlRequest(_USBInterface, 0, &r);
+	[_controlRequestLock unlock];
 	switch(error) {
 		case kIOReturnSuccess:
 			if(r.wLenDone != r.wLength) {
@@ -384,8 +511,109 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 }
 - (BOOL)writeRequest:(UInt8 const)request value:(UInt16 const)v index:(UInt16 const)i length:(UInt16 const)length data:(in void *const)data
 {
+	[self invalidateRegister:i length:length]; // The write may target cached registers.
 	return [self controlRequestWithType:USBmakebmRequestType(kUSBOut, kUSBVendor, kUSBDevice) request:request value:v index:i length:length data:data];
 }
+- (void)lockControlRequests
+{
+	[_controlRequestLock lock];
+}
+- (void)unlockControlRequests
+{
+	[_controlRequestLock unlock];
+}
+
+#pragma mark -
+
+- (BOOL)readRegister:(UInt16 const)idx value:(out UInt8 *const)outValue
+{
+	if([self _getCachedRegister:idx value:outValue]) return YES;
+	ECVControlRequest request = [self requestForReadingRegister:idx];
+	if(![self _performControlRequest:&request]) return NO;
+	*outValue = request.data[0];
+	[self _cacheRegister:idx value:*outValue];
+	return YES;
+}
+- (BOOL)writeRegister:(UInt16 const)idx value:(UInt8 const)value
+{
+	if(![self _shouldWriteRegister:idx value:value]) return YES;
+	ECVControlRequest request = [self requestForWritingRegister:idx value:value];
+	if([self _performControlRequest:&request]) return YES;
+	[self invalidateRegister:idx length:1];
+	return NO;
+}
+- (BOOL)modifyRegister:(UInt16 const)idx enable:(UInt8 const)enable disable:(UInt8 const)disable
+{
+	NSAssert(!(enable & disable), @"Can't enable and disable the same flag(s).");
+	UInt8 old = 0;
+	if(![self readRegister:idx value:&old]) return NO;
+	return [self writeRegister:idx value:(old | enable) & ~disable];
+}
+- (void)invalidateRegister:(UInt16 const)idx length:(UInt16 const)length
+{
+	[_registerLock lock];
+	UInt16 const count = MAX(length, 1); // Some devices pass the value in wValue and send no data.
+	for(NSUInteger i = 0; i < count; ++i) [_registerCache removeObjectForKey:[NSNumber numberWithUnsignedShort:idx + i]];
+	[_registerLock unlock];
+}
+- (void)invalidateRegisterCache
+{
+	[_registerLock lock];
+	[_registerCache removeAllObjects];
+	[_registerLock unlock];
+}
+
+#pragma mark -
+
+- (BOOL)performControlRequests:(ECVControlRequest const *const)requests count:(NSUInteger const)count
+{
+	if(!_USBInterface) return NO;
+	ECVControlTransfer transfers[ECVControlRequestWindow];
+	NSUInteger submitted = 0;
+	NSUInteger finished = 0;
+	BOOL success = YES;
+	[_controlRequestLock lock]; // Keep other threads' requests out of the pipeline.
+	for(NSUInteger i = 0; i < count && success; ++i) {
+		ECVControlRequest request = requests[i];
+		if(request.length > ECVControlRequestMaximumLength) {
+			ECVLog(ECVError, @"Control request %u is too long (%u > %u bytes)", (unsigned)request.request, (unsigned)request.length, (unsigned)ECVControlRequestMaximumLength);
+			success = NO;
+			break;
+		}
+		ECVControlRequestType const type = request.type & ~ECVControlUncached;
+		if(ECVControlWrite == type) [self invalidateRegister:request.index length:request.length];
+		else if(ECVControlRegisterWrite == type || ECVControlRegisterModify == type) {
+			UInt8 value = request.data[0];
+			if(ECVControlRegisterModify == type) {
+				UInt8 old = 0;
+				if(![self _getCachedRegister:request.index value:&old]) {
+					while(success && finished < submitted) success = [self _finishControlTransfer:transfers + finished++ % ECVControlRequestWindow]; // Everything before this point has to land first.
+					if(!success || ![self readRegister:request.index value:&old]) {
+						success = NO;
+						break;
+					}
+				}
+				value = (old | request.data[0]) & ~request.data[1];
+			}
+			if(ECVControlUncached & request.type) [self _cacheRegister:request.index value:value]; // Sent regardless, but later modifies can still build on it.
+			else if(![self _shouldWriteRegister:request.index value:value]) continue;
+			request = [self requestForWritingRegister:request.index value:value];
+		}
+		if(submitted - finished >= ECVControlRequestWindow) {
+			success = [self _finishControlTransfer:transfers + finished++ % ECVControlRequestWindow];
+			if(!success) break;
+		}
+		ECVControlTransfer *const transfer = transfers + submitted++ % ECVControlRequestWindow;
+		transfer->request = request;
+		success = [self _submitControlTransfer:transfer];
+	}
+	while(finished < submitted) {
+		if(![self _finishControlTransfer:transfers + finished++ % ECVControlRequestWindow]) success = NO;
+	}
+	[_controlRequestLock unlock];
+	if(!success) [self invalidateRegisterCache];
+	return success;
+}
 
 #pragma mark -ECVCaptureDevice(Private)
 
@@ -415,14 +643,26 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 }
 - (ECVUSBTransferList *)_transferListWithFrameRequestSize:(NSUInteger const)frameRequestSize
 {
-	return [[[ECVUSBTransferList alloc] initWithInterface:_USBInterface numberOfTransfers:32 microframesPerTransfer:32 frameRequestSize:frameRequestSize] autorelease];
+	NSUInteger const numberOfTransfers = [ECVUSBTransferDepthController maximumDepthForProfile:_USBTransferProfile]; // Allocate for the worst case up front so the depth can change without reallocating.
+	NSUInteger const microframesPerTransfer = [ECVUSBTransferDepthController microframesPerTransferForProfile:_USBTransferProfile];
+	return [[[ECVUSBTransferList alloc] initWithInterface:_USBInterface numberOfTransfers:numberOfTransfers microframesPerTransfer:microframesPerTransfer frameRequestSize:frameRequestSize] autorelease];
 }
 
 - (void)_read
 {
 	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
 	[_readThreadLock lock];
+	[self _configureReadThread];
+	[NSThread sleepUntilDate:[NSDate dateWithTimeIntervalSinceReferenceDate:_stopTime + ECVMinimumRestartInterval]];
 	if([self _keepReading]) {
+		_initStartTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+		_controlRequestCount = 0;
+		_skippedControlRequestCount = 0;
+		[self invalidateRegisterCache]; // The device may have been reset or unplugged since.
+		_receivedByteCount = 0;
+		_lostMicroframeCount = 0;
+		_frameCount = 0;
+		_fieldCount = 0;
 		ECVLog(ECVNotice, @"Starting device %@.", [self name]);
 		(void)[_captureDocument retain]; // We need it for -pushVideoFrame:. Is this the best solution?
 
@@ -450,10 +690,18 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 
 		[_captureDocument release];
 		ECVLog(ECVNotice, @"Stopping device %@.", [self name]);
+		ECVLog(ECVNotice, @"%@", [ECVCaptureDevice statisticsDescription]);
+		_stopTime = [NSDate timeIntervalSinceReferenceDate];
 	}
 	[_readThreadLock unlock];
 	[pool drain];
 }
+- (void)_configureReadThread
+{
+	[[NSThread currentThread] setName:[NSString stringWithFormat:@"%@ read thread", [self name]]];
+	thread_affinity_policy_data_t policy = {_readThreadAffinityTag};
+	(void)thread_policy_set(pthread_mach_thread_np(pthread_self()), THREAD_AFFINITY_POLICY, (thread_policy_t)&policy, THREAD_AFFINITY_POLICY_COUNT);
+}
 - (BOOL)_keepReading
 {
 	[_readLock lock];
@@ -468,18 +716,28 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 	if(!*frameNumber) *frameNumber = [self _currentFrameNumber] + 10;
 	switch(ECVIOReturn((*_USBInterface)->LowLatencyReadIsochPipeAsync(_USBInterface, pipe, transfer->data, *frameNumber, (UInt32)numberOfMicroframes, millisecondInterval, transfer->frames, ECVDoNothing, NULL))) {
 		case kIOReturnSuccess:
+		{
+			SInt64 const slack = (SInt64)*frameNumber - (SInt64)[self _currentFrameNumber]; // Bus frames are always 1ms.
+			[_transferDepthController noteSubmissionSlack:slack * (SInt64)ECVNanosecondsPerMillisecond];
 			*frameNumber += numberOfMicroframes / (kUSBFullSpeedMicrosecondsInFrame / microsecondsInFrame);
 			return YES;
+		}
 		case kIOReturnIsoTooOld:
 			*frameNumber = 0;
 			NSUInteger i;
-			for(i = 0; i < numberOfMicroframes; ++i) transfer->frames[i].frStatus = kIOReturnInvalid;
+			for(i = 0; i < numberOfMicroframes; ++i) {
+				transfer->frames[i].frStatus = kIOReturnInvalid;
+				transfer->frames[i].frActCount = 0; // Don't parse stale data from the last time around.
+			}
+			[_transferDepthController noteUnderrun];
 			return YES;
 	}
 	return NO;
 }
 - (BOOL)_parseTransfer:(inout ECVUSBTransfer *)transfer numberOfMicroframes:(NSUInteger)numberOfMicroframes frameRequestSize:(NSUInteger)frameRequestSize millisecondInterval:(UInt8)millisecondInterval
 {
+	IOUSBLowLatencyIsocFrame *const last = transfer->frames + numberOfMicroframes - 1;
+	BOOL const submitted = kIOReturnInvalid != last->frStatus;
 	NSUInteger i;
 	for(i = 0; i < numberOfMicroframes; ++i) {
 		IOUSBLowLatencyIsocFrame *const frame = transfer->frames + i;
@@ -487,6 +745,7 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 		IOUSBLowLatencyIsocFrame *const previous = i ? transfer->frames + i - 1 : NULL;
 		[self _parseFrame:frame bytes:bytes previousFrame:previous millisecondInterval:millisecondInterval];
 	}
+	if(submitted) [_transferDepthController noteCompletionTime:UnsignedWideToUInt64(AbsoluteToNanoseconds(last->frTimeStamp))];
 	return YES;
 }
 - (void)_parseFrame:(inout volatile IOUSBLowLatencyIsocFrame *)frame bytes:(UInt8 const *)bytes previousFrame:(IOUSBLowLatencyIsocFrame *)previous millisecondInterval:(UInt8)millisecondInterval
@@ -497,14 +756,109 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 		mach_wait_until(UnsignedWideToUInt64(NanosecondsToAbsolute(nextUpdateTime)));
 	}
 	while(kUSBLowLatencyIsochTransferKey == frame->frStatus) usleep(100); // In case we haven't slept long enough already.
+	if(kIOReturnInvalid == frame->frStatus) { // Never submitted, e.g. after kIOReturnIsoTooOld. Nothing was lost.
+		frame->frStatus = kUSBLowLatencyIsochTransferKey;
+		return;
+	}
+	if(kIOReturnSuccess != frame->frStatus && kIOReturnUnderrun != frame->frStatus) _lostMicroframeCount++; // Underrun just means a short packet.
+	_receivedByteCount += frame->frActCount;
+	_fieldArrivalTime = (NSTimeInterval)UnsignedWideToUInt64(AbsoluteToNanoseconds(frame->frTimeStamp)) * 1e-9; // Any field completed by these bytes arrived with this packet.
 	[self writeBytes:bytes length:frame->frActCount toStorage:_videoStorage];
 	frame->frStatus = kUSBLowLatencyIsochTransferKey;
 }
 
+#pragma mark -
+
+- (BOOL)_performControlRequest:(inout ECVControlRequest *const)request
+{
+	if(request->length > ECVControlRequestMaximumLength) {
+		ECVLog(ECVError, @"Control request %u is too long (%u > %u bytes)", (unsigned)request->request, (unsigned)request->length, (unsigned)ECVControlRequestMaximumLength);
+		return NO;
+	}
+	UInt8 const direction = ECVControlRead == request->type ? kUSBIn : kUSBOut;
+	return [self controlRequestWithType:USBmakebmRequestType(direction, kUSBVendor, kUSBDevice) request:request->request value:request->value index:request->index length:request->length data:request->data];
+}
+- (BOOL)_submitControlTransfer:(inout ECVControlTransfer *const)transfer
+{
+	ECVControlRequest *const request = &transfer->request;
+	BOOL const read = ECVControlRead == request->type;
+	IOUSBDevRequest const r = {
+		USBmakebmRequestType(read ? kUSBIn : kUSBOut, kUSBVendor, kUSBDevice),
+		request->request,
+		request->value,
+		request->index,
+		request->length,
+		read ? transfer->data : request->data,
+		0
+	};
+	transfer->devRequest = r;
+	transfer->length = 0;
+	transfer->pending = YES;
+	OSAtomicIncrement32Barrier(&_controlRequestCount);
+	transfer->result = ECVIOReturn((*_USBInterface)->ControlRequestAsync(_USBInterface, 0, &transfer->devRequest, (IOAsyncCallback1)ECVControlTransferCompleted, transfer));
+	if(kIOReturnSuccess != transfer->result) transfer->pending = NO;
+	return kIOReturnSuccess == transfer->result;
+}
+- (BOOL)_finishControlTransfer:(inout ECVControlTransfer *const)transfer
+{
+	NSTimeInterval const timeout = [NSDate ECV_timeIntervalSinceReferenceDate] + ECVControlRequestTimeout;
+	while(transfer->pending) {
+		(void)CFRunLoopRunInMode(kCFRunLoopDefaultMode, 0.1, true);
+		if(!transfer->pending || [NSDate ECV_timeIntervalSinceReferenceDate] < timeout) continue;
+		ECVLog(ECVError, @"Control request %u timed out", (unsigned)transfer->request.request);
+		(void)ECVIOReturn((*_USBInterface)->AbortPipe(_USBInterface, 0)); // The callback still fires, with kIOReturnAborted.
+		while(transfer->pending) (void)CFRunLoopRunInMode(kCFRunLoopDefaultMode, 0.1, true);
+	}
+	ECVControlRequest const *const request = &transfer->request;
+	switch(transfer->result) {
+		case kIOReturnSuccess: break;
+		case kIOUSBPipeStalled:
+			(void)ECVIOReturn((*_USBInterface)->ClearPipeStall(_USBInterface, 0));
+			return YES;
+		default:
+			(void)ECVIOReturn(transfer->result);
+			return NO;
+	}
+	if(transfer->length != request->length) {
+		ECVLog(ECVError, @"Incomplete transfer, %u of %u", (unsigned int)transfer->length, request->length);
+		return NO;
+	}
+	if(ECVControlRead == request->type && memcmp(request->data, transfer->data, request->length) != 0) ECVLog(ECVNotice, @"Read %04x: Expected %@, received %@", request->index, [NSData dataWithBytesNoCopy:(void *)request->data length:request->length freeWhenDone:NO], [NSData dataWithBytesNoCopy:transfer->data length:request->length freeWhenDone:NO]);
+	return YES;
+}
+- (BOOL)_getCachedRegister:(UInt16 const)idx value:(out UInt8 *const)outValue
+{
+	[_registerLock lock];
+	NSNumber *const value = [_registerCache objectForKey:[NSNumber numberWithUnsignedShort:idx]];
+	if(value) *outValue = [value unsignedCharValue];
+	[_registerLock unlock];
+	return !!value;
+}
+- (void)_cacheRegister:(UInt16 const)idx value:(UInt8 const)value
+{
+	[_registerLock lock];
+	[_registerCache setObject:[NSNumber numberWithUnsignedChar:value] forKey:[NSNumber numberWithUnsignedShort:idx]];
+	[_registerLock unlock];
+}
+- (BOOL)_shouldWriteRegister:(UInt16 const)idx value:(UInt8 const)value
+{
+	UInt8 cached = 0;
+	if([self _getCachedRegister:idx value:&cached] && cached == value) {
+		OSAtomicIncrement32Barrier(&_skippedControlRequestCount);
+		return NO;
+	}
+	[self _cacheRegister:idx value:value];
+	return YES;
+}
+
 #pragma mark -NSObject
 
 - (void)dealloc
 {
+	[ECVOpenDevicesLock lock];
+	CFIndex const i = CFArrayGetFirstIndexOfValue(ECVOpenDevices, CFRangeMake(0, CFArrayGetCount(ECVOpenDevices)), self);
+	if(kCFNotFound != i) CFArrayRemoveValueAtIndex(ECVOpenDevices, i);
+	[ECVOpenDevicesLock unlock];
 	if(_USBDevice) (*_USBDevice)->USBDeviceClose(_USBDevice);
 	if(_USBDevice) (*_USBDevice)->Release(_USBDevice);
 	_USBDevice = NULL;
@@ -519,6 +873,10 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 	[_videoFormat release];
 
 	[_videoStorage release];
+	[_transferDepthController release];
+	[_controlRequestLock release];
+	[_registerLock release];
+	[_registerCache release];
 
 	[super dealloc];
 }
@@ -602,6 +960,8 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 {
 	[_readLock lock];
 	_read = YES;
+	_playTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+	_timeToSignalLock = 0;
 	[_videoStorage empty];
 	[_readLock unlock];
 	[NSThread detachNewThreadSelector:@selector(_read) toTarget:self withObject:nil];
@@ -609,13 +969,19 @@ static IOReturn ECVGetPipeWithProperties(IOUSBInterfaceInterface **const interfa
 - (void)stop
 {
 	[_readLock lock];
+	if(_read) _playDuration = [NSDate ECV_timeIntervalSinceReferenceDate] - _playTime;
 	_read = NO;
 	[_readLock unlock];
 }
 - (void)pushVideoFrame:(ECVVideoFrame *const)frame
 {
+	_fieldCount++;
+	if(frame) _frameCount++;
+	NSTimeInterval const presentationTime = [[_captureDocument clockRecovery] presentationTimeForFieldAtTime:_fieldArrivalTime];
+	[frame setPresentationTime:presentationTime];
+	if(frame) [self signalDidLock];
 	[_captureDocument pushVideoFrame:frame];
 }
-- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue {}
+- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue presentationTime:(NSTimeInterval const)time {}
 
 @end
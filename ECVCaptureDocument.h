@@ -25,6 +25,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 
 @class ECVAudioTarget;
 @class ECVCaptureDevice;
+@class ECVClockRecovery;
 @class ECVReadWriteLock;
 
 @interface ECVCaptureDocument : NSDocument <ECVAVTarget, ECVAudioDeviceDelegate>
@@ -38,14 +39,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 	ECVReadWriteLock *_targetsLock;
 	NSMutableArray *_targets;
 	ECVAudioTarget *_audioTarget;
-
-	NSTimeInterval _lastStopTime;
+	ECVClockRecovery *_clockRecovery;
 }
 
 - (NSArray *)targets;
 - (void)addTarget:(id<ECVAVTarget> const)target;
 - (void)removeTarget:(id<ECVAVTarget> const)target;
 - (ECVAudioTarget *)audioTarget;
+- (ECVClockRecovery *)clockRecovery; // Shared by the video and audio devices so their timestamps line up.
 
 - (ECVCaptureDevice *)videoDevice;
 - (void)setVideoDevice:(ECVCaptureDevice *const)source;
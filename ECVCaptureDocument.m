@@ -24,8 +24,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVAudioDevice.h"
 #import "ECVAudioTarget.h"
 #import "ECVCaptureController.h"
+#import "ECVClockRecovery.h"
 #import "ECVController.h"
 #import "ECVDebug.h"
+#import "ECVFoundationAdditions.h"
 #import "ECVReadWriteLock.h"
 
 static NSString *const ECVAudioInputUIDKey = @"ECVAudioInputUID";
@@ -59,6 +61,10 @@ static NSString *const ECVAudioInputVideoDevice = @"ECVAudioInputVideoDevice";
 {
 	return [[_audioTarget retain] autorelease];
 }
+- (ECVClockRecovery *)clockRecovery
+{
+	return _clockRecovery;
+}
 
 #pragma mark -
 
@@ -151,7 +157,7 @@ static NSString *const ECVAudioInputVideoDevice = @"ECVAudioInputVideoDevice";
 
 - (void)play
 {
-	[NSThread sleepUntilDate:[NSDate dateWithTimeIntervalSinceReferenceDate:_lastStopTime + 0.75]];
+	[_clockRecovery resetWithFieldDuration:CMTimeGetSeconds([[_videoDevice videoFormat] frameRate]) sampleRate:_audioDevice ? [[_audioDevice stream] basicDescription].mSampleRate : 0.0];
 	if(_audioDevice) [self addTarget:_audioTarget];
 	[_videoDevice play];
 	[_audioDevice start];
@@ -165,7 +171,7 @@ static NSString *const ECVAudioInputVideoDevice = @"ECVAudioInputVideoDevice";
 	[_videoDevice stop];
 	[_audioDevice stop];
 	[self removeTarget:_audioTarget];
-	_lastStopTime = [NSDate timeIntervalSinceReferenceDate];
+	ECVLog(ECVNotice, @"%@", [_clockRecovery statisticsDescription]);
 }
 - (void)pushVideoFrame:(ECVVideoFrame *const)frame
 {
@@ -174,15 +180,20 @@ static NSString *const ECVAudioInputVideoDevice = @"ECVAudioInputVideoDevice";
 	[_targets makeObjectsPerformSelector:@selector(pushVideoFrame:) withObject:frame];
 	[_targetsLock unlock];
 }
-- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue {}
+- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue presentationTime:(NSTimeInterval const)time {}
 
 #pragma mark -ECVCaptureDocument<ECVAudioDeviceDelegate>
 
 - (void)audioInput:(ECVAudioInput *const)sender didReceiveBufferList:(AudioBufferList const *const)bufferList atTime:(AudioTimeStamp const *const)t
 {
 	if(sender != _audioDevice) return;
+	NSTimeInterval time = [NSDate ECV_timeIntervalSinceReferenceDate];
+	if((kAudioTimeStampHostTimeValid | kAudioTimeStampSampleTimeValid) == (t->mFlags & (kAudioTimeStampHostTimeValid | kAudioTimeStampSampleTimeValid))) {
+		time = [_clockRecovery presentationTimeForAudioSampleTime:t->mSampleTime atTime:(NSTimeInterval)AudioConvertHostTimeToNanos(t->mHostTime) * 1e-9];
+	}
+	NSValue *const bufferListValue = [NSValue valueWithPointer:bufferList];
 	[_targetsLock readLock];
-	[_targets makeObjectsPerformSelector:@selector(pushAudioBufferListValue:) withObject:[NSValue valueWithPointer:bufferList]];
+	for(id<ECVAVTarget> const target in _targets) [target pushAudioBufferListValue:bufferListValue presentationTime:time];
 	[_targetsLock unlock];
 }
 
@@ -227,6 +238,7 @@ static NSString *const ECVAudioInputVideoDevice = @"ECVAudioInputVideoDevice";
 		_targets = [[NSMutableArray alloc] init];
 		_audioTarget = [[ECVAudioTarget alloc] init];
 		[_audioTarget setCaptureDocument:self];
+		_clockRecovery = [[ECVClockRecovery alloc] init];
 		[_audioTarget setAudioOutput:[ECVAudioOutput defaultDevice]];
 
 		[[[NSWorkspace sharedWorkspace] notificationCenter] addObserver:self selector:@selector(workspaceWillSleep:) name:NSWorkspaceWillSleepNotification object:[NSWorkspace sharedWorkspace]];
@@ -243,6 +255,7 @@ static NSString *const ECVAudioInputVideoDevice = @"ECVAudioInputVideoDevice";
 	[_targetsLock release];
 	[_targets release];
 	[_audioTarget release];
+	[_clockRecovery release];
 
 	[_videoDevice release];
 	[_audioDevice release];
@@ -0,0 +1,56 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Recovers smoothed video and audio clocks from noisy arrival times and maps both onto the ECV_timeIntervalSinceReferenceDate timeline.
+typedef struct {
+	NSTimeInterval nominalPeriod;
+	NSTimeInterval period;
+	NSTimeInterval time; // Of the last tick.
+	NSTimeInterval jitter;
+	NSUInteger resyncCount;
+	BOOL valid;
+} ECVClockFilter;
+
+@interface ECVClockRecovery : NSObject
+{
+	@private
+	NSLock *_lock;
+	ECVClockFilter _video;
+	ECVClockFilter _audio;
+	Float64 _audioSampleTime;
+}
+
+- (void)resetWithFieldDuration:(NSTimeInterval const)fieldDuration sampleRate:(Float64 const)sampleRate; // Nominal values. Pass 0 for either to pass arrival times through unchanged.
+
+// Times are in seconds. Arrival times are on the host clock; presentation times are on the recovered one.
+- (NSTimeInterval)presentationTimeForFieldAtTime:(NSTimeInterval const)arrivalTime; // Call once per field, in order.
+- (NSTimeInterval)presentationTimeForAudioSampleTime:(Float64 const)sampleTime atTime:(NSTimeInterval const)arrivalTime; // Call once per buffer, in order.
+
+- (NSTimeInterval)fieldDuration;
+- (Float64)sampleRate;
+- (double)videoRateError; // Parts per million relative to the host clock. Positive means fast.
+- (double)audioRateError;
+- (double)drift; // Video relative to audio, in parts per million.
+- (NSTimeInterval)videoJitter;
+- (NSTimeInterval)audioJitter;
+- (NSString *)statisticsDescription;
+
+@end
@@ -0,0 +1,171 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVClockRecovery.h"
+
+// A second order loop: the phase gain trims the estimate toward each arrival, and the much smaller frequency gain slowly corrects the period. Together they critically damp the loop, so arrival jitter averages out without letting real drift accumulate.
+#define ECVClockPhaseGain (1.0 / 16.0)
+#define ECVClockFrequencyGain (ECVClockPhaseGain * ECVClockPhaseGain / (2.0 - ECVClockPhaseGain))
+#define ECVClockMaximumRateError 0.01 // Anything further off than this is a discontinuity, not drift.
+#define ECVClockResyncInterval 0.1 // Seconds.
+
+static void ECVClockFilterReset(ECVClockFilter *const filter, NSTimeInterval const nominalPeriod)
+{
+	*filter = (ECVClockFilter){};
+	filter->nominalPeriod = nominalPeriod;
+	filter->period = nominalPeriod;
+}
+static NSTimeInterval ECVClockFilterUpdate(ECVClockFilter *const filter, Float64 const ticks, NSTimeInterval const arrivalTime)
+{
+	if(filter->valid && ticks > 0.0) {
+		NSTimeInterval const predictedTime = filter->time + ticks * filter->period;
+		NSTimeInterval const error = arrivalTime - predictedTime;
+		if(fabs(error) < ECVClockResyncInterval) {
+			filter->time = predictedTime + ECVClockPhaseGain * error;
+			filter->period = MIN(MAX(filter->period + ECVClockFrequencyGain * error / ticks, filter->nominalPeriod * (1.0 - ECVClockMaximumRateError)), filter->nominalPeriod * (1.0 + ECVClockMaximumRateError));
+			filter->jitter += (fabs(error) - filter->jitter) / 16.0; // As in RTP.
+			return filter->time;
+		}
+		filter->resyncCount++;
+	}
+	filter->time = arrivalTime;
+	filter->valid = YES;
+	return filter->time;
+}
+static double ECVClockFilterRateError(ECVClockFilter const *const filter)
+{
+	if(!filter->valid || filter->period <= 0.0) return 0.0;
+	return (filter->nominalPeriod / filter->period - 1.0) * 1e6;
+}
+
+@implementation ECVClockRecovery
+
+#pragma mark -ECVClockRecovery
+
+- (void)resetWithFieldDuration:(NSTimeInterval const)fieldDuration sampleRate:(Float64 const)sampleRate
+{
+	[_lock lock];
+	ECVClockFilterReset(&_video, fieldDuration);
+	ECVClockFilterReset(&_audio, sampleRate > 0.0 ? 1.0 / sampleRate : 0.0);
+	_audioSampleTime = 0.0;
+	[_lock unlock];
+}
+
+#pragma mark -
+
+- (NSTimeInterval)presentationTimeForFieldAtTime:(NSTimeInterval const)arrivalTime
+{
+	[_lock lock];
+	NSTimeInterval time = arrivalTime;
+	if(_video.nominalPeriod > 0.0) {
+		Float64 const ticks = _video.valid ? MAX(1.0, round((arrivalTime - _video.time) / _video.period)) : 0.0; // Skip over fields that never arrived.
+		time = ECVClockFilterUpdate(&_video, ticks, arrivalTime);
+	}
+	[_lock unlock];
+	return time;
+}
+- (NSTimeInterval)presentationTimeForAudioSampleTime:(Float64 const)sampleTime atTime:(NSTimeInterval const)arrivalTime
+{
+	[_lock lock];
+	NSTimeInterval time = arrivalTime;
+	if(_audio.nominalPeriod > 0.0) {
+		time = ECVClockFilterUpdate(&_audio, sampleTime - _audioSampleTime, arrivalTime);
+		_audioSampleTime = sampleTime;
+	}
+	[_lock unlock];
+	return time;
+}
+
+#pragma mark -
+
+- (NSTimeInterval)fieldDuration
+{
+	[_lock lock];
+	NSTimeInterval const period = _video.period;
+	[_lock unlock];
+	return period;
+}
+- (Float64)sampleRate
+{
+	[_lock lock];
+	Float64 const rate = _audio.period > 0.0 ? 1.0 / _audio.period : 0.0;
+	[_lock unlock];
+	return rate;
+}
+- (double)videoRateError
+{
+	[_lock lock];
+	double const error = ECVClockFilterRateError(&_video);
+	[_lock unlock];
+	return error;
+}
+- (double)audioRateError
+{
+	[_lock lock];
+	double const error = ECVClockFilterRateError(&_audio);
+	[_lock unlock];
+	return error;
+}
+- (double)drift
+{
+	[_lock lock];
+	double const drift = _video.valid && _audio.valid ? ECVClockFilterRateError(&_video) - ECVClockFilterRateError(&_audio) : 0.0;
+	[_lock unlock];
+	return drift;
+}
+- (NSTimeInterval)videoJitter
+{
+	[_lock lock];
+	NSTimeInterval const jitter = _video.jitter;
+	[_lock unlock];
+	return jitter;
+}
+- (NSTimeInterval)audioJitter
+{
+	[_lock lock];
+	NSTimeInterval const jitter = _audio.jitter;
+	[_lock unlock];
+	return jitter;
+}
+- (NSString *)statisticsDescription
+{
+	[_lock lock];
+	NSString *const description = [NSString stringWithFormat:@"Video clock %+.1f ppm (%.2f ms jitter, %lu resyncs), audio clock %+.1f ppm (%.2f ms jitter, %lu resyncs)", ECVClockFilterRateError(&_video), _video.jitter * 1000.0, (unsigned long)_video.resyncCount, ECVClockFilterRateError(&_audio), _audio.jitter * 1000.0, (unsigned long)_audio.resyncCount];
+	[_lock unlock];
+	return description;
+}
+
+#pragma mark -NSObject
+
+- (id)init
+{
+	if((self = [super init])) {
+		_lock = [[NSLock alloc] init];
+	}
+	return self;
+}
+- (void)dealloc
+{
+	[_lock release];
+	[super dealloc];
+}
+
+@end
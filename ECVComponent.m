@@ -154,16 +154,19 @@ static ICMCompressionSessionRef ECVCompressionSessionCreate(ECVCStorage *const s
 ECV_CALLCOMPONENT_FUNCTION(Open, ComponentInstance instance)
 {
 	ECV_DEBUG_LOG();
-	if(CountComponentInstances((Component)self) > 1) return -1;
 	if(!self) {
 		NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
 		self = calloc(1, sizeof(ECVCStorage));
 		for(Class const class in [ECVCaptureDevice deviceClasses]) {
-			io_service_t const service = IOServiceGetMatchingService(kIOMasterPortDefault, (CFDictionaryRef)[[class matchingDictionary] retain]);
-			if(!service) continue;
-			self->device = [[class alloc] initWithService:service];
-			if(!self->device) continue;
-			break;
+			io_iterator_t iterator = IO_OBJECT_NULL;
+			if(kIOReturnSuccess != ECVIOReturn(IOServiceGetMatchingServices(kIOMasterPortDefault, (CFDictionaryRef)[[class matchingDictionary] retain], &iterator))) continue;
+			io_service_t service = IO_OBJECT_NULL;
+			while(!self->device && (service = IOIteratorNext(iterator))) {
+				self->device = [[class alloc] initWithService:service]; // Fails for devices another instance already has open, so each instance gets its own.
+				IOObjectRelease(service);
+			}
+			IOObjectRelease(iterator);
+			if(self->device) break;
 		}
 		if(!self->device) {
 			ECVLog(ECVError, @"Unable to start any devices");
@@ -0,0 +1,49 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sends control changes from a background thread, keeping only the latest value for each control. Dragging a slider turns into a handful of transfers instead of one per mouse event.
+@class ECVControlQueue;
+
+@protocol ECVControlQueueDelegate <NSObject>
+
+- (BOOL)controlQueue:(ECVControlQueue *const)queue writeValue:(NSInteger const)value forControl:(NSUInteger const)control; // Called on the queue's thread. Skipping values the device already has is up to the delegate.
+
+@end
+
+@interface ECVControlQueue : NSObject
+{
+	@private
+	NSObject<ECVControlQueueDelegate> *_delegate;
+	NSConditionLock *_lock;
+	NSMutableArray *_pendingControls;
+	NSMutableDictionary *_pendingValues;
+	BOOL _stop;
+
+	NSUInteger _changeCount; // Since creation, logged once the queue stops.
+	NSUInteger _writeCount;
+}
+
+- (id)initWithDelegate:(NSObject<ECVControlQueueDelegate> *const)delegate;
+
+- (void)setValue:(NSInteger const)value forControl:(NSUInteger const)control;
+- (void)invalidate; // Must be called before the delegate goes away. Waits for any write in progress.
+
+@end
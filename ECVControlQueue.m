@@ -0,0 +1,121 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVControlQueue.h"
+
+// Other Sources
+#import "ECVDebug.h"
+
+enum {
+	ECVControlQueueWait,
+	ECVControlQueueRun,
+	ECVControlQueueFinished,
+};
+
+@interface ECVControlQueue(Private)
+
+- (void)_thread_write;
+
+@end
+
+@implementation ECVControlQueue
+
+#pragma mark -ECVControlQueue
+
+- (id)initWithDelegate:(NSObject<ECVControlQueueDelegate> *const)delegate
+{
+	if(!(self = [super init])) return nil;
+	_delegate = delegate;
+	_lock = [[NSConditionLock alloc] initWithCondition:ECVControlQueueWait];
+	_pendingControls = [[NSMutableArray alloc] init];
+	_pendingValues = [[NSMutableDictionary alloc] init];
+	[NSThread detachNewThreadSelector:@selector(_thread_write) toTarget:self withObject:nil];
+	return self;
+}
+
+#pragma mark -
+
+- (void)setValue:(NSInteger const)value forControl:(NSUInteger const)control
+{
+	NSNumber *const key = [NSNumber numberWithUnsignedInteger:control];
+	NSNumber *const val = [NSNumber numberWithInteger:value];
+	[_lock lock];
+	if(_stop) return [_lock unlock];
+	_changeCount++;
+	if(![_pendingValues objectForKey:key]) [_pendingControls addObject:key]; // Oldest first, so controls are written in the order they first changed.
+	[_pendingValues setObject:val forKey:key];
+	[_lock unlockWithCondition:ECVControlQueueRun];
+}
+- (void)invalidate
+{
+	[_lock lock];
+	if(_stop) return [_lock unlock];
+	_stop = YES;
+	[_lock unlockWithCondition:ECVControlQueueRun];
+	[_lock lockWhenCondition:ECVControlQueueFinished];
+	_delegate = nil;
+	[_lock unlock];
+}
+
+#pragma mark -ECVControlQueue(Private)
+
+- (void)_thread_write
+{
+	NSAutoreleasePool *const outerPool = [[NSAutoreleasePool alloc] init];
+	for(;;) {
+		NSAutoreleasePool *const innerPool = [[NSAutoreleasePool alloc] init];
+
+		[_lock lockWhenCondition:ECVControlQueueRun];
+		if(_stop) {
+			if(_changeCount) ECVLog(ECVNotice, @"Coalesced %lu control changes into %lu writes.", (unsigned long)_changeCount, (unsigned long)_writeCount);
+			[_lock unlockWithCondition:ECVControlQueueFinished];
+			[innerPool drain];
+			break;
+		}
+		NSNumber *const key = [[[_pendingControls objectAtIndex:0] retain] autorelease];
+		NSNumber *const val = [[[_pendingValues objectForKey:key] retain] autorelease];
+		[_pendingControls removeObjectAtIndex:0];
+		[_pendingValues removeObjectForKey:key];
+		[_lock unlock];
+
+		(void)[_delegate controlQueue:self writeValue:[val integerValue] forControl:[key unsignedIntegerValue]];
+
+		[_lock lock];
+		_writeCount++;
+		BOOL const remaining = !![_pendingControls count];
+		[_lock unlockWithCondition:remaining || _stop ? ECVControlQueueRun : ECVControlQueueWait];
+
+		[innerPool drain];
+	}
+	[outerPool drain];
+}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	[_lock release];
+	[_pendingControls release];
+	[_pendingValues release];
+	[super dealloc];
+}
+
+@end
@@ -22,6 +22,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVVideoStorage.h"
 #import "ECVVideoFrame.h"
 
+extern NSString *const ECVVideoStorageMemoryBudgetKey; // Bytes of frame buffers shared by every open device.
+
 @interface ECVDependentVideoStorage : ECVVideoStorage
 {
 	@private
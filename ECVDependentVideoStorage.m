@@ -25,9 +25,34 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVVideoFormat.h"
 
 // Other Sources
+#import "ECVDebug.h"
 #import "ECVReadWriteLock.h"
 
 #define ECVDependentBufferCount 16
+#define ECVDependentMinimumBufferCount 4 // Enough to deinterlace and display, even over budget.
+
+NSString *const ECVVideoStorageMemoryBudgetKey = @"ECVVideoStorageMemoryBudget";
+
+static NSLock *ECVBufferBudgetLock = nil;
+static unsigned long long ECVBufferBytesReserved = 0;
+
+static NSUInteger ECVReserveBuffers(size_t const bufferSize)
+{
+	unsigned long long const budget = [[[NSUserDefaults standardUserDefaults] objectForKey:ECVVideoStorageMemoryBudgetKey] unsignedLongLongValue];
+	[ECVBufferBudgetLock lock];
+	unsigned long long const available = budget > ECVBufferBytesReserved ? budget - ECVBufferBytesReserved : 0;
+	NSUInteger const count = MAX(MIN(available / bufferSize, ECVDependentBufferCount), ECVDependentMinimumBufferCount);
+	ECVBufferBytesReserved += count * bufferSize;
+	[ECVBufferBudgetLock unlock];
+	if(count < ECVDependentBufferCount) ECVLog(ECVNotice, @"Video memory budget limits storage to %lu buffers (%llu MB in use).", (unsigned long)count, ECVBufferBytesReserved / (1024 * 1024));
+	return count;
+}
+static void ECVReleaseBuffers(NSUInteger const count, size_t const bufferSize)
+{
+	[ECVBufferBudgetLock lock];
+	ECVBufferBytesReserved -= count * bufferSize;
+	[ECVBufferBudgetLock unlock];
+}
 
 @interface ECVDependentPixelBuffer : ECVMutablePixelBuffer
 {
@@ -61,6 +86,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 
 @implementation ECVDependentVideoStorage
 
+#pragma mark +NSObject
+
++ (void)initialize
+{
+	if([ECVDependentVideoStorage class] != self) return;
+	ECVBufferBudgetLock = [[NSLock alloc] init];
+	[[NSUserDefaults standardUserDefaults] registerDefaults:[NSDictionary dictionaryWithObjectsAndKeys:
+		[NSNumber numberWithUnsignedLongLong:256ULL * 1024 * 1024], ECVVideoStorageMemoryBudgetKey,
+		nil]];
+}
+
 #pragma mark -ECVDependentVideoStorage
 
 - (NSUInteger)numberOfBuffers
@@ -98,8 +134,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 - (id)initWithVideoFormat:(ECVVideoFormat *const)videoFormat deinterlacingMode:(Class const)mode pixelFormat:(OSType const)pixelFormat
 {
 	if((self = [super initWithVideoFormat:videoFormat deinterlacingMode:mode pixelFormat:pixelFormat])) {
-		_frames = [[NSMutableArray alloc] initWithCapacity:ECVDependentBufferCount];
-		_numberOfBuffers = ECVDependentBufferCount;
+		_numberOfBuffers = ECVReserveBuffers([self bufferSize]);
+		_frames = [[NSMutableArray alloc] initWithCapacity:_numberOfBuffers];
 		_allBufferData = [[NSMutableData alloc] initWithLength:_numberOfBuffers * [self bufferSize]];
 		_unusedBufferIndexes = [[NSMutableIndexSet alloc] initWithIndexesInRange:NSMakeRange(0, _numberOfBuffers)];
 	}
@@ -152,6 +188,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 
 - (void)dealloc
 {
+	ECVReleaseBuffers(_numberOfBuffers, [self bufferSize]);
 	[_frames release];
 	[_allBufferData release];
 	[_unusedBufferIndexes release];
@@ -0,0 +1,67 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#define ECVDiskWriterChunkSize (1024 * 1024) // Writes are coalesced into chunks aligned to this within the file.
+#define ECVDiskWriterPreallocationSize (64 * 1024 * 1024)
+#define ECVDiskWriterCoalescingDelay 0.1 // Partial chunks are written after this long.
+
+// Decouples producers from the disk: bytes are copied into a large ring and written sequentially by a dedicated thread, so slow disks only stall the producer when the ring is full.
+// The copy is deliberate. Writing straight from the producer's buffers would hold them (for example, video storage slots) for as long as the disk stalls, and small appends couldn't be coalesced into aligned chunks. One memcpy per frame is cheap next to either.
+@interface ECVDiskWriter : NSObject
+{
+	@private
+	int _fileDescriptor;
+	UInt8 *_ring;
+	size_t _capacity;
+	NSTimeInterval _syncInterval;
+	NSCondition *_condition;
+	off_t _head; // Everything before this has been appended.
+	off_t _tail; // Everything before this is on disk.
+	off_t _writingEnd; // Bytes between the tail and this are being written without the lock.
+	off_t _allocatedLength; // Physical end of file after our preallocations.
+	off_t _nextPreallocationOffset; // Don't retry failed preallocations on every write.
+	BOOL _closing;
+	BOOL _finished;
+	BOOL _failed;
+
+	size_t _highWaterMark;
+	NSTimeInterval _stallTime;
+	NSTimeInterval _writeTime;
+	NSTimeInterval _syncTime;
+}
+
+- (id)initWithFileDescriptor:(int const)fd capacity:(size_t const)capacity syncInterval:(NSTimeInterval const)interval; // Doesn't take ownership of the descriptor. An interval of 0 only syncs when closing.
+- (size_t)capacity;
+- (NSTimeInterval)syncInterval;
+
+- (void)appendBytes:(void const *const)bytes length:(size_t const)length; // Blocks only while the ring is full.
+- (void)writeBytes:(void const *const)bytes length:(size_t const)length atOffset:(off_t const)offset; // Overwrites earlier bytes, whether or not they've reached the disk yet.
+- (void)close; // Writes everything, syncs, and stops the thread.
+
+- (off_t)length;
+- (size_t)bufferedLength;
+- (size_t)highWaterMark;
+- (NSTimeInterval)stallTime; // Spent waiting for room in the ring.
+- (NSTimeInterval)writeTime;
+- (NSTimeInterval)syncTime;
+- (BOOL)failed;
+
+@end
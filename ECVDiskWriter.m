@@ -0,0 +1,288 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVDiskWriter.h"
+#import <fcntl.h>
+
+// Other Sources
+#import "ECVDebug.h"
+#import "ECVFoundationAdditions.h"
+
+static void ECVRingCopyIn(UInt8 *const ring, size_t const capacity, off_t const position, UInt8 const *const bytes, size_t const length)
+{
+	size_t const start = (size_t)(position % capacity);
+	size_t const first = MIN(length, capacity - start);
+	memcpy(ring + start, bytes, first);
+	memcpy(ring, bytes + first, length - first);
+}
+static BOOL ECVWriteFully(int const fd, UInt8 const *bytes, size_t length, off_t offset)
+{
+	while(length) {
+		ssize_t const written = pwrite(fd, bytes, length, offset);
+		if(-1 == written) {
+			if(EINTR == errno) continue;
+			return NO;
+		}
+		bytes += written;
+		length -= written;
+		offset += written;
+	}
+	return YES;
+}
+
+@interface ECVDiskWriter(Private)
+
+- (void)_thread_write:(id const)arg;
+- (void)_preallocateThrough:(off_t const)end;
+- (void)_sync;
+
+@end
+
+@implementation ECVDiskWriter
+
+#pragma mark -ECVDiskWriter
+
+- (id)initWithFileDescriptor:(int const)fd capacity:(size_t const)capacity syncInterval:(NSTimeInterval const)interval
+{
+	if(!(self = [super init])) return nil;
+	_fileDescriptor = fd;
+	_capacity = MAX((capacity + ECVDiskWriterChunkSize - 1) / ECVDiskWriterChunkSize, 2) * ECVDiskWriterChunkSize; // Chunks never straddle the end of the ring.
+	_ring = valloc(_capacity);
+	if(!_ring) {
+		[self release];
+		return nil;
+	}
+	_syncInterval = interval;
+	_condition = [[NSCondition alloc] init];
+#if defined(F_NOCACHE)
+	(void)fcntl(_fileDescriptor, F_NOCACHE, 1); // We'll never read it back, so don't let recordings push everything else out of the cache.
+#endif
+	[NSThread detachNewThreadSelector:@selector(_thread_write:) toTarget:self withObject:nil];
+	return self;
+}
+- (size_t)capacity
+{
+	return _capacity;
+}
+- (NSTimeInterval)syncInterval
+{
+	return _syncInterval;
+}
+
+#pragma mark -
+
+- (void)appendBytes:(void const *const)bytes length:(size_t const)length
+{
+	// Only one thread may append at a time.
+	UInt8 const *p = bytes;
+	size_t remaining = length;
+	while(remaining) {
+		[_condition lock];
+		NSTimeInterval stallStartTime = 0.0;
+		while(!_failed && (size_t)(_head - _tail) >= _capacity) {
+			if(!stallStartTime) stallStartTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+			[_condition wait];
+		}
+		if(stallStartTime) _stallTime += [NSDate ECV_timeIntervalSinceReferenceDate] - stallStartTime;
+		if(_failed) return [_condition unlock];
+		size_t const n = MIN(remaining, _capacity - (size_t)(_head - _tail));
+		off_t const position = _head;
+		[_condition unlock];
+
+		ECVRingCopyIn(_ring, _capacity, position, p, n); // Past the head, so the write thread won't look at it yet.
+
+		[_condition lock];
+		_head += n;
+		_highWaterMark = MAX(_highWaterMark, (size_t)(_head - _tail));
+		[_condition broadcast];
+		[_condition unlock];
+		p += n;
+		remaining -= n;
+	}
+}
+- (void)writeBytes:(void const *const)bytes length:(size_t const)length atOffset:(off_t const)offset
+{
+	[_condition lock];
+	NSParameterAssert(offset + (off_t)length <= _head);
+	while(!_failed && offset < _writingEnd && offset + (off_t)length > _tail) [_condition wait];
+	if(_failed) return [_condition unlock];
+	size_t const onDisk = offset < _tail ? MIN(length, (size_t)(_tail - offset)) : 0;
+	if(length > onDisk) ECVRingCopyIn(_ring, _capacity, offset + onDisk, (UInt8 const *)bytes + onDisk, length - onDisk);
+	[_condition unlock];
+	if(onDisk && !ECVWriteFully(_fileDescriptor, bytes, onDisk, offset)) {
+		ECVLog(ECVError, @"Disk write failed (%s).", strerror(errno));
+		[_condition lock];
+		_failed = YES;
+		[_condition broadcast];
+		[_condition unlock];
+	}
+}
+- (void)close
+{
+	[_condition lock];
+	_closing = YES;
+	[_condition broadcast];
+	while(!_finished) [_condition wait];
+	[_condition unlock];
+}
+
+#pragma mark -
+
+- (off_t)length
+{
+	[_condition lock];
+	off_t const length = _head;
+	[_condition unlock];
+	return length;
+}
+- (size_t)bufferedLength
+{
+	[_condition lock];
+	size_t const length = (size_t)(_head - _tail);
+	[_condition unlock];
+	return length;
+}
+- (size_t)highWaterMark
+{
+	[_condition lock];
+	size_t const length = _highWaterMark;
+	[_condition unlock];
+	return length;
+}
+- (NSTimeInterval)stallTime
+{
+	[_condition lock];
+	NSTimeInterval const time = _stallTime;
+	[_condition unlock];
+	return time;
+}
+- (NSTimeInterval)writeTime
+{
+	[_condition lock];
+	NSTimeInterval const time = _writeTime;
+	[_condition unlock];
+	return time;
+}
+- (NSTimeInterval)syncTime
+{
+	[_condition lock];
+	NSTimeInterval const time = _syncTime;
+	[_condition unlock];
+	return time;
+}
+- (BOOL)failed
+{
+	[_condition lock];
+	BOOL const failed = _failed;
+	[_condition unlock];
+	return failed;
+}
+
+#pragma mark -ECVDiskWriter(Private)
+
+- (void)_thread_write:(id const)arg
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	NSTimeInterval lastSyncTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+	[_condition lock];
+	for(;;) {
+		while(!_closing && !_failed && _head == _tail) [_condition wait]; // Idle until something is appended.
+		// Wait for the rest of the current chunk, but don't hold partial chunks for long.
+		NSDate *const deadline = [NSDate dateWithTimeIntervalSinceNow:ECVDiskWriterCoalescingDelay];
+		size_t const chunkRemaining = ECVDiskWriterChunkSize - (size_t)(_tail % ECVDiskWriterChunkSize);
+		while(!_closing && !_failed && (size_t)(_head - _tail) < chunkRemaining) {
+			if(![_condition waitUntilDate:deadline]) break;
+		}
+		size_t const pending = (size_t)(_head - _tail);
+		if(_failed || (_closing && !pending)) break;
+		if(!pending) continue;
+
+		off_t const position = _tail;
+		size_t const n = MIN(pending, chunkRemaining);
+		_writingEnd = position + n;
+		[_condition unlock];
+
+		[self _preallocateThrough:position + n];
+		NSTimeInterval const startTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+		BOOL const success = ECVWriteFully(_fileDescriptor, _ring + position % _capacity, n, position);
+		NSTimeInterval const endTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+		if(!success) ECVLog(ECVError, @"Disk write failed (%s).", strerror(errno));
+		if(success && _syncInterval > 0.0 && endTime - lastSyncTime >= _syncInterval) {
+			[self _sync];
+			lastSyncTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+		}
+
+		[_condition lock];
+		_writeTime += endTime - startTime;
+		if(success) _tail = position + n;
+		else _failed = YES;
+		_writingEnd = _tail;
+		[_condition broadcast];
+	}
+	[_condition unlock];
+
+	[self _sync];
+
+	[_condition lock];
+	_finished = YES;
+	[_condition broadcast];
+	[_condition unlock];
+	[pool release];
+}
+- (void)_preallocateThrough:(off_t const)end
+{
+#if defined(F_PREALLOCATE)
+	if(end <= _allocatedLength || end <= _nextPreallocationOffset) return;
+	off_t const physicalEnd = MAX(_allocatedLength, _tail); // Only this thread moves the tail. Writes past our preallocations extend the file themselves.
+	fstore_t store = {F_ALLOCATECONTIG | F_ALLOCATEALL, F_PEOFPOSMODE, 0, MAX(end - physicalEnd, ECVDiskWriterPreallocationSize), 0}; // F_PEOFPOSMODE allocates from the physical end of file, not from the offset being written.
+	if(-1 == fcntl(_fileDescriptor, F_PREALLOCATE, &store)) {
+		store.fst_flags = F_ALLOCATEALL;
+		if(-1 == fcntl(_fileDescriptor, F_PREALLOCATE, &store)) {
+			_nextPreallocationOffset = end + ECVDiskWriterPreallocationSize;
+			return;
+		}
+	}
+	_allocatedLength = physicalEnd + store.fst_bytesalloc;
+#endif
+}
+- (void)_sync
+{
+	NSTimeInterval const startTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+#if defined(F_FULLFSYNC)
+	if(-1 == fcntl(_fileDescriptor, F_FULLFSYNC))
+#endif
+	(void)fsync(_fileDescriptor);
+	NSTimeInterval const time = [NSDate ECV_timeIntervalSinceReferenceDate] - startTime;
+	[_condition lock];
+	_syncTime += time;
+	[_condition unlock];
+}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	free(_ring);
+	[_condition release];
+	[super dealloc];
+}
+
+@end
@@ -0,0 +1,41 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#define ECVEBMLHeaderID 0x1A45DFA3
+#define ECVEBMLVersionID 0x4286
+#define ECVEBMLReadVersionID 0x42F7
+#define ECVEBMLMaxIDLengthID 0x42F2
+#define ECVEBMLMaxSizeLengthID 0x42F3
+#define ECVEBMLDocTypeID 0x4282
+#define ECVEBMLDocTypeVersionID 0x4287
+#define ECVEBMLDocTypeReadVersionID 0x4285
+#define ECVEBMLUnknownSize 0x00FFFFFFFFFFFFFFULL
+
+// The subset of EBML that ECVMatroskaWriter needs. Every function appends a complete element or size to the data.
+extern void ECVEBMLAppendID(NSMutableData *const data, UInt32 const ID);
+extern void ECVEBMLEncodeSize8(UInt64 const size, UInt8 *const bytes); // Always 8 bytes, so sizes written as unknown can be patched in place.
+extern void ECVEBMLAppendSize(NSMutableData *const data, UInt64 const size); // The shortest encoding. All-ones values are reserved for unknown sizes, so they take the next length up.
+extern void ECVEBMLAppendBinary(NSMutableData *const data, UInt32 const ID, void const *const bytes, size_t const length);
+extern void ECVEBMLAppendMaster(NSMutableData *const data, UInt32 const ID, NSData *const children);
+extern void ECVEBMLAppendString(NSMutableData *const data, UInt32 const ID, char const *const string);
+extern void ECVEBMLAppendUnsigned(NSMutableData *const data, UInt32 const ID, UInt64 const value);
+extern void ECVEBMLAppendFloat(NSMutableData *const data, UInt32 const ID, Float64 const value);
+extern void ECVEBMLAppendUnknownSizeMaster(NSMutableData *const data, UInt32 const ID);
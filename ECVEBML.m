@@ -0,0 +1,82 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVEBML.h"
+
+void ECVEBMLAppendID(NSMutableData *const data, UInt32 const ID)
+{
+	NSUInteger const length = ID > 0xFFFFFF ? 4 : (ID > 0xFFFF ? 3 : (ID > 0xFF ? 2 : 1));
+	UInt8 bytes[4];
+	for(NSUInteger i = 0; i < length; i++) bytes[i] = (UInt8)(ID >> (8 * (length - i - 1)));
+	[data appendBytes:bytes length:length];
+}
+void ECVEBMLEncodeSize8(UInt64 const size, UInt8 *const bytes)
+{
+	for(NSUInteger i = 0; i < 8; i++) bytes[i] = (UInt8)(size >> (8 * (7 - i)));
+	bytes[0] = 0x01;
+}
+void ECVEBMLAppendSize(NSMutableData *const data, UInt64 const size)
+{
+	NSUInteger length = 1;
+	while(length < 8 && size >= (1ULL << (7 * length)) - 1) length++;
+	UInt8 bytes[8];
+	if(8 == length) {
+		ECVEBMLEncodeSize8(size, bytes);
+	} else {
+		for(NSUInteger i = 0; i < length; i++) bytes[i] = (UInt8)(size >> (8 * (length - i - 1)));
+		bytes[0] |= 0x80 >> (length - 1);
+	}
+	[data appendBytes:bytes length:length];
+}
+void ECVEBMLAppendBinary(NSMutableData *const data, UInt32 const ID, void const *const bytes, size_t const length)
+{
+	ECVEBMLAppendID(data, ID);
+	ECVEBMLAppendSize(data, length);
+	[data appendBytes:bytes length:length];
+}
+void ECVEBMLAppendMaster(NSMutableData *const data, UInt32 const ID, NSData *const children)
+{
+	ECVEBMLAppendBinary(data, ID, [children bytes], [children length]);
+}
+void ECVEBMLAppendString(NSMutableData *const data, UInt32 const ID, char const *const string)
+{
+	ECVEBMLAppendBinary(data, ID, string, strlen(string));
+}
+void ECVEBMLAppendUnsigned(NSMutableData *const data, UInt32 const ID, UInt64 const value)
+{
+	NSUInteger length = 1;
+	while(length < 8 && value >> (8 * length)) length++;
+	UInt8 bytes[8];
+	for(NSUInteger i = 0; i < length; i++) bytes[i] = (UInt8)(value >> (8 * (length - i - 1)));
+	ECVEBMLAppendBinary(data, ID, bytes, length);
+}
+void ECVEBMLAppendFloat(NSMutableData *const data, UInt32 const ID, Float64 const value)
+{
+	CFSwappedFloat64 const swapped = CFConvertDoubleHostToSwapped(value);
+	ECVEBMLAppendBinary(data, ID, &swapped, sizeof(swapped));
+}
+void ECVEBMLAppendUnknownSizeMaster(NSMutableData *const data, UInt32 const ID)
+{
+	UInt8 bytes[8];
+	ECVEBMLEncodeSize8(ECVEBMLUnknownSize, bytes);
+	ECVEBMLAppendID(data, ID);
+	[data appendBytes:bytes length:sizeof(bytes)];
+}
@@ -18,19 +18,20 @@ static void ECVPixelFormatHack(uint16_t *const bytes, size_t const len) {
 	for(size_t i = 0; i < len / sizeof(uint16_t); ++i) bytes[i] = CFSwapInt16(bytes[i]);
 }
 
-#define RECEIVE(request, idx, ...) \
-	do { \
-		u_int8_t const expected[] = {__VA_ARGS__}; \
-		u_int8_t data[] = {__VA_ARGS__}; \
-		size_t const length = sizeof(expected); \
-		if(![self readRequest:(request) value:0 index:(idx) length:length data:data]) return; \
-		if(memcmp(expected, data, length) != 0) ECVLog(ECVNotice, @"Read %04x: Expected %@, received %@", (idx), [NSData dataWithBytesNoCopy:(void *)expected length:length freeWhenDone:NO], [NSData dataWithBytesNoCopy:(void *)data length:length freeWhenDone:NO]); \
-	} while(0)
-#define SEND(request, idx, ...) \
-	do { \
-		u_int8_t data[] = {__VA_ARGS__}; \
-		if(![self writeRequest:(request) value:0 index:(idx) length:sizeof(data) data:data]) return; \
-	} while(0)
+#define ECVEM2860MaximumI2CLength 64 // Bytes per I2C transaction, including the subaddress.
+
+#define RECEIVE(request, idx, ...) ECVControlRequestMake(ECVControlRead, (request), 0, (idx), __VA_ARGS__)
+#define SEND(request, idx, ...) ECVControlRequestMake(ECVControlWrite, (request), 0, (idx), __VA_ARGS__)
+#define REG_WR(idx, val) ECVControlRegisterWriteMake((idx), (val))
+#define MODIFY(idx, enable, disable) ECVControlRegisterModifyMake((idx), (enable), (disable))
+#define STROBE(idx, val) ECVControlRegisterStrobeMake((idx), (val)) // Repeats in the tables below are deliberate, so these are never skipped.
+#define GPIO(idx, enable, disable) ECVControlRegisterStrobeModifyMake((idx), (enable), (disable))
+
+@interface ECVEM2860Device(Private)
+
+- (BOOL)_writeI2CData:(UInt8 const *const)data length:(UInt16 const)length;
+
+@end
 
 @implementation ECVEM2860Device
 
@@ -38,12 +39,18 @@ static void ECVPixelFormatHack(uint16_t *const bytes, size_t const len) {
 
 - (BOOL)modifyIndex:(UInt16 const)idx enable:(UInt8 const)enable disable:(UInt8 const)disable
 {
-	NSAssert(!(enable & disable), @"Can't enable and disable the same flag(s).");
-	UInt8 old = 0;
-	if(![self readRequest:kUSBRqGetStatus value:0 index:idx length:sizeof(old) data:&old]) return NO;
-	UInt8 new = (old | enable) & ~disable;
-	if(![self writeRequest:kUSBRqGetStatus value:0 index:idx length:sizeof(new) data:&new]) return NO;
-	return YES;
+	return [self modifyRegister:idx enable:enable disable:disable];
+}
+
+#pragma mark -ECVEM2860Device(Private)
+
+- (BOOL)_writeI2CData:(UInt8 const *const)data length:(UInt16 const)length
+{
+	UInt8 error = 0;
+	[self lockControlRequests]; // The status must belong to our write, not to one from the read thread.
+	BOOL const success = [self writeRequest:kUSBRqGetState value:0 index:0x004a length:length data:(void *)data] && [self readRequest:kUSBRqGetStatus value:0 index:0x0005 length:sizeof(error) data:&error];
+	[self unlockControlRequests];
+	return success && !error;
 }
 
 #pragma mark -ECVCaptureDevice
@@ -85,6 +92,19 @@ static void ECVPixelFormatHack(uint16_t *const bytes, size_t const len) {
 	return k2vuyPixelFormat; // Native format is kYVYU422PixelFormat, but we convert because QuickTime can't handle it (surprisingly).
 }
 
+#pragma mark -ECVCaptureDevice(ECVRegisterAbstract)
+
+- (ECVControlRequest)requestForReadingRegister:(UInt16 const)idx
+{
+	ECVControlRequest const request = {ECVControlRead, kUSBRqGetStatus, 0, idx, 1};
+	return request;
+}
+- (ECVControlRequest)requestForWritingRegister:(UInt16 const)idx value:(UInt8 const)value
+{
+	ECVControlRequest const request = {ECVControlWrite, kUSBRqGetStatus, 0, idx, 1, {value}};
+	return request;
+}
+
 #pragma mark -
 
 - (void)read
@@ -97,54 +117,57 @@ static void ECVPixelFormatHack(uint16_t *const bytes, size_t const len) {
 	//GET_DESCRIPTOR_FROM_DEVICE
 	//GET_DESCRIPTOR_FROM_DEVICE
 	//SELECT_CONFIGURATION
-	RECEIVE(kUSBRqGetStatus, 0x000a, 0x22);
-	RECEIVE(kUSBRqGetStatus, 0x000a, 0x22);
-	RECEIVE(kUSBRqGetStatus, 0x0006, 0x40);
-	RECEIVE(kUSBRqGetStatus, 0x0009, 0x9a);
-	RECEIVE(kUSBRqGetStatus, 0x000c, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
-	[self modifyIndex:0x0008 enable:1 << 2 disable:0];
-	RECEIVE(kUSBRqGetStatus, 0x0000, 0x10);
-	//RECEIVE(kUSBRqGetStatus, 0x0006, 0x40);
-	//SEND(kUSBRqGetStatus, 0x0006, 0x40);
-	[self modifyIndex:0x0006 enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
-	[self modifyIndex:0x0008 enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
-	[self modifyIndex:0x0008 enable:0 disable:0];
-	RECEIVE(kUSBRqGetState, 0x0042, 0xfe);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x10);
-	RECEIVE(kUSBRqGetState, 0x004a, 0xb1);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
-	[self modifyIndex:0x0008 enable:0 disable:0];
-	RECEIVE(kUSBRqGetState, 0x00c6, 0xfe);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x10);
-	RECEIVE(kUSBRqGetState, 0x00c4, 0x10);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x10);
-	RECEIVE(kUSBRqGetState, 0x00c2, 0x10);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x10);
-	RECEIVE(kUSBRqGetState, 0x00c0, 0x10);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x10);
-	RECEIVE(kUSBRqGetState, 0x00b6, 0x10);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x10);
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
-	[self modifyIndex:0x0008 enable:0 disable:1 << 2];
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xf2);
-	[self modifyIndex:0x0008 enable:0 disable:1 << 3];
-	RECEIVE(kUSBRqGetState, 0x0022, 0xf2);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x10);
-	RECEIVE(kUSBRqGetState, 0x00ba, 0x10);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x10);
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xf2);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
-	[self modifyIndex:0x0008 enable:1 << 3 disable:0];
+	static ECVControlRequest const configurationRequests[] = {
+		RECEIVE(kUSBRqGetStatus, 0x000a, 0x22),
+		RECEIVE(kUSBRqGetStatus, 0x000a, 0x22),
+		RECEIVE(kUSBRqGetStatus, 0x0006, 0x40),
+		RECEIVE(kUSBRqGetStatus, 0x0009, 0x9a),
+		RECEIVE(kUSBRqGetStatus, 0x000c, 0x00),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
+		GPIO(0x0008, 1 << 2, 0),
+		RECEIVE(kUSBRqGetStatus, 0x0000, 0x10),
+		//RECEIVE(kUSBRqGetStatus, 0x0006, 0x40);
+		//SEND(kUSBRqGetStatus, 0x0006, 0x40);
+		MODIFY(0x0006, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
+		GPIO(0x0008, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
+		GPIO(0x0008, 0, 0),
+		RECEIVE(kUSBRqGetState, 0x0042, 0xfe),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x10),
+		RECEIVE(kUSBRqGetState, 0x004a, 0xb1),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x00),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
+		GPIO(0x0008, 0, 0),
+		RECEIVE(kUSBRqGetState, 0x00c6, 0xfe),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x10),
+		RECEIVE(kUSBRqGetState, 0x00c4, 0x10),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x10),
+		RECEIVE(kUSBRqGetState, 0x00c2, 0x10),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x10),
+		RECEIVE(kUSBRqGetState, 0x00c0, 0x10),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x10),
+		RECEIVE(kUSBRqGetState, 0x00b6, 0x10),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x10),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
+		GPIO(0x0008, 0, 1 << 2),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xf2);
+		GPIO(0x0008, 0, 1 << 3),
+		RECEIVE(kUSBRqGetState, 0x0022, 0xf2),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x10),
+		RECEIVE(kUSBRqGetState, 0x00ba, 0x10),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x10),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xf2);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
+		GPIO(0x0008, 1 << 3, 0),
+	};
+	if(![self performControlRequests:configurationRequests count:numberof(configurationRequests)]) return;
 	//SELECT_INTERFACE
 	//SELECT_INTERFACE
 	//SELECT_INTERFACE
@@ -161,160 +184,172 @@ static void ECVPixelFormatHack(uint16_t *const bytes, size_t const len) {
 	[self setAlternateInterface:2];
 	[self setAlternateInterface:1];
 	[self setAlternateInterface:0];
-	RECEIVE(kUSBRqGetStatus, 0x0012, 0x27);
-	SEND(kUSBRqGetStatus, 0x0012, 0x27);
-	SEND(kUSBRqGetStatus, 0x000d, 0x42);
-	RECEIVE(kUSBRqGetStatus, 0x000f, 0x07);
-	SEND(kUSBRqGetStatus, 0x000f, 0x07);
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
-	[self modifyIndex:0x0008 enable:0 disable:0];
-	SEND(kUSBRqGetStatus, 0x0020, 0x00);
-	SEND(kUSBRqGetStatus, 0x0022, 0x00);
-	RECEIVE(kUSBRqGetStatus, 0x0012, 0x27);
-	SEND(kUSBRqGetStatus, 0x0012, 0x27);
-	RECEIVE(kUSBRqGetStatus, 0x000c, 0x00);
-	SEND(kUSBRqGetStatus, 0x000c, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
-	[self modifyIndex:0x0008 enable:1 << 2 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
-	[self modifyIndex:0x0008 enable:0 disable:1 << 2];
-	SEND(kUSBRqGetStatus, 0x0006, 0x40);
-	SEND(kUSBRqGetStatus, 0x0015, 0x20);
-	SEND(kUSBRqGetStatus, 0x0016, 0x20);
-	SEND(kUSBRqGetStatus, 0x0017, 0x20);
-	SEND(kUSBRqGetStatus, 0x0018, 0x00);
-	SEND(kUSBRqGetStatus, 0x0019, 0x00);
-	SEND(kUSBRqGetStatus, 0x001a, 0x00);
-	SEND(kUSBRqGetStatus, 0x0023, 0x00);
-	SEND(kUSBRqGetStatus, 0x0024, 0x00);
-	SEND(kUSBRqGetStatus, 0x0026, 0x00);
-	SEND(kUSBRqGetStatus, 0x0013, 0x08);
-	//RECEIVE(kUSBRqGetStatus, 0x0012, 0x27);
-	//SEND(kUSBRqGetStatus, 0x0012, 0x27);
-	[self modifyIndex:0x0012 enable:0 disable:0];
-	SEND(kUSBRqGetStatus, 0x000c, 0x10);
-	SEND(kUSBRqGetStatus, 0x0027, 0x00);
-	SEND(kUSBRqGetStatus, 0x0010, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0011, 0x11);
-	//SEND(kUSBRqGetStatus, 0x0011, 0x11);
-	[self modifyIndex:0x0011 enable:1 << 4 disable:0];
+	static ECVControlRequest const interfaceRequests[] = {
+		RECEIVE(kUSBRqGetStatus, 0x0012, 0x27),
+		REG_WR(0x0012, 0x27),
+		REG_WR(0x000d, 0x42),
+		RECEIVE(kUSBRqGetStatus, 0x000f, 0x07),
+		REG_WR(0x000f, 0x07),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
+		GPIO(0x0008, 0, 0),
+		STROBE(0x0020, 0x00),
+		STROBE(0x0022, 0x00),
+		RECEIVE(kUSBRqGetStatus, 0x0012, 0x27),
+		REG_WR(0x0012, 0x27),
+		RECEIVE(kUSBRqGetStatus, 0x000c, 0x00),
+		REG_WR(0x000c, 0x00),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
+		GPIO(0x0008, 1 << 2, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
+		GPIO(0x0008, 0, 1 << 2),
+		REG_WR(0x0006, 0x40),
+		REG_WR(0x0015, 0x20),
+		REG_WR(0x0016, 0x20),
+		REG_WR(0x0017, 0x20),
+		REG_WR(0x0018, 0x00),
+		REG_WR(0x0019, 0x00),
+		REG_WR(0x001a, 0x00),
+		REG_WR(0x0023, 0x00),
+		REG_WR(0x0024, 0x00),
+		REG_WR(0x0026, 0x00),
+		REG_WR(0x0013, 0x08),
+		//RECEIVE(kUSBRqGetStatus, 0x0012, 0x27);
+		//SEND(kUSBRqGetStatus, 0x0012, 0x27);
+		MODIFY(0x0012, 0, 0),
+		REG_WR(0x000c, 0x10),
+		REG_WR(0x0027, 0x00),
+		REG_WR(0x0010, 0x00),
+		//RECEIVE(kUSBRqGetStatus, 0x0011, 0x11);
+		//SEND(kUSBRqGetStatus, 0x0011, 0x11);
+		MODIFY(0x0011, 1 << 4, 0),
+	};
+	if(![self performControlRequests:interfaceRequests count:numberof(interfaceRequests)]) return;
 	if(resolution640) {
-		SEND(kUSBRqGetStatus, 0x0028, 0x01);
-		SEND(kUSBRqGetStatus, 0x0029, 0xaf);
-		SEND(kUSBRqGetStatus, 0x002a, 0x01);
-		SEND(kUSBRqGetStatus, 0x002b, 0x3b);
-		SEND(kUSBRqGetStatus, 0x001c, 0x08);
-		SEND(kUSBRqGetStatus, 0x001d, 0x03);
-		SEND(kUSBRqGetStatus, 0x001e, 0xb0);
-		SEND(kUSBRqGetStatus, 0x001f, 0x3c);
+		static ECVControlRequest const setup640Requests[] = {
+			REG_WR(0x0028, 0x01),
+			REG_WR(0x0029, 0xaf),
+			REG_WR(0x002a, 0x01),
+			REG_WR(0x002b, 0x3b),
+			REG_WR(0x001c, 0x08),
+			REG_WR(0x001d, 0x03),
+			REG_WR(0x001e, 0xb0),
+			REG_WR(0x001f, 0x3c),
+		};
+		if(![self performControlRequests:setup640Requests count:numberof(setup640Requests)]) return;
 	} else {
-		SEND(kUSBRqGetStatus, 0x0028, 0x01);
-		SEND(kUSBRqGetStatus, 0x0029, 0xb3);
-		SEND(kUSBRqGetStatus, 0x002a, 0x01);
-		SEND(kUSBRqGetStatus, 0x002b, 0x3b);
-		SEND(kUSBRqGetStatus, 0x001c, 0x00);
-		SEND(kUSBRqGetStatus, 0x001d, 0x03);
-		SEND(kUSBRqGetStatus, 0x001e, 0xb4);
-		SEND(kUSBRqGetStatus, 0x001f, 0x3c);
+		static ECVControlRequest const setup720Requests[] = {
+			REG_WR(0x0028, 0x01),
+			REG_WR(0x0029, 0xb3),
+			REG_WR(0x002a, 0x01),
+			REG_WR(0x002b, 0x3b),
+			REG_WR(0x001c, 0x00),
+			REG_WR(0x001d, 0x03),
+			REG_WR(0x001e, 0xb4),
+			REG_WR(0x001f, 0x3c),
+		};
+		if(![self performControlRequests:setup720Requests count:numberof(setup720Requests)]) return;
 	}
 	//RECEIVE(kUSBRqGetStatus, 0x001b, 0x00);
 	//SEND(kUSBRqGetStatus, 0x001b, 0x00);
-	[self modifyIndex:0x001b enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x001b, 0x00);
-	//SEND(kUSBRqGetStatus, 0x001b, 0x00);
-	[self modifyIndex:0x001b enable:0 disable:0];
-	//SEND(kUSBRqGetState, 0x004a, 0x01, 0x08);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x03, 0x30);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x06, 0xeb, 0x0d, 0x88, 0x01);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x0a, 0x80, 0x47, 0x40, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x0f, 0x2a);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x10, 0x08, 0x0c, 0xe7, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x0a, 0x80);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x0e, 0x01);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x08, 0x88);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x02, 0xc0);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	SEND(kUSBRqGetStatus, 0x0021, 0x08);
-	SEND(kUSBRqGetStatus, 0x0020, 0x10);
-	//SEND(kUSBRqGetState, 0x004a, 0x0d, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	SEND(kUSBRqGetStatus, 0x0022, 0x10);
-	SEND(kUSBRqGetStatus, 0x0014, 0x32);
-	SEND(kUSBRqGetStatus, 0x0025, 0x02);
-	RECEIVE(kUSBRqGetStatus, 0x0026, 0x00);
-	SEND(kUSBRqGetStatus, 0x0026, 0x00);
-	SEND(kUSBRqSetFeature, 0x004a, 0x1f);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	RECEIVE(kUSBRqGetState, 0x004a, 0xb1);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0027, 0x00);
-	//SEND(kUSBRqGetStatus, 0x0027, 0x00);
-	[self modifyIndex:0x0027 enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x0011, 0x11);
-	//SEND(kUSBRqGetStatus, 0x0011, 0x10);
-	[self modifyIndex:0x0011 enable:0 disable:1 << 0];
-	//RECEIVE(kUSBRqGetStatus, 0x001b, 0x00);
-	//SEND(kUSBRqGetStatus, 0x001b, 0x80);
-	[self modifyIndex:0x001b enable:1 << 7 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x000c, 0x10);
-	//SEND(kUSBRqGetStatus, 0x000c, 0x10);
-	[self modifyIndex:0x000c enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x0012, 0x27);
-	//SEND(kUSBRqGetStatus, 0x0012, 0x67);
-	[self modifyIndex:0x0012 enable:1 << 6 disable:0];
-	SEND(kUSBRqGetStatus, 0x0022, 0x10);
-	SEND(kUSBRqGetStatus, 0x0020, 0x10);
-	//RECEIVE(kUSBRqGetStatus, 0x000f, 0x07);
-	//SEND(kUSBRqGetStatus, 0x000f, 0x07);
-	[self modifyIndex:0x000f enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
-	[self modifyIndex:0x0008 enable:0 disable:0];
-	SEND(kUSBRqSetFeature, 0x004a, 0x1f);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	RECEIVE(kUSBRqGetState, 0x004a, 0xb1);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	SEND(kUSBRqGetStatus, 0x0021, 0x08);
-	SEND(kUSBRqGetStatus, 0x0020, 0x10);
-	//SEND(kUSBRqGetState, 0x004a, 0x0d, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	SEND(kUSBRqGetStatus, 0x0022, 0x10);
-	SEND(kUSBRqGetStatus, 0x0014, 0x32);
-	SEND(kUSBRqGetStatus, 0x0025, 0x02);
-	//RECEIVE(kUSBRqGetStatus, 0x000e, 0x90);
-	//SEND(kUSBRqGetStatus, 0x000e, 0x90);
-	[self modifyIndex:0x000e enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x000f, 0x07);
-	//SEND(kUSBRqGetStatus, 0x000f, 0x87);
-	[self modifyIndex:0x000f enable:0 disable:1 << 7];
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xf8);
-	[self modifyIndex:0x0008 enable:0 disable:1 << 1];
-	//SEND(kUSBRqGetState, 0x004a, 0x0a, 0x80);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x0e, 0x01);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//SEND(kUSBRqGetState, 0x004a, 0x08, 0x88);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	SEND(kUSBRqGetStatus, 0x0021, 0x08);
-	SEND(kUSBRqGetStatus, 0x0020, 0x10);
-	//SEND(kUSBRqGetState, 0x004a, 0x0d, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	SEND(kUSBRqGetStatus, 0x0022, 0x10);
-	SEND(kUSBRqGetStatus, 0x0014, 0x32);
-	SEND(kUSBRqGetStatus, 0x0025, 0x02);
+	static ECVControlRequest const decoderRequests[] = {
+		MODIFY(0x001b, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x001b, 0x00);
+		//SEND(kUSBRqGetStatus, 0x001b, 0x00);
+		MODIFY(0x001b, 0, 0),
+		//SEND(kUSBRqGetState, 0x004a, 0x01, 0x08);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x03, 0x30);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x06, 0xeb, 0x0d, 0x88, 0x01);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x0a, 0x80, 0x47, 0x40, 0x00);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x0f, 0x2a);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x10, 0x08, 0x0c, 0xe7, 0x00);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x0a, 0x80);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x0e, 0x01);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x08, 0x88);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x02, 0xc0);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		REG_WR(0x0021, 0x08),
+		STROBE(0x0020, 0x10),
+		//SEND(kUSBRqGetState, 0x004a, 0x0d, 0x00);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		STROBE(0x0022, 0x10),
+		REG_WR(0x0014, 0x32),
+		REG_WR(0x0025, 0x02),
+		RECEIVE(kUSBRqGetStatus, 0x0026, 0x00),
+		REG_WR(0x0026, 0x00),
+		SEND(kUSBRqSetFeature, 0x004a, 0x1f),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x00),
+		RECEIVE(kUSBRqGetState, 0x004a, 0xb1),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x00),
+		//RECEIVE(kUSBRqGetStatus, 0x0027, 0x00);
+		//SEND(kUSBRqGetStatus, 0x0027, 0x00);
+		MODIFY(0x0027, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x0011, 0x11);
+		//SEND(kUSBRqGetStatus, 0x0011, 0x10);
+		MODIFY(0x0011, 0, 1 << 0),
+		//RECEIVE(kUSBRqGetStatus, 0x001b, 0x00);
+		//SEND(kUSBRqGetStatus, 0x001b, 0x80);
+		MODIFY(0x001b, 1 << 7, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x000c, 0x10);
+		//SEND(kUSBRqGetStatus, 0x000c, 0x10);
+		MODIFY(0x000c, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x0012, 0x27);
+		//SEND(kUSBRqGetStatus, 0x0012, 0x67);
+		MODIFY(0x0012, 1 << 6, 0),
+		STROBE(0x0022, 0x10),
+		STROBE(0x0020, 0x10),
+		//RECEIVE(kUSBRqGetStatus, 0x000f, 0x07);
+		//SEND(kUSBRqGetStatus, 0x000f, 0x07);
+		MODIFY(0x000f, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
+		GPIO(0x0008, 0, 0),
+		SEND(kUSBRqSetFeature, 0x004a, 0x1f),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x00),
+		RECEIVE(kUSBRqGetState, 0x004a, 0xb1),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x00),
+		REG_WR(0x0021, 0x08),
+		STROBE(0x0020, 0x10),
+		//SEND(kUSBRqGetState, 0x004a, 0x0d, 0x00);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		STROBE(0x0022, 0x10),
+		REG_WR(0x0014, 0x32),
+		REG_WR(0x0025, 0x02),
+		//RECEIVE(kUSBRqGetStatus, 0x000e, 0x90);
+		//SEND(kUSBRqGetStatus, 0x000e, 0x90);
+		MODIFY(0x000e, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x000f, 0x07);
+		//SEND(kUSBRqGetStatus, 0x000f, 0x87);
+		MODIFY(0x000f, 0, 1 << 7),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xf8);
+		GPIO(0x0008, 0, 1 << 1),
+		//SEND(kUSBRqGetState, 0x004a, 0x0a, 0x80);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x0e, 0x01);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		//SEND(kUSBRqGetState, 0x004a, 0x08, 0x88);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		REG_WR(0x0021, 0x08),
+		STROBE(0x0020, 0x10),
+		//SEND(kUSBRqGetState, 0x004a, 0x0d, 0x00);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		STROBE(0x0022, 0x10),
+		REG_WR(0x0014, 0x32),
+		REG_WR(0x0025, 0x02),
+	};
+	if(![self performControlRequests:decoderRequests count:numberof(decoderRequests)]) return;
 	//SELECT_INTERFACE
 	if(resolution640) {
 		[self setAlternateInterface:5];
@@ -323,63 +358,69 @@ static void ECVPixelFormatHack(uint16_t *const bytes, size_t const len) {
 	}
 	//RECEIVE(kUSBRqGetStatus, 0x000f, 0x87);
 	//SEND(kUSBRqGetStatus, 0x000f, 0x07);
-	[self modifyIndex:0x000f enable:0 disable:1 << 7];
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xf8);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
-	[self modifyIndex:0x0008 enable:1 << 1 disable:0];
-	SEND(kUSBRqGetStatus, 0x0020, 0x00);
-	SEND(kUSBRqGetStatus, 0x0022, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0012, 0x67);
-	//SEND(kUSBRqGetStatus, 0x0012, 0x27);
-	[self modifyIndex:0x0012 enable:0 disable:1 << 6];
-	//RECEIVE(kUSBRqGetStatus, 0x000c, 0x10);
-	//SEND(kUSBRqGetStatus, 0x000c, 0x00);
-	[self modifyIndex:0x000c enable:0 disable:1 << 4];
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
-	[self modifyIndex:0x0008 enable:1 << 2 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
-	[self modifyIndex:0x0008 enable:0 disable:1 << 2];
-	SEND(kUSBRqGetStatus, 0x0006, 0x40);
-	SEND(kUSBRqGetStatus, 0x0015, 0x20);
-	SEND(kUSBRqGetStatus, 0x0016, 0x20);
-	SEND(kUSBRqGetStatus, 0x0017, 0x20);
-	SEND(kUSBRqGetStatus, 0x0018, 0x00);
-	SEND(kUSBRqGetStatus, 0x0019, 0x00);
-	SEND(kUSBRqGetStatus, 0x001a, 0x00);
-	SEND(kUSBRqGetStatus, 0x0023, 0x00);
-	SEND(kUSBRqGetStatus, 0x0024, 0x00);
-	SEND(kUSBRqGetStatus, 0x0026, 0x00);
-	SEND(kUSBRqGetStatus, 0x0013, 0x08);
-	//RECEIVE(kUSBRqGetStatus, 0x0012, 0x27);
-	//SEND(kUSBRqGetStatus, 0x0012, 0x27);
-	[self modifyIndex:0x0012 enable:0 disable:0];
-	SEND(kUSBRqGetStatus, 0x000c, 0x10);
-	SEND(kUSBRqGetStatus, 0x0027, 0x34);
-	SEND(kUSBRqGetStatus, 0x0010, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0011, 0x10);
-	//SEND(kUSBRqGetStatus, 0x0011, 0x11);
-	[self modifyIndex:0x0011 enable:1 << 0 disable:0];
-	SEND(kUSBRqGetStatus, 0x0028, 0x01);
-	SEND(kUSBRqGetStatus, 0x0029, 0xb3);
-	SEND(kUSBRqGetStatus, 0x002a, 0x01);
-	SEND(kUSBRqGetStatus, 0x002b, 0x3b);
-	SEND(kUSBRqGetStatus, 0x001c, 0x00);
-	SEND(kUSBRqGetStatus, 0x001d, 0x03);
-	SEND(kUSBRqGetStatus, 0x001e, 0xb4);
-	SEND(kUSBRqGetStatus, 0x001f, 0x3c);
-	//RECEIVE(kUSBRqGetStatus, 0x001b, 0x80);
-	//SEND(kUSBRqGetStatus, 0x001b, 0x80);
-	[self modifyIndex:0x001b enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x001b, 0x80);
-	//SEND(kUSBRqGetStatus, 0x001b, 0x80);
-	[self modifyIndex:0x001b enable:0 disable:0];
+	static ECVControlRequest const streamRequests[] = {
+		MODIFY(0x000f, 0, 1 << 7),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xf8);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
+		GPIO(0x0008, 1 << 1, 0),
+		STROBE(0x0020, 0x00),
+		STROBE(0x0022, 0x00),
+		//RECEIVE(kUSBRqGetStatus, 0x0012, 0x67);
+		//SEND(kUSBRqGetStatus, 0x0012, 0x27);
+		MODIFY(0x0012, 0, 1 << 6),
+		//RECEIVE(kUSBRqGetStatus, 0x000c, 0x10);
+		//SEND(kUSBRqGetStatus, 0x000c, 0x00);
+		MODIFY(0x000c, 0, 1 << 4),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfe);
+		GPIO(0x0008, 1 << 2, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfe);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xfa);
+		GPIO(0x0008, 0, 1 << 2),
+		REG_WR(0x0006, 0x40),
+		REG_WR(0x0015, 0x20),
+		REG_WR(0x0016, 0x20),
+		REG_WR(0x0017, 0x20),
+		REG_WR(0x0018, 0x00),
+		REG_WR(0x0019, 0x00),
+		REG_WR(0x001a, 0x00),
+		REG_WR(0x0023, 0x00),
+		REG_WR(0x0024, 0x00),
+		REG_WR(0x0026, 0x00),
+		REG_WR(0x0013, 0x08),
+		//RECEIVE(kUSBRqGetStatus, 0x0012, 0x27);
+		//SEND(kUSBRqGetStatus, 0x0012, 0x27);
+		MODIFY(0x0012, 0, 0),
+		REG_WR(0x000c, 0x10),
+		REG_WR(0x0027, 0x34),
+		REG_WR(0x0010, 0x00),
+		//RECEIVE(kUSBRqGetStatus, 0x0011, 0x10);
+		//SEND(kUSBRqGetStatus, 0x0011, 0x11);
+		MODIFY(0x0011, 1 << 0, 0),
+		REG_WR(0x0028, 0x01),
+		REG_WR(0x0029, 0xb3),
+		REG_WR(0x002a, 0x01),
+		REG_WR(0x002b, 0x3b),
+		REG_WR(0x001c, 0x00),
+		REG_WR(0x001d, 0x03),
+		REG_WR(0x001e, 0xb4),
+		REG_WR(0x001f, 0x3c),
+		//RECEIVE(kUSBRqGetStatus, 0x001b, 0x80);
+		//SEND(kUSBRqGetStatus, 0x001b, 0x80);
+		MODIFY(0x001b, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x001b, 0x80);
+		//SEND(kUSBRqGetStatus, 0x001b, 0x80);
+		MODIFY(0x001b, 0, 0),
+	};
+	if(![self performControlRequests:streamRequests count:numberof(streamRequests)]) return;
 	if(resolution640) {
 		//RECEIVE(kUSBRqGetStatus, 0x0026, 0x00);
 		//SEND(kUSBRqGetStatus, 0x0026, 0x10);
-		[self modifyIndex:0x0026 enable:1 << 4 disable:0];
-		SEND(kUSBRqGetStatus, 0x0030, 0x99, 0x01);
+		static ECVControlRequest const stream640Requests[] = {
+			MODIFY(0x0026, 1 << 4, 0),
+			SEND(kUSBRqGetStatus, 0x0030, 0x99, 0x01),
+		};
+		if(![self performControlRequests:stream640Requests count:numberof(stream640Requests)]) return;
 	}
 	//SEND(kUSBRqGetState, 0x004a, 0x01, 0x08);
 	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
@@ -401,65 +442,86 @@ static void ECVPixelFormatHack(uint16_t *const bytes, size_t const len) {
 	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
 	//SEND(kUSBRqGetState, 0x004a, 0x02, 0xc0);
 	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	SEND(kUSBRqGetStatus, 0x0021, 0x08);
-	SEND(kUSBRqGetStatus, 0x0020, 0x10);
-	//SEND(kUSBRqGetState, 0x004a, 0x0d, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	SEND(kUSBRqGetStatus, 0x0022, 0x10);
-	SEND(kUSBRqGetStatus, 0x0014, 0x32);
-	SEND(kUSBRqGetStatus, 0x0025, 0x02);
+	static ECVControlRequest const captureRequests[] = {
+		REG_WR(0x0021, 0x08),
+		STROBE(0x0020, 0x10),
+		//SEND(kUSBRqGetState, 0x004a, 0x0d, 0x00);
+		//RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
+		STROBE(0x0022, 0x10),
+		REG_WR(0x0014, 0x32),
+		REG_WR(0x0025, 0x02),
+	};
+	if(![self performControlRequests:captureRequests count:numberof(captureRequests)]) return;
 	if(resolution640) {
 		//RECEIVE(kUSBRqGetStatus, 0x0026, 0x10);
 		//SEND(kUSBRqGetStatus, 0x0026, 0x10);
-		[self modifyIndex:0x0026 enable:0 disable:0];
+		static ECVControlRequest const capture640Requests[] = {
+			MODIFY(0x0026, 0, 0),
+		};
+		if(![self performControlRequests:capture640Requests count:numberof(capture640Requests)]) return;
 	} else {
 		//RECEIVE(kUSBRqGetStatus, 0x0026, 0x00);
 		//SEND(kUSBRqGetStatus, 0x0026, 0x00);
-		[self modifyIndex:0x0026 enable:0 disable:0];
+		static ECVControlRequest const capture720Requests[] = {
+			MODIFY(0x0026, 0, 0),
+		};
+		if(![self performControlRequests:capture720Requests count:numberof(capture720Requests)]) return;
 	}
-	SEND(kUSBRqSetFeature, 0x004a, 0x1f);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	RECEIVE(kUSBRqGetState, 0x004a, 0xb1);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x0027, 0x34);
-	//SEND(kUSBRqGetStatus, 0x0027, 0x34);
-	[self modifyIndex:0x0027 enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x0011, 0x11);
-	//SEND(kUSBRqGetStatus, 0x0011, 0x11);
-	[self modifyIndex:0x0011 enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x001b, 0x80);
-	//SEND(kUSBRqGetStatus, 0x001b, 0x00);
-	[self modifyIndex:0x001b enable:0 disable:1 << 7];
-	//RECEIVE(kUSBRqGetStatus, 0x000c, 0x10);
-	//SEND(kUSBRqGetStatus, 0x000c, 0x10);
-	[self modifyIndex:0x000c enable:0 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x0012, 0x27);
-	//SEND(kUSBRqGetStatus, 0x0012, 0x67);
-	[self modifyIndex:0x0012 enable:1 << 6 disable:0];
-	SEND(kUSBRqGetStatus, 0x0022, 0x10);
-	SEND(kUSBRqGetStatus, 0x0020, 0x10);
+	static ECVControlRequest const startRequests[] = {
+		SEND(kUSBRqSetFeature, 0x004a, 0x1f),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x00),
+		RECEIVE(kUSBRqGetState, 0x004a, 0xb1),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x00),
+		//RECEIVE(kUSBRqGetStatus, 0x0027, 0x34);
+		//SEND(kUSBRqGetStatus, 0x0027, 0x34);
+		MODIFY(0x0027, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x0011, 0x11);
+		//SEND(kUSBRqGetStatus, 0x0011, 0x11);
+		MODIFY(0x0011, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x001b, 0x80);
+		//SEND(kUSBRqGetStatus, 0x001b, 0x00);
+		MODIFY(0x001b, 0, 1 << 7),
+		//RECEIVE(kUSBRqGetStatus, 0x000c, 0x10);
+		//SEND(kUSBRqGetStatus, 0x000c, 0x10);
+		MODIFY(0x000c, 0, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x0012, 0x27);
+		//SEND(kUSBRqGetStatus, 0x0012, 0x67);
+		MODIFY(0x0012, 1 << 6, 0),
+		STROBE(0x0022, 0x10),
+		STROBE(0x0020, 0x10),
+	};
+	if(![self performControlRequests:startRequests count:numberof(startRequests)]) return;
 	if(resolution640) {
 		//RECEIVE(kUSBRqGetStatus, 0x000e, 0x95);
 		//SEND(kUSBRqGetStatus, 0x000e, 0x95);
-		[self modifyIndex:0x000e enable:0 disable:0];
+		static ECVControlRequest const start640Requests[] = {
+			MODIFY(0x000e, 0, 0),
+		};
+		if(![self performControlRequests:start640Requests count:numberof(start640Requests)]) return;
 	} else {
 		//RECEIVE(kUSBRqGetStatus, 0x000e, 0x96);
 		//SEND(kUSBRqGetStatus, 0x000e, 0x96);
-		[self modifyIndex:0x000e enable:0 disable:0];
+		static ECVControlRequest const start720Requests[] = {
+			MODIFY(0x000e, 0, 0),
+		};
+		if(![self performControlRequests:start720Requests count:numberof(start720Requests)]) return;
 	}
 	//RECEIVE(kUSBRqGetStatus, 0x000f, 0x07);
 	//SEND(kUSBRqGetStatus, 0x000f, 0x87);
-	[self modifyIndex:0x000f enable:1 << 7 disable:0];
-	//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
-	//SEND(kUSBRqGetStatus, 0x0008, 0xf8);
-	[self modifyIndex:0x0008 enable:0 disable:1 << 1];
-	SEND(kUSBRqSetFeature, 0x004a, 0x1f);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	RECEIVE(kUSBRqGetState, 0x004a, 0xb1);
-	RECEIVE(kUSBRqGetStatus, 0x0005, 0x00);
-	//RECEIVE(kUSBRqGetStatus, 0x000c, 0x10);
-	//SEND(kUSBRqGetStatus, 0x000c, 0x10);
-	[self modifyIndex:0x000c enable:0 disable:0];
+	static ECVControlRequest const finishRequests[] = {
+		MODIFY(0x000f, 1 << 7, 0),
+		//RECEIVE(kUSBRqGetStatus, 0x0008, 0xfa);
+		//SEND(kUSBRqGetStatus, 0x0008, 0xf8);
+		GPIO(0x0008, 0, 1 << 1),
+		SEND(kUSBRqSetFeature, 0x004a, 0x1f),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x00),
+		RECEIVE(kUSBRqGetState, 0x004a, 0xb1),
+		RECEIVE(kUSBRqGetStatus, 0x0005, 0x00),
+		//RECEIVE(kUSBRqGetStatus, 0x000c, 0x10);
+		//SEND(kUSBRqGetStatus, 0x000c, 0x10);
+		MODIFY(0x000c, 0, 0),
+	};
+	if(![self performControlRequests:finishRequests count:numberof(finishRequests)]) return;
 	//RESET_PIPE
 	//GET_CURRENT_FRAME_NUMBER
 
@@ -529,11 +591,16 @@ static void ECVPixelFormatHack(uint16_t *const bytes, size_t const len) {
 
 - (BOOL)writeSAA711XRegister:(u_int8_t)reg value:(int16_t)val
 {
-	UInt8 data[] = {reg, val};
-	UInt8 error = 0;
-	if(![self writeRequest:kUSBRqGetState value:0 index:0x004a length:sizeof(data) data:data]) return NO;
-	if(![self readRequest:kUSBRqGetStatus value:0 index:0x0005 length:sizeof(error) data:&error]) return NO;
-	return !error;
+	UInt8 const data[] = {reg, val};
+	return [self _writeI2CData:data length:sizeof(data)];
+}
+- (BOOL)writeSAA711XRegister:(u_int8_t const)reg values:(u_int8_t const *const)vals count:(NSUInteger const)count
+{
+	UInt8 data[ECVEM2860MaximumI2CLength];
+	if(count >= sizeof(data)) return NO;
+	data[0] = reg;
+	memcpy(data + 1, vals, count);
+	return [self _writeI2CData:data length:count + 1];
 }
 - (BOOL)readSAA711XRegister:(u_int8_t)reg value:(out u_int8_t *)outVal
 {
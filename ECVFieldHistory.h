@@ -0,0 +1,44 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Keeps the raw bytes of the most recent field of each parity so that parsers can fill in data lost in transit.
+@interface ECVFieldHistory : NSObject
+{
+	@private
+	NSUInteger _fieldLength;
+	NSUInteger _bytesPerRow;
+	NSMutableData *_highField;
+	NSMutableData *_lowField;
+	ECVFieldType _fieldType;
+	NSUInteger _concealedLines;
+}
+
+- (id)initWithFieldLength:(NSUInteger const)fieldLength bytesPerRow:(NSUInteger const)bytesPerRow pixelFormat:(OSType const)pixelFormat;
+- (NSUInteger)fieldLength;
+- (NSUInteger)bytesPerRow;
+
+- (void)beginFieldWithType:(ECVFieldType const)fieldType;
+- (NSUInteger)concealedLines; // In the current field.
+
+- (void)recordBytes:(void const *const)bytes inRange:(NSRange const)range;
+- (void const *)bytesForConcealingRange:(NSRange const)range; // Returns the bytes of the previous field of the same parity, starting at range.location.
+
+@end
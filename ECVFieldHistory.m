@@ -0,0 +1,103 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVFieldHistory.h"
+
+// Other Sources
+#import "ECVPixelFormat.h"
+
+@interface ECVFieldHistory(Private)
+
+- (NSMutableData *)_currentField;
+
+@end
+
+@implementation ECVFieldHistory
+
+#pragma mark -ECVFieldHistory
+
+- (id)initWithFieldLength:(NSUInteger const)fieldLength bytesPerRow:(NSUInteger const)bytesPerRow pixelFormat:(OSType const)pixelFormat
+{
+	NSParameterAssert(bytesPerRow);
+	if((self = [super init])) {
+		_fieldLength = fieldLength;
+		_bytesPerRow = bytesPerRow;
+		_highField = [[NSMutableData alloc] initWithLength:fieldLength];
+		_lowField = [[NSMutableData alloc] initWithLength:fieldLength];
+		uint64_t const black = ECVPixelFormatBlackPattern(pixelFormat);
+		memset_pattern8([_highField mutableBytes], &black, fieldLength);
+		memset_pattern8([_lowField mutableBytes], &black, fieldLength);
+		_fieldType = ECVHighField;
+	}
+	return self;
+}
+- (NSUInteger)fieldLength
+{
+	return _fieldLength;
+}
+- (NSUInteger)bytesPerRow
+{
+	return _bytesPerRow;
+}
+
+#pragma mark -
+
+- (void)beginFieldWithType:(ECVFieldType const)fieldType
+{
+	_fieldType = fieldType;
+	_concealedLines = 0;
+}
+- (NSUInteger)concealedLines
+{
+	return _concealedLines;
+}
+
+#pragma mark -
+
+- (void)recordBytes:(void const *const)bytes inRange:(NSRange const)range
+{
+	if(range.location >= _fieldLength) return;
+	memcpy([[self _currentField] mutableBytes] + range.location, bytes, MIN(range.length, _fieldLength - range.location));
+}
+- (void const *)bytesForConcealingRange:(NSRange const)range
+{
+	NSParameterAssert(NSMaxRange(range) <= _fieldLength);
+	if(range.length) _concealedLines += (NSMaxRange(range) - 1) / _bytesPerRow - range.location / _bytesPerRow + 1;
+	return [[self _currentField] bytes] + range.location; // We haven't overwritten this range yet, so it still holds the last field of this parity.
+}
+
+#pragma mark -ECVFieldHistory(Private)
+
+- (NSMutableData *)_currentField
+{
+	return ECVLowField == _fieldType ? _lowField : _highField;
+}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	[_highField release];
+	[_lowField release];
+	[super dealloc];
+}
+
+@end
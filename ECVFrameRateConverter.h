@@ -24,13 +24,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVRational.h"
 #import <AVFoundation/AVFoundation.h>
 
+#define ECVFrameRateConverterHysteresis 0.25 // Target frames the timed count may stray past the nominal pattern before a frame is added or dropped.
+
+// Decides how many times each source frame should be shown to produce the target rate. Counts of 0 drop the frame, so conversion works in both directions.
 @interface ECVFrameRateConverter : NSObject
 {
 	CMTime _sourceFrameRate;
 	CMTime _targetFrameRate;
-	NSData *_frameRepeatData;
-	NSUInteger _count;
-	NSUInteger _index;
+	ECVRational _ratio;
+	NSInteger _accumulator;
+	NSTimeInterval _startTime;
+	NSTimeInterval _previousTime;
+	NSUInteger _targetFrameCount;
 }
 
 + (CMTime)frameRateWithRatio:(ECVRational)ratio ofFrameRate:(CMTime)rate;
@@ -39,7 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 @property(readonly, assign) CMTime sourceFrameRate;
 @property(readonly, assign) CMTime targetFrameRate;
 
-- (NSUInteger)currentFrameRepeatCount;
-- (NSUInteger)nextFrameRepeatCount;
+- (NSUInteger)nextFrameRepeatCount; // Assumes the source runs at exactly its nominal rate.
+- (NSUInteger)nextFrameRepeatCountForTime:(NSTimeInterval)time; // Follows actual presentation times instead, so a source clock that runs fast or slow drops or repeats frames to stay in step. Pass 0 for frames without a time. Don't mix with -nextFrameRepeatCount.
 
 @end
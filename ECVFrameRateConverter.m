@@ -22,6 +22,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVFrameRateConverter.h"
 #import <AVFoundation/AVFoundation.h>
 
+#define ECVFrameRateConverterMaximumGap 1.0 // Seconds. Longer gaps (pauses, clock resyncs) restart the timeline instead of being filled with repeats.
 
 static ECVRational ECVRationalFromCMTime(CMTime t)
 {
@@ -32,14 +33,6 @@ static CMTime ECVRationalToCMTime(ECVRational r)
 	return CMTimeMake(r.numer,(int32_t)r.denom);
 }
 
-@interface ECVFrameRateConverter(Private)
-
-+ (NSData *)_frameRepeatDataWithSourceFrameRate:(CMTime)sourceFrameRate targetFrameRate:(CMTime)targetFrameRate;
-
-- (NSUInteger)_repeatCountForFrame:(NSUInteger)i;
-
-@end
-
 @implementation ECVFrameRateConverter
 
 #pragma mark +ECVFrameRateConverter
@@ -49,37 +42,6 @@ static CMTime ECVRationalToCMTime(ECVRational r)
 	return ECVRationalToCMTime(ECVRationalDivide(ECVRationalFromCMTime(rate), ratio));
 }
 
-#pragma mark +ECVFrameRateConverter(Private)
-
-+ (NSData *)_frameRepeatDataWithSourceFrameRate:(CMTime)sourceFrameRate targetFrameRate:(CMTime)targetFrameRate
-{
-	ECVRational const s = ECVRationalFromCMTime(sourceFrameRate);
-	ECVRational const t = ECVRationalFromCMTime(targetFrameRate);
-	ECVRational const ratio = ECVRationalDivide(s, t);
-	ECVRational const one = ECVMakeRational(1, 1);
-
-	ECVRational const targetFrameCount = ECVRationalLCM(ratio, one);
-	ECVRational const sourceFrameCount = ECVRationalDivide(targetFrameCount, ratio);
-	ECVRational const lowerBoundRatio = ECVMakeRational(floor(ECVRationalToCGFloat(ratio)), 1);
-	ECVRational const extraFrames = ECVRationalSubtract(targetFrameCount, ECVRationalMultiply(lowerBoundRatio, sourceFrameCount));
-
-	NSUInteger const sourceFrameCountInteger = ECVRationalToNSInteger(sourceFrameCount);
-	NSMutableData *const data = [NSMutableData dataWithLength:sizeof(NSUInteger) * sourceFrameCountInteger];
-	NSUInteger *const values = (NSUInteger *)[data mutableBytes];
-	NSUInteger i;
-
-	NSUInteger const lowerBoundRatioInteger = ECVRationalToNSInteger(lowerBoundRatio);
-	for(i = 0; i < sourceFrameCountInteger; ++i) values[i] = lowerBoundRatioInteger;
-
-	NSUInteger remaining = ECVRationalToNSInteger(extraFrames);
-	if(remaining) {
-		NSUInteger const extraFrameFrequency = floor(ECVRationalToCGFloat(ECVRationalDivide(sourceFrameCount, extraFrames)));
-		for(i = 0; i < sourceFrameCountInteger && remaining; i += extraFrameFrequency, --remaining) values[i]++;
-	}
-
-	return data;
-}
-
 #pragma -ECVFrameRateConverter
 
 - (id)initWithSourceFrameRate:(CMTime)sourceFrameRate targetFrameRate:(CMTime)targetFrameRate
@@ -87,9 +49,11 @@ static CMTime ECVRationalToCMTime(ECVRational r)
 	if((self = [super init])) {
 		_sourceFrameRate = sourceFrameRate;
 		_targetFrameRate = targetFrameRate;
-		_frameRepeatData = [[[self class] _frameRepeatDataWithSourceFrameRate:sourceFrameRate targetFrameRate:targetFrameRate] copy];
-		_count = [_frameRepeatData length] / sizeof(NSUInteger);
-		_index = 0;
+		_ratio = ECVRationalDivide(ECVRationalFromCMTime(sourceFrameRate), ECVRationalFromCMTime(targetFrameRate)); // Target frames per source frame.
+		_accumulator = 0;
+		_startTime = 0.0;
+		_previousTime = 0.0;
+		_targetFrameCount = 0;
 	}
 	return self;
 }
@@ -98,29 +62,31 @@ static CMTime ECVRationalToCMTime(ECVRational r)
 
 #pragma mark -
 
-- (NSUInteger)currentFrameRepeatCount
-{
-	return [self _repeatCountForFrame:_index];
-}
 - (NSUInteger)nextFrameRepeatCount
 {
-	return [self _repeatCountForFrame:(_index++ % _count)];
+	// Like Bresenham's line algorithm, the remainder carries over so the long-run count is exact without a table.
+	_accumulator += _ratio.numer;
+	NSUInteger const count = (NSUInteger)(_accumulator / _ratio.denom);
+	_accumulator %= _ratio.denom;
+	return count;
 }
-
-#pragma mark -ECVFrameRateConverter(Private)
-
-- (NSUInteger)_repeatCountForFrame:(NSUInteger)i
-{
-	NSParameterAssert(i < _count);
-	return ((NSUInteger *)[_frameRepeatData bytes])[i];
-}
-
-#pragma mark -NSObject
-
-- (void)dealloc
+- (NSUInteger)nextFrameRepeatCountForTime:(NSTimeInterval)time
 {
-	[_frameRepeatData release];
-	[super dealloc];
+	NSTimeInterval const sourceFrameDuration = CMTimeGetSeconds(_sourceFrameRate);
+	NSTimeInterval const targetFrameDuration = CMTimeGetSeconds(_targetFrameRate);
+	NSTimeInterval const expectedTime = _previousTime + sourceFrameDuration;
+	if(time <= 0.0) time = expectedTime; // Untimed frames follow the previous one at the nominal rate.
+	if(!_targetFrameCount && !_previousTime) _startTime = time;
+	else if(fabs(time - expectedTime) > ECVFrameRateConverterMaximumGap) _startTime += time - expectedTime;
+	_previousTime = time;
+	// Start from the nominal pattern, then add or drop frames once the actual times pull it more than the hysteresis away. Jitter smaller than that never causes a repeat followed by a drop, and because the error is measured against the elapsed time rather than summed, it can't drift.
+	NSUInteger count = [self nextFrameRepeatCount];
+	double const dueCount = (time - _startTime + sourceFrameDuration) / targetFrameDuration;
+	double error = (double)(_targetFrameCount + count) - dueCount; // The nominal pattern alone keeps this in (-1, 0].
+	for(; error < -1.0 - ECVFrameRateConverterHysteresis; error += 1.0) count++;
+	for(; error > ECVFrameRateConverterHysteresis && count; error -= 1.0) count--;
+	_targetFrameCount += count;
+	return count;
 }
 
 @end
@@ -20,11 +20,22 @@ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVCaptureDevice.h"
+#import "ECVControlQueue.h"
 
-@interface ECVFushicaiDevice : ECVCaptureDevice
+// Models
+@class ECVFieldHistory;
+
+#define ECVFushicaiPictureControlCount 3 // Hue, saturation, brightness and contrast.
+
+@interface ECVFushicaiDevice : ECVCaptureDevice <ECVControlQueueDelegate>
 {
 	@private
 	NSUInteger _offset;
+	NSUInteger _packetIndex;
+	ECVFieldHistory *_fieldHistory;
+	ECVControlQueue *_controlQueue;
+	NSInteger _pictureControlValues[ECVFushicaiPictureControlCount]; // Last value written, by ECVFushicaiPictureControlSlot().
+	BOOL _pictureControlWritten[ECVFushicaiPictureControlCount];
 	CGFloat _brightness;
 	CGFloat _contrast;
 	CGFloat _saturation;
@@ -33,6 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 
 - (BOOL)modifyIndex:(UInt16 const)idx enable:(UInt8 const)enable disable:(UInt8 const)disable;
 - (void)writePacket:(UInt8 const *const)bytes length:(NSUInteger const)length toStorage:(ECVVideoStorage *const)storage;
-- (void)writeBrightnessAndContrast;
+- (void)concealRange:(NSRange const)range inStorage:(ECVVideoStorage *const)storage;
+- (BOOL)writeValue:(NSInteger const)value forPictureControl:(UInt16 const)idx;
 
 @end
@@ -21,6 +21,10 @@ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVFushicaiDevice.h"
 
+// Models
+#import "ECVFieldHistory.h"
+#import "ECVVideoFrame.h"
+
 // TODO: Copy/pasted from ECVEM2860Device.
 static void ECVPixelFormatHack(uint16_t *const bytes, size_t const len) {
 	for(size_t i = 0; i < len / sizeof(uint16_t); ++i) bytes[i] = CFSwapInt16(bytes[i]);
@@ -29,25 +33,45 @@ static void ECVPixelFormatHack(uint16_t *const bytes, size_t const len) {
 enum {
 	ECVFushicaiHighFieldFlag = 1 << 3,
 };
+enum {
+	ECVFushicaiHueIndex = 0xc240, // 2 bytes.
+	ECVFushicaiSaturationIndex = 0xc242, // 2 bytes.
+	ECVFushicaiBrightnessAndContrastIndex = 0xc244, // 3 bytes.
+};
+#define ECVFushicaiPictureControlSlot(idx) (((idx) - ECVFushicaiHueIndex) / 2)
+
+static NSInteger ECVFushicaiBrightnessAndContrastValue(CGFloat const brightness, CGFloat const contrast)
+{
+	uint16_t const b = round(brightness * 0x3ff);
+	uint16_t const c = round(contrast * 0x3ff);
+	return (((c >> 4) & 0xf0) | ((b >> 8) & 0x0f)) << 16 | (c & 0xff) << 8 | (b & 0xff);
+}
+static NSInteger ECVFushicaiSaturationValue(CGFloat const saturation)
+{
+	return (uint16_t)round(saturation * 0x3ff);
+}
+static NSInteger ECVFushicaiHueValue(CGFloat const hue)
+{
+	uint16_t x = round(hue * (0xdff*2));
+	if(x <= 0xdff) x = 0x8fff - x;
+	else x = 0x9200 - 0xdff + x;
+	return x;
+}
+
+#define ECVFushicaiPacketLength 1024
+#define ECVFushicaiHeaderLength 4
+#define ECVFushicaiTrailerLength 60
 
 #define CTRL(pipe, type, req, idx, val) \
 ({ \
 	[self controlRequestWithType:type request:req value:val index:idx length:0 data:NULL];\
 })
 
-#define VND_RD(request, idx, val, ...) \
-({ \
-	u_int8_t const expected[] = {__VA_ARGS__}; \
-	u_int8_t data[] = {__VA_ARGS__}; \
-	size_t const length = sizeof(expected); \
-	if(![self readRequest:(request) value:(val) index:(idx) length:length data:data]) return; \
-	if(memcmp(expected, data, length) != 0) ECVLog(ECVNotice, @"Line %d, read %04x: Expected %@, received %@", __LINE__, (idx), [NSData dataWithBytesNoCopy:(void *)expected length:length freeWhenDone:NO], [NSData dataWithBytesNoCopy:(void *)data length:length freeWhenDone:NO]); \
-})
-#define VND_WR(request, idx, val, ...) \
-({ \
-	u_int8_t data[] = {__VA_ARGS__}; \
-	if(![self writeRequest:(request) value:(val) index:(idx) length:sizeof(data) data:data]) return; \
-})
+#define VND_RD(request, idx, val, ...) ECVControlRequestMake(ECVControlRead, (request), (val), (idx), __VA_ARGS__)
+#define VND_WR(request, idx, val) {ECVControlWrite, (request), (val), (idx), 0, {0}}
+#define REG_WR(idx, val) ECVControlRegisterWriteMake((idx), (val))
+#define MODIFY(idx, enable, disable) ECVControlRegisterModifyMake((idx), (enable), (disable))
+#define STROBE(idx, val) ECVControlRegisterStrobeMake((idx), (val)) // Repeats in the tables below are deliberate, so these are never skipped.
 
 @implementation ECVFushicaiDevice
 
@@ -55,17 +79,12 @@ enum {
 
 - (BOOL)modifyIndex:(UInt16 const)idx enable:(UInt8 const)enable disable:(UInt8 const)disable
 {
-	NSAssert(!(enable & disable), @"Can't enable and disable the same flag(s).");
-	UInt8 old = 0;
-	if(![self readRequest:11 value:0 index:idx length:sizeof(old) data:&old]) return NO;
-	UInt8 new = (old | enable) & ~disable;
-	if(![self writeRequest:12 value:new index:idx length:0 data:NULL]) return NO;
-	return YES;
+	return [self modifyRegister:idx enable:enable disable:disable];
 }
 - (void)writePacket:(UInt8 const *const)bytes length:(NSUInteger const)length toStorage:(ECVVideoStorage *const)storage
 {
-	NSUInteger const headerLength = 4;
-	NSUInteger const trailerLength = 60;
+	NSUInteger const headerLength = ECVFushicaiHeaderLength;
+	NSUInteger const trailerLength = ECVFushicaiTrailerLength;
 
 	if(length < headerLength + trailerLength) return;
 	if(0x00 == bytes[0]) return; // Empty packet.
@@ -78,11 +97,23 @@ enum {
 	NSUInteger const flags = (bytes[2] >> 4) & 0x0f;
 	NSUInteger const packetIndex = (bytes[2] & 0x0f) << 8 | bytes[3];
 
-	if(0x000 == packetIndex) {
+	NSUInteger const fieldLength = [_fieldHistory fieldLength];
+	BOOL const missedStart = NSNotFound != _packetIndex && packetIndex <= _packetIndex; // Packet 0 of this field was lost.
+	if(0x000 == packetIndex || missedStart) {
+		if(NSNotFound != _packetIndex && _offset < fieldLength) [self concealRange:NSMakeRange(_offset, fieldLength - _offset) inStorage:storage];
 		ECVFieldType const field = ECVFushicaiHighFieldFlag & flags ? ECVHighField : ECVLowField;
-		[self pushVideoFrame:[storage finishedFrameWithNextFieldType:field]];
+		ECVVideoFrame *const frame = [storage finishedFrameWithNextFieldType:field];
+		[frame setConcealedLines:[_fieldHistory concealedLines]];
+		[self pushVideoFrame:frame];
+		[_fieldHistory beginFieldWithType:field];
 		_offset = 0;
 	}
+	_packetIndex = packetIndex;
+
+	// Every packet carries the same amount of video, so the index tells us exactly where this one goes.
+	NSUInteger const expectedOffset = MIN(packetIndex * (ECVFushicaiPacketLength - headerLength - trailerLength), fieldLength);
+	if(expectedOffset > _offset) [self concealRange:NSMakeRange(_offset, expectedOffset - _offset) inStorage:storage];
+	_offset = expectedOffset;
 
 	// TODO: This gets copy and pasted over and over... Can we abstract it?
 	NSUInteger const realLength = length - headerLength - trailerLength;
@@ -94,18 +125,33 @@ enum {
 	ECVPointerPixelBuffer *const buffer = [[ECVPointerPixelBuffer alloc] initWithPixelSize:inputSize bytesPerRow:bytesPerRow pixelFormat:pixelFormat bytes:bytes + headerLength validRange:NSMakeRange(_offset, realLength)];
 	[storage drawPixelBuffer:buffer atPoint:(ECVIntegerPoint){-8, 0}];
 	[buffer release];
+	[_fieldHistory recordBytes:bytes + headerLength inRange:NSMakeRange(_offset, realLength)];
 	_offset += realLength;
 }
-- (void)writeBrightnessAndContrast
+- (void)concealRange:(NSRange const)range inStorage:(ECVVideoStorage *const)storage
 {
-	uint16_t const b = round(_brightness * 0x3ff);
-	uint16_t const c = round(_contrast * 0x3ff);
-	uint8_t data[] = {
-		((c >> 4) & 0xf0) | ((b >> 8) & 0x0f),
-		c & 0xff,
-		b & 0xff,
-	};
-	[self writeRequest:11 value:0 index:0xc244 length:sizeof(data) data:&data];
+	if(!range.length) return;
+	ECVIntegerSize const inputSize = (ECVIntegerSize){720, [[self videoFormat] frameSize].height};
+	ECVPointerPixelBuffer *const buffer = [[ECVPointerPixelBuffer alloc] initWithPixelSize:inputSize bytesPerRow:[_fieldHistory bytesPerRow] pixelFormat:[self pixelFormat] bytes:[_fieldHistory bytesForConcealingRange:range] validRange:range];
+	[storage drawPixelBuffer:buffer atPoint:(ECVIntegerPoint){-8, 0}];
+	[buffer release];
+}
+- (BOOL)writeValue:(NSInteger const)value forPictureControl:(UInt16 const)idx
+{
+	NSUInteger const slot = ECVFushicaiPictureControlSlot(idx);
+	NSParameterAssert(slot < ECVFushicaiPictureControlCount);
+	NSUInteger const length = ECVFushicaiBrightnessAndContrastIndex == idx ? 3 : 2;
+	UInt8 data[3] = {0};
+	for(NSUInteger i = 0; i < length; ++i) data[i] = (value >> ((length - i - 1) * 8)) & 0xff; // Big endian.
+	[self lockControlRequests];
+	BOOL success = YES;
+	if(!_pictureControlWritten[slot] || _pictureControlValues[slot] != value) { // The device already has it otherwise.
+		success = [self writeRequest:11 value:0 index:idx length:length data:data];
+		_pictureControlWritten[slot] = success;
+		_pictureControlValues[slot] = value;
+	}
+	[self unlockControlRequests];
+	return success;
 }
 
 #pragma mark -ECVCaptureDevice
@@ -116,7 +162,9 @@ enum {
 	_contrast = [[NSUserDefaults standardUserDefaults] doubleForKey:ECVContrastKey];
 	_saturation = [[NSUserDefaults standardUserDefaults] doubleForKey:ECVSaturationKey];
 	_hue = [[NSUserDefaults standardUserDefaults] doubleForKey:ECVHueKey];
-	return [super initWithService:service];
+	if(!(self = [super initWithService:service])) return nil;
+	_controlQueue = [[ECVControlQueue alloc] initWithDelegate:self];
+	return self;
 }
 
 #pragma mark -ECVCaptureDevice(ECVRead_Thread)
@@ -124,283 +172,315 @@ enum {
 - (void)read
 {
 [self setAlternateInterface:0];
-VND_RD(2, 0x0000, 0x00a0, 0x01, 0x3a);
-VND_RD(7, 0x003a, 0x00a0, 0x00, 0x6f);
-VND_RD(7, 0x0000, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c);
-VND_RD(7, 0x0020, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c);
-VND_RD(7, 0x0040, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c);
-VND_RD(7, 0x0060, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c);
-VND_RD(7, 0x0080, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c);
-VND_RD(7, 0x00a0, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c);
-VND_RD(7, 0x00c0, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c);
-VND_RD(7, 0x00e0, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c);
-VND_WR(12, 0xc008, 0x0001);
-VND_WR(12, 0xc1d0, 0x00ff);
-VND_WR(12, 0xc1d9, 0x0002);
-VND_WR(12, 0xc1da, 0x0013);
-VND_WR(12, 0xc1db, 0x0012);
-VND_WR(12, 0xc1e9, 0x0002);
-VND_WR(12, 0xc1ec, 0x006c);
-VND_WR(12, 0xc25b, 0x0030);
-VND_WR(12, 0xc254, 0x0073);
-VND_WR(12, 0xc294, 0x0020);
-VND_WR(12, 0xc255, 0x00cf);
-VND_WR(12, 0xc256, 0x0020);
-VND_WR(12, 0xc1eb, 0x0030);
-VND_WR(12, 0xc105, 0x0060);
-VND_WR(12, 0xc11f, 0x00f2);
-VND_WR(12, 0xc127, 0x0060);
-VND_WR(12, 0xc0ae, 0x0010);
-VND_WR(12, 0xc284, 0x00aa);
-VND_WR(12, 0xc003, 0x0004);
-	VND_WR(12, 0xc01a, 0x0068);
-	VND_WR(12, 0xc100, 0x00d3);
-	VND_WR(12, 0xc10e, 0x0072);
-	VND_WR(12, 0xc10f, 0x00a2);
-	VND_WR(12, 0xc112, 0x00b0);
-	VND_WR(12, 0xc115, 0x0015);
-	VND_WR(12, 0xc117, 0x0001);
-	VND_WR(12, 0xc118, 0x002c);
-	VND_WR(12, 0xc12d, 0x0010);
-	VND_WR(12, 0xc12f, 0x0020);
-	VND_WR(12, 0xc220, 0x002e);
-	VND_WR(12, 0xc225, 0x0008);
-	VND_WR(12, 0xc24e, 0x0002);
-	VND_WR(12, 0xc24f, 0x0002);
-	VND_WR(12, 0xc254, 0x0059);
-	VND_WR(12, 0xc25a, 0x0016);
-	VND_WR(12, 0xc25b, 0x0035);
-	VND_WR(12, 0xc263, 0x0017);
-	VND_WR(12, 0xc266, 0x0016);
-	VND_WR(12, 0xc267, 0x0036);
-	VND_WR(12, 0xc24e, 0x0002);
-	VND_WR(12, 0xc24f, 0x0002);
-VND_WR(12, 0xc239, 0x0040);
-VND_WR(12, 0xc240, 0x0000);
-VND_WR(12, 0xc241, 0x0000);
-VND_WR(12, 0xc242, 0x0002);
-VND_WR(12, 0xc243, 0x0080);
-VND_WR(12, 0xc244, 0x0012);
-VND_WR(12, 0xc245, 0x0090);
-VND_WR(12, 0xc246, 0x0000);
-//VND_RD(11, 0xc278, 0x0000, 0x08);
-//VND_WR(12, 0xc278, 0x0009);
-//VND_WR(12, 0xc278, 0x000d);
-//VND_WR(12, 0xc278, 0x002d);
-[self modifyIndex:0xc278 enable:1 << 0 | 1 << 2 | 1 << 5 disable:0];
-//VND_RD(11, 0xc279, 0x0000, 0x00);
-//VND_WR(12, 0xc279, 0x0002);
-//VND_WR(12, 0xc279, 0x000a);
-[self modifyIndex:0xc279 enable:1 << 1 | 1 << 3 disable:0];
-//VND_RD(11, 0xc27a, 0x0000, 0x30);
-//VND_WR(12, 0xc27a, 0x0030);
-//VND_WR(12, 0xc27a, 0x0030);
-//VND_WR(12, 0xc27a, 0x0032);
-//VND_WR(12, 0xc27a, 0x0032);
-[self modifyIndex:0xc27a enable:1 << 1 | 1 << 4 | 1 << 5 disable:0];
-//VND_RD(11, 0xf890, 0x0000, 0x0c);
-//VND_WR(12, 0xf890, 0x000c);
-[self modifyIndex:0xf890 enable:0 disable:1 << 7];
-//VND_RD(11, 0xf894, 0x0000, 0x87);
-//VND_WR(12, 0xf894, 0x0086);
-[self modifyIndex:0xf894 enable:1 << 7 | 1 << 1 disable:1 << 0];
-VND_WR(12, 0xc0ac, 0x00c0);
-VND_WR(12, 0xc0ad, 0x0000);
-VND_WR(12, 0xc0a2, 0x0012);
-VND_WR(12, 0xc0a3, 0x00e0);
-VND_WR(12, 0xc0a4, 0x0028);
-VND_WR(12, 0xc0a5, 0x0082);
-VND_WR(12, 0xc0a7, 0x0080);
-VND_WR(12, 0xc000, 0x0014);
-VND_WR(12, 0xc006, 0x0003);
-VND_WR(12, 0xc090, 0x0099);
-VND_WR(12, 0xc091, 0x0090);
-VND_WR(12, 0xc094, 0x0068);
-VND_WR(12, 0xc095, 0x0070);
-VND_WR(12, 0xc09c, 0x0030);
-VND_WR(12, 0xc09d, 0x00c0);
-VND_WR(12, 0xc09e, 0x00e0);
-VND_WR(12, 0xc019, 0x0006);
-VND_WR(12, 0xc08c, 0x00ba);
-VND_WR(12, 0xc101, 0x00ff);
-VND_WR(12, 0xc10c, 0x00b3);
-VND_WR(12, 0xc1b2, 0x0080);
-VND_WR(12, 0xc1b4, 0x00a0);
-VND_WR(12, 0xc14c, 0x00ff);
-VND_WR(12, 0xc14d, 0x00ca);
-VND_WR(12, 0xc113, 0x0053);
-VND_WR(12, 0xc119, 0x008a);
-VND_WR(12, 0xc13c, 0x0003);
-VND_WR(12, 0xc150, 0x009c);
-VND_WR(12, 0xc151, 0x0071);
-VND_WR(12, 0xc152, 0x00c6);
-VND_WR(12, 0xc153, 0x0084);
-VND_WR(12, 0xc154, 0x00bc);
-VND_WR(12, 0xc155, 0x00a0);
-VND_WR(12, 0xc156, 0x00a0);
-VND_WR(12, 0xc157, 0x009c);
-VND_WR(12, 0xc158, 0x001f);
-VND_WR(12, 0xc159, 0x0006);
-VND_WR(12, 0xc15d, 0x0000);
-//VND_RD(11, 0xc27d, 0x0000, 0x00);
-//VND_WR(12, 0xc27d, 0x0002);
-//VND_WR(12, 0xc27d, 0x0006);
-//VND_WR(12, 0xc27d, 0x0026);
-//VND_WR(12, 0xc27d, 0x0026);
-//VND_WR(12, 0xc27d, 0x00a6);
-[self modifyIndex:0xc27d enable:1 << 1 | 1 << 2 | 1 << 5 | 1 << 7 disable:0];
-VND_WR(12, 0xc280, 0x0011);
-VND_WR(12, 0xc281, 0x0040);
-VND_WR(12, 0xc282, 0x0011);
-VND_WR(12, 0xc283, 0x0040);
-//VND_RD(11, 0xf891, 0x0000, 0x10);
-//VND_WR(12, 0xf891, 0x0010);
-[self modifyIndex:0xf891 enable:0 disable:1 << 5];
-VND_RD(11, 0xc0ae, 0x0000, 0x10);
-VND_RD(11, 0xc284, 0x0000, 0xaa);
-VND_WR(12, 0xc105, 0x0060);
-VND_WR(12, 0xc11f, 0x00f2);
-VND_WR(12, 0xc127, 0x0060);
-VND_WR(12, 0xc0ae, 0x0010);
-VND_RD(11, 0xc0ae, 0x0000, 0x10);
-//VND_RD(11, 0xc284, 0x0000, 0xaa);
-//VND_WR(12, 0xc284, 0x0088);
-[self modifyIndex:0xc284 enable:0 disable:1 << 5 | 1 << 1];
-VND_WR(12, 0xc003, 0x0004);
+static ECVControlRequest const initRequests[] = {
+	VND_RD(2, 0x0000, 0x00a0, 0x01, 0x3a),
+	VND_RD(7, 0x003a, 0x00a0, 0x00, 0x6f),
+	VND_RD(7, 0x0000, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c),
+	VND_RD(7, 0x0020, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c),
+	VND_RD(7, 0x0040, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c),
+	VND_RD(7, 0x0060, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c),
+	VND_RD(7, 0x0080, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c),
+	VND_RD(7, 0x00a0, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c),
+	VND_RD(7, 0x00c0, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c),
+	VND_RD(7, 0x00e0, 0x00a2, 0x01, 0x6f, 0xd0, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c),
+	REG_WR(0xc008, 0x0001),
+	REG_WR(0xc1d0, 0x00ff),
+	REG_WR(0xc1d9, 0x0002),
+	REG_WR(0xc1da, 0x0013),
+	REG_WR(0xc1db, 0x0012),
+	REG_WR(0xc1e9, 0x0002),
+	REG_WR(0xc1ec, 0x006c),
+	REG_WR(0xc25b, 0x0030),
+	REG_WR(0xc254, 0x0073),
+	REG_WR(0xc294, 0x0020),
+	REG_WR(0xc255, 0x00cf),
+	REG_WR(0xc256, 0x0020),
+	REG_WR(0xc1eb, 0x0030),
+	REG_WR(0xc105, 0x0060),
+	REG_WR(0xc11f, 0x00f2),
+	REG_WR(0xc127, 0x0060),
+	REG_WR(0xc0ae, 0x0010),
+	REG_WR(0xc284, 0x00aa),
+	REG_WR(0xc003, 0x0004),
+	REG_WR(0xc01a, 0x0068),
+	REG_WR(0xc100, 0x00d3),
+	REG_WR(0xc10e, 0x0072),
+	REG_WR(0xc10f, 0x00a2),
+	REG_WR(0xc112, 0x00b0),
+	REG_WR(0xc115, 0x0015),
+	REG_WR(0xc117, 0x0001),
+	REG_WR(0xc118, 0x002c),
+	REG_WR(0xc12d, 0x0010),
+	REG_WR(0xc12f, 0x0020),
+	REG_WR(0xc220, 0x002e),
+	REG_WR(0xc225, 0x0008),
+	STROBE(0xc24e, 0x0002),
+	STROBE(0xc24f, 0x0002),
+	REG_WR(0xc254, 0x0059),
+	REG_WR(0xc25a, 0x0016),
+	REG_WR(0xc25b, 0x0035),
+	REG_WR(0xc263, 0x0017),
+	REG_WR(0xc266, 0x0016),
+	REG_WR(0xc267, 0x0036),
+	STROBE(0xc24e, 0x0002),
+	STROBE(0xc24f, 0x0002),
+	REG_WR(0xc239, 0x0040),
+	REG_WR(0xc240, 0x0000),
+	REG_WR(0xc241, 0x0000),
+	REG_WR(0xc242, 0x0002),
+	REG_WR(0xc243, 0x0080),
+	REG_WR(0xc244, 0x0012),
+	REG_WR(0xc245, 0x0090),
+	REG_WR(0xc246, 0x0000),
+	//VND_RD(11, 0xc278, 0x0000, 0x08);
+	//VND_WR(12, 0xc278, 0x0009);
+	//VND_WR(12, 0xc278, 0x000d);
+	//VND_WR(12, 0xc278, 0x002d);
+	MODIFY(0xc278, 1 << 0 | 1 << 2 | 1 << 5, 0),
+	//VND_RD(11, 0xc279, 0x0000, 0x00);
+	//VND_WR(12, 0xc279, 0x0002);
+	//VND_WR(12, 0xc279, 0x000a);
+	MODIFY(0xc279, 1 << 1 | 1 << 3, 0),
+	//VND_RD(11, 0xc27a, 0x0000, 0x30);
+	//VND_WR(12, 0xc27a, 0x0030);
+	//VND_WR(12, 0xc27a, 0x0030);
+	//VND_WR(12, 0xc27a, 0x0032);
+	//VND_WR(12, 0xc27a, 0x0032);
+	MODIFY(0xc27a, 1 << 1 | 1 << 4 | 1 << 5, 0),
+	//VND_RD(11, 0xf890, 0x0000, 0x0c);
+	//VND_WR(12, 0xf890, 0x000c);
+	MODIFY(0xf890, 0, 1 << 7),
+	//VND_RD(11, 0xf894, 0x0000, 0x87);
+	//VND_WR(12, 0xf894, 0x0086);
+	MODIFY(0xf894, 1 << 7 | 1 << 1, 1 << 0),
+	REG_WR(0xc0ac, 0x00c0),
+	REG_WR(0xc0ad, 0x0000),
+	REG_WR(0xc0a2, 0x0012),
+	REG_WR(0xc0a3, 0x00e0),
+	REG_WR(0xc0a4, 0x0028),
+	REG_WR(0xc0a5, 0x0082),
+	REG_WR(0xc0a7, 0x0080),
+	REG_WR(0xc000, 0x0014),
+	REG_WR(0xc006, 0x0003),
+	REG_WR(0xc090, 0x0099),
+	REG_WR(0xc091, 0x0090),
+	REG_WR(0xc094, 0x0068),
+	REG_WR(0xc095, 0x0070),
+	REG_WR(0xc09c, 0x0030),
+	REG_WR(0xc09d, 0x00c0),
+	REG_WR(0xc09e, 0x00e0),
+	REG_WR(0xc019, 0x0006),
+	REG_WR(0xc08c, 0x00ba),
+	REG_WR(0xc101, 0x00ff),
+	REG_WR(0xc10c, 0x00b3),
+	REG_WR(0xc1b2, 0x0080),
+	REG_WR(0xc1b4, 0x00a0),
+	REG_WR(0xc14c, 0x00ff),
+	REG_WR(0xc14d, 0x00ca),
+	REG_WR(0xc113, 0x0053),
+	REG_WR(0xc119, 0x008a),
+	REG_WR(0xc13c, 0x0003),
+	REG_WR(0xc150, 0x009c),
+	REG_WR(0xc151, 0x0071),
+	REG_WR(0xc152, 0x00c6),
+	REG_WR(0xc153, 0x0084),
+	REG_WR(0xc154, 0x00bc),
+	REG_WR(0xc155, 0x00a0),
+	REG_WR(0xc156, 0x00a0),
+	REG_WR(0xc157, 0x009c),
+	REG_WR(0xc158, 0x001f),
+	REG_WR(0xc159, 0x0006),
+	REG_WR(0xc15d, 0x0000),
+	//VND_RD(11, 0xc27d, 0x0000, 0x00);
+	//VND_WR(12, 0xc27d, 0x0002);
+	//VND_WR(12, 0xc27d, 0x0006);
+	//VND_WR(12, 0xc27d, 0x0026);
+	//VND_WR(12, 0xc27d, 0x0026);
+	//VND_WR(12, 0xc27d, 0x00a6);
+	MODIFY(0xc27d, 1 << 1 | 1 << 2 | 1 << 5 | 1 << 7, 0),
+	REG_WR(0xc280, 0x0011),
+	REG_WR(0xc281, 0x0040),
+	REG_WR(0xc282, 0x0011),
+	REG_WR(0xc283, 0x0040),
+	//VND_RD(11, 0xf891, 0x0000, 0x10);
+	//VND_WR(12, 0xf891, 0x0010);
+	MODIFY(0xf891, 0, 1 << 5),
+	VND_RD(11, 0xc0ae, 0x0000, 0x10),
+	VND_RD(11, 0xc284, 0x0000, 0xaa),
+	REG_WR(0xc105, 0x0060),
+	REG_WR(0xc11f, 0x00f2),
+	REG_WR(0xc127, 0x0060),
+	REG_WR(0xc0ae, 0x0010),
+	VND_RD(11, 0xc0ae, 0x0000, 0x10),
+	//VND_RD(11, 0xc284, 0x0000, 0xaa);
+	//VND_WR(12, 0xc284, 0x0088);
+	MODIFY(0xc284, 0, 1 << 5 | 1 << 1),
+	REG_WR(0xc003, 0x0004),
+};
+if(![self performControlRequests:initRequests count:numberof(initRequests)]) return;
 if([[self videoFormat] is60Hz]) { // 60Hz
-	VND_WR(12, 0xc01a, 0x0079);
-	VND_WR(12, 0xc100, 0x00d3);
-	VND_WR(12, 0xc10e, 0x0068);
-	VND_WR(12, 0xc10f, 0x009c);
-	VND_WR(12, 0xc112, 0x00f0);
-	VND_WR(12, 0xc115, 0x0015);
-	VND_WR(12, 0xc117, 0x0000);
-	VND_WR(12, 0xc118, 0x00fc);
-	VND_WR(12, 0xc12d, 0x0004);
-	VND_WR(12, 0xc12f, 0x0008);
-	VND_WR(12, 0xc220, 0x002e);
-	VND_WR(12, 0xc225, 0x0008);
-	VND_WR(12, 0xc24e, 0x0002);
-	VND_WR(12, 0xc24f, 0x0001);
-	VND_WR(12, 0xc254, 0x005f);
-	VND_WR(12, 0xc25a, 0x0012);
-	VND_WR(12, 0xc25b, 0x0001);
-	VND_WR(12, 0xc263, 0x001c);
-	VND_WR(12, 0xc266, 0x0011);
-	VND_WR(12, 0xc267, 0x0005);
-	VND_WR(12, 0xc24e, 0x0002);
-	VND_WR(12, 0xc24f, 0x0002);
-	VND_WR(12, 0xc16f, 0x00b8);
+	static ECVControlRequest const requests60Hz[] = {
+		REG_WR(0xc01a, 0x0079),
+		REG_WR(0xc100, 0x00d3),
+		REG_WR(0xc10e, 0x0068),
+		REG_WR(0xc10f, 0x009c),
+		REG_WR(0xc112, 0x00f0),
+		REG_WR(0xc115, 0x0015),
+		REG_WR(0xc117, 0x0000),
+		REG_WR(0xc118, 0x00fc),
+		REG_WR(0xc12d, 0x0004),
+		REG_WR(0xc12f, 0x0008),
+		REG_WR(0xc220, 0x002e),
+		REG_WR(0xc225, 0x0008),
+		STROBE(0xc24e, 0x0002),
+		STROBE(0xc24f, 0x0001),
+		REG_WR(0xc254, 0x005f),
+		REG_WR(0xc25a, 0x0012),
+		REG_WR(0xc25b, 0x0001),
+		REG_WR(0xc263, 0x001c),
+		REG_WR(0xc266, 0x0011),
+		REG_WR(0xc267, 0x0005),
+		STROBE(0xc24e, 0x0002),
+		STROBE(0xc24f, 0x0002),
+		REG_WR(0xc16f, 0x00b8),
+	};
+	if(![self performControlRequests:requests60Hz count:numberof(requests60Hz)]) return;
 	// 0x00b8 = NTSC-M?
 	// 0x00bc = PAL-60?
 } else { // 50Hz
-	VND_WR(12, 0xc01a, 0x0068);
-	VND_WR(12, 0xc100, 0x00d3);
-	VND_WR(12, 0xc10e, 0x0072);
-	VND_WR(12, 0xc10f, 0x00a2);
-	VND_WR(12, 0xc112, 0x00b0);
-	VND_WR(12, 0xc115, 0x0015);
-	VND_WR(12, 0xc117, 0x0001);
-	VND_WR(12, 0xc118, 0x002c);
-	VND_WR(12, 0xc12d, 0x0010);
-	VND_WR(12, 0xc12f, 0x0020);
-	VND_WR(12, 0xc220, 0x002e);
-	VND_WR(12, 0xc225, 0x0008);
-	VND_WR(12, 0xc24e, 0x0002);
-	VND_WR(12, 0xc24f, 0x0002);
-	VND_WR(12, 0xc254, 0x0059);
-	VND_WR(12, 0xc25a, 0x0016);
-	VND_WR(12, 0xc25b, 0x0035);
-	VND_WR(12, 0xc263, 0x0017);
-	VND_WR(12, 0xc266, 0x0016);
-	VND_WR(12, 0xc267, 0x0036);
-	VND_WR(12, 0xc24e, 0x0002);
-	VND_WR(12, 0xc24f, 0x0002);
-	VND_WR(12, 0xc16f, 0x00ee);
+	static ECVControlRequest const requests50Hz[] = {
+		REG_WR(0xc01a, 0x0068),
+		REG_WR(0xc100, 0x00d3),
+		REG_WR(0xc10e, 0x0072),
+		REG_WR(0xc10f, 0x00a2),
+		REG_WR(0xc112, 0x00b0),
+		REG_WR(0xc115, 0x0015),
+		REG_WR(0xc117, 0x0001),
+		REG_WR(0xc118, 0x002c),
+		REG_WR(0xc12d, 0x0010),
+		REG_WR(0xc12f, 0x0020),
+		REG_WR(0xc220, 0x002e),
+		REG_WR(0xc225, 0x0008),
+		STROBE(0xc24e, 0x0002),
+		STROBE(0xc24f, 0x0002),
+		REG_WR(0xc254, 0x0059),
+		REG_WR(0xc25a, 0x0016),
+		REG_WR(0xc25b, 0x0035),
+		REG_WR(0xc263, 0x0017),
+		REG_WR(0xc266, 0x0016),
+		REG_WR(0xc267, 0x0036),
+		STROBE(0xc24e, 0x0002),
+		STROBE(0xc24f, 0x0002),
+		REG_WR(0xc16f, 0x00ee),
+	};
+	if(![self performControlRequests:requests50Hz count:numberof(requests50Hz)]) return;
 }
-VND_RD(11, 0xc0ae, 0x0000, 0x10);
-VND_RD(11, 0xc244, 0x0000, 0x12);
-VND_RD(11, 0xc246, 0x0000, 0x00);
-VND_RD(11, 0xc244, 0x0000, 0x12);
-VND_RD(11, 0xc245, 0x0000, 0x90);
-VND_RD(11, 0xc242, 0x0000, 0x02);
-VND_RD(11, 0xc243, 0x0000, 0x80);
-VND_RD(11, 0xc240, 0x0000, 0x00);
-VND_RD(11, 0xc241, 0x0000, 0x00);
-VND_RD(11, 0xc239, 0x0000, 0x40);
-VND_RD(11, 0xc244, 0x0000, 0x12);
-VND_RD(11, 0xc246, 0x0000, 0x00);
-VND_RD(11, 0xc244, 0x0000, 0x12);
-VND_RD(11, 0xc245, 0x0000, 0x90);
-VND_WR(11, 0xc244, 0x0000);
-VND_RD(11, 0xc244, 0x0000, 0x11);
-VND_RD(11, 0xc245, 0x0000, 0x90);
-VND_RD(11, 0xc244, 0x0000, 0x11);
-VND_WR(11, 0xc244, 0x0000);
-VND_RD(11, 0xc242, 0x0000, 0x02);
-VND_RD(11, 0xc243, 0x0000, 0x80);
-VND_WR(11, 0xc242, 0x0000);
-VND_RD(11, 0xc240, 0x0000, 0x00);
-VND_RD(11, 0xc241, 0x0000, 0x00);
-VND_WR(11, 0xc240, 0x0000);
-//VND_RD(11, 0xc239, 0x0000, 0x40);
-//VND_WR(12, 0xc239, 0x0060);
-[self modifyIndex:0xc239 enable:1 << 1 disable:0 << 1]; // Related to PAL-60? (And below)
+static ECVControlRequest const formatRequests[] = {
+	VND_RD(11, 0xc0ae, 0x0000, 0x10),
+	VND_RD(11, 0xc244, 0x0000, 0x12),
+	VND_RD(11, 0xc246, 0x0000, 0x00),
+	VND_RD(11, 0xc244, 0x0000, 0x12),
+	VND_RD(11, 0xc245, 0x0000, 0x90),
+	VND_RD(11, 0xc242, 0x0000, 0x02),
+	VND_RD(11, 0xc243, 0x0000, 0x80),
+	VND_RD(11, 0xc240, 0x0000, 0x00),
+	VND_RD(11, 0xc241, 0x0000, 0x00),
+	VND_RD(11, 0xc239, 0x0000, 0x40),
+	VND_RD(11, 0xc244, 0x0000, 0x12),
+	VND_RD(11, 0xc246, 0x0000, 0x00),
+	VND_RD(11, 0xc244, 0x0000, 0x12),
+	VND_RD(11, 0xc245, 0x0000, 0x90),
+	VND_WR(11, 0xc244, 0x0000),
+	VND_RD(11, 0xc244, 0x0000, 0x11),
+	VND_RD(11, 0xc245, 0x0000, 0x90),
+	VND_RD(11, 0xc244, 0x0000, 0x11),
+	VND_WR(11, 0xc244, 0x0000),
+	VND_RD(11, 0xc242, 0x0000, 0x02),
+	VND_RD(11, 0xc243, 0x0000, 0x80),
+	VND_WR(11, 0xc242, 0x0000),
+	VND_RD(11, 0xc240, 0x0000, 0x00),
+	VND_RD(11, 0xc241, 0x0000, 0x00),
+	VND_WR(11, 0xc240, 0x0000),
+	//VND_RD(11, 0xc239, 0x0000, 0x40);
+	//VND_WR(12, 0xc239, 0x0060);
+	MODIFY(0xc239, 1 << 1, 0 << 1), // Related to PAL-60? (And below)
+};
+if(![self performControlRequests:formatRequests count:numberof(formatRequests)]) return;
 [self setAlternateInterface:1];
 CTRL(0, USBmakebmRequestType(kUSBOut, kUSBStandard, kUSBEndpoint), kUSBRqClearFeature, 0, 0);
 if([[self videoSource] SVideo]) {
-	VND_WR(12, 0xc105, 0x0010);
-	VND_WR(12, 0xc11f, 0x00ff);
-	VND_WR(12, 0xc127, 0x0060);
-	VND_WR(12, 0xc0ae, 0x0030);
-	VND_WR(12, 0xc284, 0x0088);
+	static ECVControlRequest const SVideoRequests[] = {
+		REG_WR(0xc105, 0x0010),
+		REG_WR(0xc11f, 0x00ff),
+		REG_WR(0xc127, 0x0060),
+		REG_WR(0xc0ae, 0x0030),
+		REG_WR(0xc284, 0x0088),
+	};
+	if(![self performControlRequests:SVideoRequests count:numberof(SVideoRequests)]) return;
 } else { // Composite
-	VND_WR(12, 0xc105, 0x0060);
-	VND_WR(12, 0xc11f, 0x00f2);
-	VND_WR(12, 0xc127, 0x0060);
-	VND_WR(12, 0xc0ae, 0x0010);
-	VND_WR(12, 0xc284, 0x00aa);
-	VND_WR(12, 0xc105, 0x0060);
-	VND_WR(12, 0xc11f, 0x00f2);
-	VND_WR(12, 0xc127, 0x0060);
-	VND_WR(12, 0xc0ae, 0x0010);
-	VND_WR(12, 0xc284, 0x00aa);
+	static ECVControlRequest const compositeRequests[] = {
+		REG_WR(0xc105, 0x0060),
+		REG_WR(0xc11f, 0x00f2),
+		REG_WR(0xc127, 0x0060),
+		REG_WR(0xc0ae, 0x0010),
+		REG_WR(0xc284, 0x00aa),
+		REG_WR(0xc105, 0x0060),
+		REG_WR(0xc11f, 0x00f2),
+		REG_WR(0xc127, 0x0060),
+		REG_WR(0xc0ae, 0x0010),
+		REG_WR(0xc284, 0x00aa),
+	};
+	if(![self performControlRequests:compositeRequests count:numberof(compositeRequests)]) return;
 }
-VND_RD(11, 0xc244, 0x0000, 0x11);
-VND_RD(11, 0xc246, 0x0000, 0xd0);
-VND_RD(11, 0xc244, 0x0000, 0x11);
-VND_RD(11, 0xc245, 0x0000, 0xc0);
-VND_RD(11, 0xc242, 0x0000, 0x02);
-VND_RD(11, 0xc243, 0x0000, 0x00);
-VND_RD(11, 0xc240, 0x0000, 0x82);
-VND_RD(11, 0xc241, 0x0000, 0x00);
-VND_RD(11, 0xc239, 0x0000, 0x60);
-VND_RD(11, 0xc244, 0x0000, 0x11);
-VND_RD(11, 0xc246, 0x0000, 0xd0);
-VND_RD(11, 0xc244, 0x0000, 0x11);
-VND_RD(11, 0xc245, 0x0000, 0xc0);
-VND_WR(11, 0xc244, 0x0000);
-VND_RD(11, 0xc244, 0x0000, 0x11);
-VND_RD(11, 0xc245, 0x0000, 0xc0);
-VND_RD(11, 0xc244, 0x0000, 0x11);
-VND_WR(11, 0xc244, 0x0000);
-VND_RD(11, 0xc242, 0x0000, 0x02);
-VND_RD(11, 0xc243, 0x0000, 0x00);
-VND_WR(11, 0xc242, 0x0000);
-VND_RD(11, 0xc240, 0x0000, 0x82);
-VND_RD(11, 0xc241, 0x0000, 0x00);
-VND_WR(11, 0xc240, 0x0000);
-//VND_RD(11, 0xc239, 0x0000, 0x60);
-//VND_WR(12, 0xc239, 0x0060);
-[self modifyIndex:0xc239 enable:1 << 1 disable:0 << 1];
-
-[self setBrightness:_brightness];
-[self setContrast:_contrast];
-[self setSaturation:_saturation];
-[self setHue:_hue];
+static ECVControlRequest const sourceRequests[] = {
+	VND_RD(11, 0xc244, 0x0000, 0x11),
+	VND_RD(11, 0xc246, 0x0000, 0xd0),
+	VND_RD(11, 0xc244, 0x0000, 0x11),
+	VND_RD(11, 0xc245, 0x0000, 0xc0),
+	VND_RD(11, 0xc242, 0x0000, 0x02),
+	VND_RD(11, 0xc243, 0x0000, 0x00),
+	VND_RD(11, 0xc240, 0x0000, 0x82),
+	VND_RD(11, 0xc241, 0x0000, 0x00),
+	VND_RD(11, 0xc239, 0x0000, 0x60),
+	VND_RD(11, 0xc244, 0x0000, 0x11),
+	VND_RD(11, 0xc246, 0x0000, 0xd0),
+	VND_RD(11, 0xc244, 0x0000, 0x11),
+	VND_RD(11, 0xc245, 0x0000, 0xc0),
+	VND_WR(11, 0xc244, 0x0000),
+	VND_RD(11, 0xc244, 0x0000, 0x11),
+	VND_RD(11, 0xc245, 0x0000, 0xc0),
+	VND_RD(11, 0xc244, 0x0000, 0x11),
+	VND_WR(11, 0xc244, 0x0000),
+	VND_RD(11, 0xc242, 0x0000, 0x02),
+	VND_RD(11, 0xc243, 0x0000, 0x00),
+	VND_WR(11, 0xc242, 0x0000),
+	VND_RD(11, 0xc240, 0x0000, 0x82),
+	VND_RD(11, 0xc241, 0x0000, 0x00),
+	VND_WR(11, 0xc240, 0x0000),
+	//VND_RD(11, 0xc239, 0x0000, 0x60);
+	//VND_WR(12, 0xc239, 0x0060);
+	MODIFY(0xc239, 1 << 1, 0 << 1),
+};
+if(![self performControlRequests:sourceRequests count:numberof(sourceRequests)]) return;
+
+[self lockControlRequests];
+memset(_pictureControlWritten, NO, sizeof(_pictureControlWritten)); // The device was just reset.
+[self unlockControlRequests];
+(void)[self writeValue:ECVFushicaiBrightnessAndContrastValue(_brightness, _contrast) forPictureControl:ECVFushicaiBrightnessAndContrastIndex];
+(void)[self writeValue:ECVFushicaiSaturationValue(_saturation) forPictureControl:ECVFushicaiSaturationIndex];
+(void)[self writeValue:ECVFushicaiHueValue(_hue) forPictureControl:ECVFushicaiHueIndex];
+
+_offset = 0;
+_packetIndex = NSNotFound;
+NSUInteger const bytesPerRow = ECVPixelFormatBytesPerPixel([self pixelFormat]) * 720;
+[_fieldHistory release]; // In case an earlier -read bailed out early.
+_fieldHistory = [[ECVFieldHistory alloc] initWithFieldLength:bytesPerRow * [[self videoFormat] frameSize].height bytesPerRow:bytesPerRow pixelFormat:[self pixelFormat]];
 
 [super read];
 [self setAlternateInterface:0];
+
+[_fieldHistory release];
+_fieldHistory = nil;
 }
 
 #pragma mark -ECVCaptureDevice(ECVReadAbstract_Thread)
@@ -451,6 +531,19 @@ VND_WR(11, 0xc240, 0x0000);
 	return k2vuyPixelFormat;
 }
 
+#pragma mark -ECVCaptureDevice(ECVRegisterAbstract)
+
+- (ECVControlRequest)requestForReadingRegister:(UInt16 const)idx
+{
+	ECVControlRequest const request = {ECVControlRead, 11, 0, idx, 1};
+	return request;
+}
+- (ECVControlRequest)requestForWritingRegister:(UInt16 const)idx value:(UInt8 const)value
+{
+	ECVControlRequest const request = {ECVControlWrite, 12, value, idx, 0};
+	return request;
+}
+
 #pragma mark -ECVCaptureDevice<ECVCaptureDeviceConfiguring>
 
 - (CGFloat)brightness
@@ -460,7 +553,7 @@ VND_WR(11, 0xc240, 0x0000);
 - (void)setBrightness:(CGFloat const)val
 {
 	_brightness = val;
-	[self writeBrightnessAndContrast];
+	[_controlQueue setValue:ECVFushicaiBrightnessAndContrastValue(_brightness, _contrast) forControl:ECVFushicaiBrightnessAndContrastIndex];
 	[[NSUserDefaults standardUserDefaults] setObject:[NSNumber numberWithDouble:val] forKey:ECVBrightnessKey];
 }
 - (CGFloat)contrast
@@ -470,7 +563,7 @@ VND_WR(11, 0xc240, 0x0000);
 - (void)setContrast:(CGFloat const)val
 {
 	_contrast = val;
-	[self writeBrightnessAndContrast];
+	[_controlQueue setValue:ECVFushicaiBrightnessAndContrastValue(_brightness, _contrast) forControl:ECVFushicaiBrightnessAndContrastIndex];
 	[[NSUserDefaults standardUserDefaults] setObject:[NSNumber numberWithDouble:val] forKey:ECVContrastKey];
 }
 - (CGFloat)saturation
@@ -480,8 +573,7 @@ VND_WR(11, 0xc240, 0x0000);
 - (void)setSaturation:(CGFloat const)val
 {
 	_saturation = val;
-	uint16_t x = CFSwapInt16HostToBig(round(val * 0x3ff));
-	[self writeRequest:11 value:0 index:0xc242 length:sizeof(x) data:&x];
+	[_controlQueue setValue:ECVFushicaiSaturationValue(_saturation) forControl:ECVFushicaiSaturationIndex];
 	[[NSUserDefaults standardUserDefaults] setObject:[NSNumber numberWithDouble:val] forKey:ECVSaturationKey];
 }
 - (CGFloat)hue
@@ -491,12 +583,25 @@ VND_WR(11, 0xc240, 0x0000);
 - (void)setHue:(CGFloat const)val
 {
 	_hue = val;
-	uint16_t x = round(val * (0xdff*2));
-	if(x <= 0xdff) x = 0x8fff - x;
-	else x = 0x9200 - 0xdff + x;
-	x = CFSwapInt16HostToBig(x);
-	[self writeRequest:11 value:0 index:0xc240 length:sizeof(x) data:&x];
+	[_controlQueue setValue:ECVFushicaiHueValue(_hue) forControl:ECVFushicaiHueIndex];
 	[[NSUserDefaults standardUserDefaults] setObject:[NSNumber numberWithDouble:val] forKey:ECVHueKey];
 }
 
+#pragma mark -<ECVControlQueueDelegate>
+
+- (BOOL)controlQueue:(ECVControlQueue *const)queue writeValue:(NSInteger const)value forControl:(NSUInteger const)control
+{
+	return [self writeValue:value forPictureControl:control];
+}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	[_controlQueue invalidate];
+	[_controlQueue release];
+	[_fieldHistory release];
+	[super dealloc];
+}
+
 @end
@@ -0,0 +1,83 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import <CoreAudio/CoreAudioTypes.h>
+
+// Models
+@class ECVVideoStorage;
+@class ECVVideoFrame;
+
+#define ECVHistoryBufferMaxPendingFrames 8
+#define ECVHistoryBufferReplayWaitInterval 0.05 // Longest the replay thread waits on a busy recipient before checking whether to stop.
+#define ECVHistoryBufferMaxReplayBacklog 2.0 // Multiple of the duration a replay can fall behind before frames it hasn't reached yet are dropped.
+
+@protocol ECVHistoryBufferRecipient <NSObject>
+
+- (void)addVideoFrame:(ECVVideoFrame *const)frame;
+- (void)addAudioBufferList:(AudioBufferList const *const)bufferList presentationTime:(NSTimeInterval const)time;
+- (BOOL)waitUntilReadyForMoreVideoFramesBeforeDate:(NSDate *const)date; // Replayed frames are held back until this returns YES, so catching up doesn't overflow the recipient's queue.
+
+@end
+
+// Keeps the last few seconds of video and audio so recordings can start in the past. Frames are copied out of the video storage on a background queue, lossless-compressed if possible, so they don't pin storage buffers.
+@interface ECVHistoryBuffer : NSObject
+{
+	@private
+	NSTimeInterval _duration;
+	BOOL _compresses;
+	dispatch_queue_t _queue;
+	NSCondition *_lock; // Broadcast when a frame is added or replaying should stop.
+	ECVVideoStorage *_videoStorage;
+	NSMutableArray *_videoFrames;
+	NSMutableArray *_audioBuffers;
+	NSUInteger _pendingFrameCount;
+	NSUInteger _droppedFrameCount;
+	NSUInteger _skippedFrameCount;
+	unsigned long long _byteCount;
+
+	NSConditionLock *_replayLock;
+	NSObject<ECVHistoryBufferRecipient> *_recipient;
+	NSUInteger _videoIndex; // Next frame to replay.
+	NSUInteger _audioIndex;
+	BOOL _caughtUp;
+	BOOL _stopReplaying;
+}
+
+- (id)initWithDuration:(NSTimeInterval const)duration compresses:(BOOL const)flag;
+- (NSTimeInterval)duration;
+- (BOOL)compresses;
+
+- (void)addVideoFrame:(ECVVideoFrame *const)frame; // Never blocks. Frames are dropped if too many are pending.
+- (void)addAudioBufferList:(AudioBufferList const *const)bufferList presentationTime:(NSTimeInterval const)time;
+- (void)empty;
+
+- (void)startReplayingToRecipient:(NSObject<ECVHistoryBufferRecipient> *const)recipient; // Passes on everything held as fast as the recipient takes it, then live frames once it has caught up.
+- (void)stopReplaying; // Blocks until the replay thread exits. Anything not yet replayed is skipped.
+- (BOOL)isCaughtUp;
+
+// These can be polled at any time.
+- (NSTimeInterval)heldDuration;
+- (unsigned long long)byteCount;
+- (double)bytesPerSecond; // Memory cost of each second of history.
+- (NSUInteger)droppedFrameCount;
+- (NSUInteger)skippedFrameCount; // Never replayed because the recipient fell too far behind.
+
+@end
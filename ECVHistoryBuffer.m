@@ -0,0 +1,483 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVHistoryBuffer.h"
+#import <stddef.h>
+
+// Models
+#import "ECVVideoStorage.h"
+#import "ECVVideoFrame.h"
+#import "ECVPixelBuffer.h"
+
+// Other Sources
+#import "ECVDebug.h"
+#import "ECVFoundationAdditions.h"
+#import "ECVLosslessCodec.h"
+
+enum {
+	ECVHistoryNotReplaying,
+	ECVHistoryReplaying,
+};
+
+@interface ECVHistoryFrame : ECVVideoFrame
+{
+	@private
+	NSData *_data;
+	BOOL _compressed;
+	NSMutableData *_decodedData;
+	NSUInteger _lockCount;
+}
+
+- (id)initWithVideoFrame:(ECVVideoFrame *const)frame compresses:(BOOL const)flag;
+- (id)initWithHistoryFrame:(ECVHistoryFrame *const)frame; // Shares the stored data, but decodes into its own buffer.
+- (NSUInteger)length;
+
+@end
+
+@interface ECVHistoryAudioBuffer : NSObject
+{
+	@private
+	NSMutableData *_data;
+	NSTimeInterval _presentationTime;
+}
+
+- (id)initWithBufferList:(AudioBufferList const *const)bufferList presentationTime:(NSTimeInterval const)time;
+- (AudioBufferList const *)bufferList;
+- (NSTimeInterval)presentationTime;
+- (NSUInteger)length;
+
+@end
+
+@interface ECVHistoryBuffer(Private)
+
+- (void)_addHistoryFrame:(ECVHistoryFrame *const)frame;
+- (void)_trim;
+- (void)_thread_replay:(id const)arg;
+
+@end
+
+@implementation ECVHistoryBuffer
+
+#pragma mark -ECVHistoryBuffer
+
+- (id)initWithDuration:(NSTimeInterval const)duration compresses:(BOOL const)flag
+{
+	if((self = [super init])) {
+		_duration = duration;
+		_compresses = flag;
+		_queue = dispatch_queue_create("ECVHistoryBuffer", NULL);
+		_lock = [[NSCondition alloc] init];
+		_videoFrames = [[NSMutableArray alloc] init];
+		_audioBuffers = [[NSMutableArray alloc] init];
+		_replayLock = [[NSConditionLock alloc] initWithCondition:ECVHistoryNotReplaying];
+	}
+	return self;
+}
+- (NSTimeInterval)duration
+{
+	return _duration;
+}
+- (BOOL)compresses
+{
+	return _compresses;
+}
+
+#pragma mark -
+
+- (void)addVideoFrame:(ECVVideoFrame *const)frame
+{
+	[_lock lock];
+	NSObject<ECVHistoryBufferRecipient> *const recipient = _caughtUp ? [_recipient retain] : nil;
+	BOOL const accepted = _pendingFrameCount < ECVHistoryBufferMaxPendingFrames;
+	if(accepted) _pendingFrameCount++;
+	else _droppedFrameCount++;
+	[_lock unlock];
+	[recipient addVideoFrame:frame]; // Outside the lock, so a slow recipient doesn't hold up the replay thread or the audio.
+	[recipient release];
+	if(!accepted) return;
+	NSTimeInterval const time = [frame presentationTime] ?: [NSDate ECV_timeIntervalSinceReferenceDate];
+	dispatch_async(_queue, ^{
+		NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+		ECVVideoStorage *const storage = [frame videoStorage];
+		if(storage != _videoStorage) {
+			// Old frames keep their storage alive, but shouldn't be mixed with the new format.
+			[self empty];
+			[_videoStorage release];
+			_videoStorage = [storage retain];
+		}
+		ECVHistoryFrame *const historyFrame = [[[ECVHistoryFrame alloc] initWithVideoFrame:frame compresses:_compresses] autorelease];
+		[historyFrame setPresentationTime:time];
+		[self _addHistoryFrame:historyFrame];
+		[pool release];
+	});
+}
+- (void)addAudioBufferList:(AudioBufferList const *const)bufferList presentationTime:(NSTimeInterval const)time
+{
+	ECVHistoryAudioBuffer *const buffer = [[ECVHistoryAudioBuffer alloc] initWithBufferList:bufferList presentationTime:time];
+	[_lock lock];
+	NSObject<ECVHistoryBufferRecipient> *const recipient = _caughtUp ? [_recipient retain] : nil;
+	[_audioBuffers addObject:buffer];
+	_byteCount += [buffer length];
+	[_lock unlock];
+	[recipient addAudioBufferList:bufferList presentationTime:time];
+	[recipient release];
+	[buffer release];
+}
+- (void)empty
+{
+	[_lock lock];
+	if(_recipient && !_caughtUp) {
+		// Keep whatever hasn't been replayed yet, so the recording doesn't lose its start. The indices still point at the next item.
+		NSUInteger i = 0;
+		for(; i < _videoIndex; i++) _byteCount -= [[_videoFrames objectAtIndex:i] length];
+		for(i = 0; i < _audioIndex; i++) _byteCount -= [[_audioBuffers objectAtIndex:i] length];
+		[_videoFrames removeObjectsInRange:NSMakeRange(0, _videoIndex)];
+		[_audioBuffers removeObjectsInRange:NSMakeRange(0, _audioIndex)];
+	} else {
+		[_videoFrames removeAllObjects];
+		[_audioBuffers removeAllObjects];
+		_byteCount = 0;
+	}
+	_videoIndex = 0;
+	_audioIndex = 0;
+	[_lock unlock];
+}
+
+#pragma mark -
+
+- (void)startReplayingToRecipient:(NSObject<ECVHistoryBufferRecipient> *const)recipient
+{
+	NSParameterAssert(recipient);
+	[self stopReplaying];
+	[_lock lock];
+	_recipient = [recipient retain];
+	_videoIndex = 0;
+	_audioIndex = 0;
+	_caughtUp = NO;
+	_stopReplaying = NO;
+	[_lock unlock];
+	ECVLog(ECVNotice, @"Replaying %.1f s of history (%.1f MB, %.2f MB per second).", [self heldDuration], [self byteCount] / 1.0e6, [self bytesPerSecond] / 1.0e6);
+	[_replayLock lock];
+	[_replayLock unlockWithCondition:ECVHistoryReplaying];
+	[NSThread detachNewThreadSelector:@selector(_thread_replay:) toTarget:self withObject:nil];
+}
+- (void)stopReplaying
+{
+	[_lock lock];
+	_stopReplaying = YES;
+	[_lock broadcast];
+	[_lock unlock];
+	[_replayLock lockWhenCondition:ECVHistoryNotReplaying];
+	[_replayLock unlock];
+	[_lock lock];
+	[_recipient release];
+	_recipient = nil;
+	_caughtUp = NO;
+	[_lock unlock];
+}
+- (BOOL)isCaughtUp
+{
+	[_lock lock];
+	BOOL const caughtUp = _caughtUp;
+	[_lock unlock];
+	return caughtUp;
+}
+
+#pragma mark -
+
+- (NSTimeInterval)heldDuration
+{
+	[_lock lock];
+	NSTimeInterval const duration = [_videoFrames count] > 1 ? [[_videoFrames lastObject] presentationTime] - [[_videoFrames objectAtIndex:0] presentationTime] : 0.0;
+	[_lock unlock];
+	return duration;
+}
+- (unsigned long long)byteCount
+{
+	[_lock lock];
+	unsigned long long const count = _byteCount;
+	[_lock unlock];
+	return count;
+}
+- (double)bytesPerSecond
+{
+	NSTimeInterval const duration = [self heldDuration];
+	return duration > 0.0 ? [self byteCount] / duration : 0.0;
+}
+- (NSUInteger)droppedFrameCount
+{
+	[_lock lock];
+	NSUInteger const count = _droppedFrameCount;
+	[_lock unlock];
+	return count;
+}
+- (NSUInteger)skippedFrameCount
+{
+	[_lock lock];
+	NSUInteger const count = _skippedFrameCount;
+	[_lock unlock];
+	return count;
+}
+
+#pragma mark -ECVHistoryBuffer(Private)
+
+- (void)_addHistoryFrame:(ECVHistoryFrame *const)frame
+{
+	[_lock lock];
+	_pendingFrameCount--;
+	if(frame) {
+		[_videoFrames addObject:frame];
+		_byteCount += [frame length];
+		[self _trim];
+	}
+	[_lock broadcast];
+	[_lock unlock];
+}
+- (void)_trim
+{
+	NSTimeInterval const latestTime = [[_videoFrames lastObject] presentationTime];
+	NSTimeInterval const cutoff = latestTime - _duration;
+	NSTimeInterval const backlogCutoff = latestTime - _duration * ECVHistoryBufferMaxReplayBacklog; // Past this, a slow recipient loses the oldest frames instead of the history growing without bound.
+	BOOL const replaying = _recipient && !_caughtUp;
+	while([_videoFrames count] && [[_videoFrames objectAtIndex:0] presentationTime] < cutoff) {
+		if(_videoIndex) _videoIndex--;
+		else if(replaying) {
+			if([[_videoFrames objectAtIndex:0] presentationTime] >= backlogCutoff) break; // Still waiting to be replayed.
+			_skippedFrameCount++;
+		}
+		_byteCount -= [[_videoFrames objectAtIndex:0] length];
+		[_videoFrames removeObjectAtIndex:0];
+	}
+	while([_audioBuffers count] && [[_audioBuffers objectAtIndex:0] presentationTime] < cutoff) {
+		if(_audioIndex) _audioIndex--;
+		else if(replaying && [[_audioBuffers objectAtIndex:0] presentationTime] >= backlogCutoff) break;
+		_byteCount -= [[_audioBuffers objectAtIndex:0] length];
+		[_audioBuffers removeObjectAtIndex:0];
+	}
+}
+- (void)_thread_replay:(id const)arg
+{
+	NSAutoreleasePool *const outerPool = [[NSAutoreleasePool alloc] init];
+	NSTimeInterval const startTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+	[_lock lock];
+	NSObject<ECVHistoryBufferRecipient> *const recipient = [[_recipient retain] autorelease]; // Only replaced once this thread exits.
+	[_lock unlock];
+	NSUInteger const skippedFrameCount = [self skippedFrameCount];
+	NSUInteger replayedFrameCount = 0;
+	BOOL caughtUp = NO;
+
+	for(;;) {
+		NSAutoreleasePool *const innerPool = [[NSAutoreleasePool alloc] init];
+		BOOL const ready = [recipient waitUntilReadyForMoreVideoFramesBeforeDate:[NSDate dateWithTimeIntervalSinceNow:ECVHistoryBufferReplayWaitInterval]];
+
+		[_lock lock];
+		while(!_stopReplaying && _videoIndex >= [_videoFrames count] && _pendingFrameCount) [_lock wait]; // Frames are still being copied in.
+		if(_stopReplaying) {
+			[_lock unlock];
+			[innerPool release];
+			break;
+		}
+		ECVHistoryFrame *const nextFrame = _videoIndex < [_videoFrames count] ? [_videoFrames objectAtIndex:_videoIndex] : nil;
+		NSMutableArray *const audioBuffers = [NSMutableArray array];
+		for(; _audioIndex < [_audioBuffers count]; _audioIndex++) {
+			ECVHistoryAudioBuffer *const buffer = [_audioBuffers objectAtIndex:_audioIndex];
+			if(nextFrame && [buffer presentationTime] > [nextFrame presentationTime]) break;
+			[audioBuffers addObject:buffer];
+		}
+		if(!nextFrame && ![audioBuffers count]) {
+			_caughtUp = YES; // From here on, -addVideoFrame: and -addAudioBufferList:... pass everything straight through.
+			caughtUp = YES;
+			[_lock unlock];
+			[innerPool release];
+			break;
+		}
+		ECVHistoryFrame *const frame = ready && nextFrame ? [[[ECVHistoryFrame alloc] initWithHistoryFrame:nextFrame] autorelease] : nil; // The recipient's copy holds its decoded pixels for as long as the recipient keeps it.
+		if(frame) _videoIndex++; // Taken under the lock, so trimming and emptying keep the index right while we're sending it.
+		[_lock unlock];
+
+		// Sent outside the lock, so live frames can still be queued and trimmed meanwhile.
+		for(ECVHistoryAudioBuffer *const buffer in audioBuffers) [recipient addAudioBufferList:[buffer bufferList] presentationTime:[buffer presentationTime]];
+		if(frame) {
+			[recipient addVideoFrame:frame];
+			replayedFrameCount++;
+		}
+		[innerPool release];
+	}
+
+	NSTimeInterval const replayTime = [NSDate ECV_timeIntervalSinceReferenceDate] - startTime;
+	NSUInteger const newlySkippedFrameCount = [self skippedFrameCount] - skippedFrameCount;
+	if(caughtUp) ECVLog(ECVNotice, @"History caught up after %.2f s (%lu frames replayed, %lu skipped).", replayTime, (unsigned long)replayedFrameCount, (unsigned long)newlySkippedFrameCount);
+	else ECVLog(ECVNotice, @"History replay stopped after %.2f s (%lu frames replayed, %lu skipped).", replayTime, (unsigned long)replayedFrameCount, (unsigned long)newlySkippedFrameCount);
+
+	[_replayLock lock];
+	[_replayLock unlockWithCondition:ECVHistoryNotReplaying];
+	[outerPool release];
+}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	[self stopReplaying];
+	if(_queue) dispatch_release(_queue);
+	[_lock release];
+	[_videoStorage release];
+	[_videoFrames release];
+	[_audioBuffers release];
+	[_replayLock release];
+	[super dealloc];
+}
+
+@end
+
+@implementation ECVHistoryFrame
+
+#pragma mark -ECVHistoryFrame
+
+- (id)initWithVideoFrame:(ECVVideoFrame *const)frame compresses:(BOOL const)flag
+{
+	if(!(self = [super initWithVideoStorage:[frame videoStorage]])) return nil;
+	[[self videoStorage] retain]; // Frames can outlive a storage switch while they wait to be replayed.
+	if(![frame lockIfHasBytes]) {
+		[self release];
+		return nil;
+	}
+	if(flag) _data = [ECVLosslessEncodePixelBuffer(frame) retain];
+	_compressed = !!_data;
+	if(!_data) _data = [[NSData alloc] initWithBytes:[frame bytes] length:[[frame videoStorage] bufferSize]]; // Unsupported formats are kept raw.
+	[frame unlock];
+	[self setConcealedLines:[frame concealedLines]];
+	return self;
+}
+- (id)initWithHistoryFrame:(ECVHistoryFrame *const)frame
+{
+	if(!(self = [super initWithVideoStorage:[frame videoStorage]])) return nil;
+	[[self videoStorage] retain];
+	_data = [frame->_data retain];
+	_compressed = frame->_compressed;
+	[self setPresentationTime:[frame presentationTime]];
+	[self setConcealedLines:[frame concealedLines]];
+	return self;
+}
+- (NSUInteger)length
+{
+	return [_data length];
+}
+
+#pragma mark -ECVVideoFrame(ECVAbstract)
+
+- (void const *)bytes
+{
+	return _compressed ? [_decodedData bytes] : [_data bytes];
+}
+
+#pragma mark -
+
+- (BOOL)hasBytes
+{
+	return YES;
+}
+- (BOOL)lockIfHasBytes
+{
+	[self lock];
+	return YES;
+}
+
+#pragma mark -ECVVideoFrame(ECVAbstract) <NSLocking>
+
+- (void)lock
+{
+	@synchronized(self) {
+		if(_lockCount++ || !_compressed || _decodedData) return;
+		// Decoded the first time it's locked, which is on the recipient's encoder threads, and kept until the frame is released, since the recipient may lock it again to compare or scale it.
+		_decodedData = [[NSMutableData alloc] initWithLength:[[self videoStorage] bufferSize]];
+		ECVDataPixelBuffer *const buffer = [[[ECVDataPixelBuffer alloc] initWithPixelSize:[self pixelSize] bytesPerRow:[self bytesPerRow] pixelFormat:[self pixelFormat] data:_decodedData offset:0] autorelease];
+		[buffer lock];
+		if(!ECVLosslessDecodeToPixelBuffer(_data, buffer)) ECVLog(ECVError, @"History frame could not be decoded.");
+		[buffer unlock];
+	}
+}
+- (void)unlock
+{
+	@synchronized(self) {
+		_lockCount--;
+	}
+}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	[[self videoStorage] release];
+	[_data release];
+	[_decodedData release];
+	[super dealloc];
+}
+
+@end
+
+@implementation ECVHistoryAudioBuffer
+
+#pragma mark -ECVHistoryAudioBuffer
+
+- (id)initWithBufferList:(AudioBufferList const *const)bufferList presentationTime:(NSTimeInterval const)time
+{
+	if((self = [super init])) {
+		size_t const listSize = offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * bufferList->mNumberBuffers;
+		size_t length = listSize;
+		UInt32 i = 0;
+		for(; i < bufferList->mNumberBuffers; i++) length += bufferList->mBuffers[i].mDataByteSize;
+		_data = [[NSMutableData alloc] initWithLength:length];
+		AudioBufferList *const copy = [_data mutableBytes];
+		memcpy(copy, bufferList, listSize);
+		UInt8 *bytes = (UInt8 *)copy + listSize;
+		for(i = 0; i < bufferList->mNumberBuffers; i++) {
+			UInt32 const size = bufferList->mBuffers[i].mDataByteSize;
+			if(bufferList->mBuffers[i].mData) memcpy(bytes, bufferList->mBuffers[i].mData, size);
+			copy->mBuffers[i].mData = bytes;
+			bytes += size;
+		}
+		_presentationTime = time;
+	}
+	return self;
+}
+- (AudioBufferList const *)bufferList
+{
+	return [_data bytes];
+}
+- (NSTimeInterval)presentationTime
+{
+	return _presentationTime;
+}
+- (NSUInteger)length
+{
+	return [_data length];
+}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	[_data release];
+	[super dealloc];
+}
+
+@end
@@ -0,0 +1,32 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Models
+@class ECVPixelBuffer;
+@class ECVMutablePixelBuffer;
+
+#define ECVLosslessCodecType 'ECVL'
+#define ECVLosslessSliceCount 8 // Slices are coded independently, so encoding and decoding run in parallel.
+
+// Lossless 4:2:2 8-bit intra coding: each plane is median-predicted and the residuals are rANS coded. Typical composite video comes out at 2-3x.
+extern NSData *ECVLosslessEncodePixelBuffer(ECVPixelBuffer *const buffer); // The buffer must be locked. Returns nil for unsupported formats.
+extern ECVIntegerSize ECVLosslessPixelSize(NSData *const data);
+extern BOOL ECVLosslessDecodeToPixelBuffer(NSData *const data, ECVMutablePixelBuffer *const buffer); // The buffer must be locked and match the encoded size.
@@ -0,0 +1,326 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVLosslessCodec.h"
+
+// Models
+#import "ECVPixelBuffer.h"
+
+// Other Sources
+#import "ECVDebug.h"
+#import "ECVPixelFormat.h"
+
+/* Layout (all integers little-endian):
+- Header: magic, version, width, height, slice count (UInt32 each).
+- Stream sizes: one UInt32 per plane per slice, planes Y, Cb, Cr in order.
+- Streams: 256 UInt16 symbol frequencies, then the rANS payload. */
+
+#define ECVLosslessMagic 'ECVL'
+#define ECVLosslessVersion 1
+#define ECVLosslessPlaneCount 3
+#define ECVLosslessHeaderSize (sizeof(UInt32) * 5)
+#define ECVLosslessFrequencyTableSize (sizeof(UInt16) * 256)
+
+#define ECVRANSScaleBits 12
+#define ECVRANSScale (1u << ECVRANSScaleBits)
+#define ECVRANSLowerBound (1u << 23)
+
+typedef struct {
+	UInt32 frequencies[256];
+	UInt32 starts[256];
+} ECVRANSModel;
+
+NS_INLINE UInt32 ECVReadUInt32(UInt8 const *const p)
+{
+	return OSReadLittleInt32(p, 0);
+}
+NS_INLINE void ECVWriteUInt32(UInt8 *const p, UInt32 const x)
+{
+	OSWriteLittleInt32(p, 0, x);
+}
+NS_INLINE UInt8 ECVMedianPrediction(UInt8 const a, UInt8 const b, UInt8 const c)
+{
+	// LOCO-I: a is to the left, b above and c above-left.
+	if(c >= MAX(a, b)) return MIN(a, b);
+	if(c <= MIN(a, b)) return MAX(a, b);
+	return a + b - c;
+}
+
+static NSUInteger ECVPlaneWidth(ECVIntegerSize const size, NSUInteger const plane)
+{
+	return plane ? size.width / 2 : size.width;
+}
+static void ECVUnpackRow(UInt8 const *const src, ECVComponentOffsets const o, NSUInteger const plane, NSUInteger const width, UInt8 *const dst)
+{
+	NSUInteger i;
+	switch(plane) {
+		case 0: for(i = 0; i < width / 2; i++) {
+			dst[i * 2 + 0] = src[i * 4 + o.luma[0]];
+			dst[i * 2 + 1] = src[i * 4 + o.luma[1]];
+		} break;
+		case 1: for(i = 0; i < width; i++) dst[i] = src[i * 4 + o.blueChroma]; break;
+		case 2: for(i = 0; i < width; i++) dst[i] = src[i * 4 + o.redChroma]; break;
+	}
+}
+static void ECVPackRow(UInt8 const *const src, ECVComponentOffsets const o, NSUInteger const plane, NSUInteger const width, UInt8 *const dst)
+{
+	NSUInteger i;
+	switch(plane) {
+		case 0: for(i = 0; i < width / 2; i++) {
+			dst[i * 4 + o.luma[0]] = src[i * 2 + 0];
+			dst[i * 4 + o.luma[1]] = src[i * 2 + 1];
+		} break;
+		case 1: for(i = 0; i < width; i++) dst[i * 4 + o.blueChroma] = src[i]; break;
+		case 2: for(i = 0; i < width; i++) dst[i * 4 + o.redChroma] = src[i]; break;
+	}
+}
+static void ECVPredictRow(UInt8 const *const row, UInt8 const *const above, NSUInteger const width, UInt8 *const residuals)
+{
+	if(!width) return;
+	if(!above) {
+		residuals[0] = row[0] - 0x80;
+		for(NSUInteger x = 1; x < width; x++) residuals[x] = row[x] - row[x - 1];
+		return;
+	}
+	residuals[0] = row[0] - above[0];
+	for(NSUInteger x = 1; x < width; x++) residuals[x] = row[x] - ECVMedianPrediction(row[x - 1], above[x], above[x - 1]);
+}
+static void ECVUnpredictRow(UInt8 const *const residuals, UInt8 const *const above, NSUInteger const width, UInt8 *const row)
+{
+	if(!width) return;
+	if(!above) {
+		row[0] = residuals[0] + 0x80;
+		for(NSUInteger x = 1; x < width; x++) row[x] = residuals[x] + row[x - 1];
+		return;
+	}
+	row[0] = residuals[0] + above[0];
+	for(NSUInteger x = 1; x < width; x++) row[x] = residuals[x] + ECVMedianPrediction(row[x - 1], above[x], above[x - 1]);
+}
+
+static void ECVRANSModelInit(ECVRANSModel *const model)
+{
+	UInt32 start = 0;
+	for(NSUInteger i = 0; i < 256; i++) {
+		model->starts[i] = start;
+		start += model->frequencies[i];
+	}
+}
+static void ECVRANSModelNormalize(ECVRANSModel *const model, UInt32 const *const counts, size_t const total)
+{
+	// Every symbol that occurs needs a frequency of at least one.
+	UInt32 sum = 0;
+	NSUInteger i;
+	for(i = 0; i < 256; i++) {
+		UInt32 f = (UInt32)((UInt64)counts[i] * ECVRANSScale / total);
+		if(counts[i] && !f) f = 1;
+		model->frequencies[i] = f;
+		sum += f;
+	}
+	while(sum != ECVRANSScale) {
+		NSUInteger largest = 0;
+		for(i = 1; i < 256; i++) if(model->frequencies[i] > model->frequencies[largest]) largest = i;
+		if(sum < ECVRANSScale) {
+			model->frequencies[largest]++;
+			sum++;
+		} else {
+			model->frequencies[largest]--;
+			sum--;
+		}
+	}
+	ECVRANSModelInit(model);
+}
+static size_t ECVRANSEncode(UInt8 const *const symbols, size_t const count, UInt8 *const dst, size_t const dstSize)
+{
+	UInt32 counts[256] = {};
+	size_t i;
+	for(i = 0; i < count; i++) counts[symbols[i]]++;
+	ECVRANSModel model;
+	if(count) ECVRANSModelNormalize(&model, counts, count);
+	else memset(&model, 0, sizeof(model));
+	for(i = 0; i < 256; i++) OSWriteLittleInt16(dst, i * sizeof(UInt16), (UInt16)model.frequencies[i]);
+	if(!count) return ECVLosslessFrequencyTableSize;
+
+	// rANS encodes in reverse, so fill the buffer from the end and move the result down afterward.
+	UInt8 *const end = dst + dstSize;
+	UInt8 *ptr = end;
+	UInt32 x = ECVRANSLowerBound;
+	for(i = count; i--;) {
+		UInt32 const f = model.frequencies[symbols[i]];
+		UInt32 const xMax = ((ECVRANSLowerBound >> ECVRANSScaleBits) << 8) * f;
+		while(x >= xMax) {
+			*--ptr = (UInt8)x;
+			x >>= 8;
+		}
+		x = ((x / f) << ECVRANSScaleBits) + (x % f) + model.starts[symbols[i]];
+	}
+	ptr -= sizeof(UInt32);
+	ECVWriteUInt32(ptr, x);
+	size_t const payloadSize = end - ptr;
+	memmove(dst + ECVLosslessFrequencyTableSize, ptr, payloadSize);
+	return ECVLosslessFrequencyTableSize + payloadSize;
+}
+static BOOL ECVRANSDecode(UInt8 const *const src, size_t const srcSize, UInt8 *const symbols, size_t const count)
+{
+	if(srcSize < ECVLosslessFrequencyTableSize) return NO;
+	ECVRANSModel model;
+	UInt32 sum = 0;
+	NSUInteger i;
+	for(i = 0; i < 256; i++) sum += model.frequencies[i] = OSReadLittleInt16(src, i * sizeof(UInt16));
+	if(!count) return YES;
+	if(ECVRANSScale != sum || srcSize < ECVLosslessFrequencyTableSize + sizeof(UInt32)) return NO;
+	ECVRANSModelInit(&model);
+	UInt8 lookup[ECVRANSScale];
+	for(i = 0; i < 256; i++) memset(lookup + model.starts[i], (int)i, model.frequencies[i]);
+
+	UInt8 const *ptr = src + ECVLosslessFrequencyTableSize;
+	UInt8 const *const end = src + srcSize;
+	UInt32 x = ECVReadUInt32(ptr);
+	ptr += sizeof(UInt32);
+	for(size_t j = 0; j < count; j++) {
+		UInt8 const s = lookup[x & (ECVRANSScale - 1)];
+		symbols[j] = s;
+		x = model.frequencies[s] * (x >> ECVRANSScaleBits) + (x & (ECVRANSScale - 1)) - model.starts[s];
+		while(x < ECVRANSLowerBound) {
+			if(ptr >= end) return NO;
+			x = (x << 8) | *ptr++;
+		}
+	}
+	return YES;
+}
+
+static size_t ECVMaxStreamSize(size_t const count)
+{
+	return ECVLosslessFrequencyTableSize + sizeof(UInt32) + count * 2; // A symbol never costs more than 12 bits.
+}
+static NSUInteger ECVSliceRow(ECVIntegerSize const size, NSUInteger const sliceCount, NSUInteger const slice)
+{
+	return size.height * slice / sliceCount;
+}
+
+#pragma mark -
+
+NSData *ECVLosslessEncodePixelBuffer(ECVPixelBuffer *const buffer)
+{
+	OSType const pixelFormat = [buffer pixelFormat];
+	if(k2vuyPixelFormat != pixelFormat && kYVYU422PixelFormat != pixelFormat) return nil;
+	ECVIntegerSize const size = [buffer pixelSize];
+	if(!size.width || !size.height || size.width % 2) return nil;
+	UInt8 const *const bytes = [buffer bytes];
+	size_t const bytesPerRow = [buffer bytesPerRow];
+	ECVComponentOffsets const offsets = ECVPixelFormatComponentOffsets(pixelFormat);
+	NSUInteger const sliceCount = MIN((NSUInteger)ECVLosslessSliceCount, size.height);
+	NSUInteger const streamCount = sliceCount * ECVLosslessPlaneCount;
+
+	UInt8 **const streams = calloc(streamCount, sizeof(UInt8 *));
+	size_t *const streamSizes = calloc(streamCount, sizeof(size_t));
+	dispatch_apply(streamCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t const stream) {
+		NSUInteger const plane = stream / sliceCount;
+		NSUInteger const slice = stream % sliceCount;
+		NSUInteger const width = ECVPlaneWidth(size, plane);
+		NSUInteger const firstRow = ECVSliceRow(size, sliceCount, slice);
+		NSUInteger const rowCount = ECVSliceRow(size, sliceCount, slice + 1) - firstRow;
+		size_t const count = width * rowCount;
+		UInt8 *const residuals = malloc(count + width * 2);
+		UInt8 *rows[2] = {residuals + count, residuals + count + width};
+		for(NSUInteger y = 0; y < rowCount; y++) {
+			ECVUnpackRow(bytes + bytesPerRow * (firstRow + y), offsets, plane, width, rows[y % 2]);
+			ECVPredictRow(rows[y % 2], y ? rows[(y + 1) % 2] : NULL, width, residuals + width * y);
+		}
+		size_t const maxSize = ECVMaxStreamSize(count);
+		streams[stream] = malloc(maxSize);
+		streamSizes[stream] = ECVRANSEncode(residuals, count, streams[stream], maxSize);
+		free(residuals);
+	});
+
+	size_t length = ECVLosslessHeaderSize + sizeof(UInt32) * streamCount;
+	NSUInteger i;
+	for(i = 0; i < streamCount; i++) length += streamSizes[i];
+	NSMutableData *const data = [NSMutableData dataWithLength:length];
+	UInt8 *ptr = [data mutableBytes];
+	ECVWriteUInt32(ptr + 0, ECVLosslessMagic);
+	ECVWriteUInt32(ptr + 4, ECVLosslessVersion);
+	ECVWriteUInt32(ptr + 8, (UInt32)size.width);
+	ECVWriteUInt32(ptr + 12, (UInt32)size.height);
+	ECVWriteUInt32(ptr + 16, (UInt32)sliceCount);
+	ptr += ECVLosslessHeaderSize;
+	for(i = 0; i < streamCount; i++, ptr += sizeof(UInt32)) ECVWriteUInt32(ptr, (UInt32)streamSizes[i]);
+	for(i = 0; i < streamCount; i++) {
+		memcpy(ptr, streams[i], streamSizes[i]);
+		ptr += streamSizes[i];
+		free(streams[i]);
+	}
+	free(streams);
+	free(streamSizes);
+	return data;
+}
+ECVIntegerSize ECVLosslessPixelSize(NSData *const data)
+{
+	UInt8 const *const bytes = [data bytes];
+	if([data length] < ECVLosslessHeaderSize || ECVLosslessMagic != ECVReadUInt32(bytes) || ECVLosslessVersion != ECVReadUInt32(bytes + 4)) return (ECVIntegerSize){0, 0};
+	return (ECVIntegerSize){ECVReadUInt32(bytes + 8), ECVReadUInt32(bytes + 12)};
+}
+BOOL ECVLosslessDecodeToPixelBuffer(NSData *const data, ECVMutablePixelBuffer *const buffer)
+{
+	ECVIntegerSize const size = ECVLosslessPixelSize(data);
+	if(!size.width || !size.height || size.width % 2) return NO;
+	if(!ECVEqualPixelSizes(size, [buffer pixelSize])) return NO;
+	OSType const pixelFormat = [buffer pixelFormat];
+	if(k2vuyPixelFormat != pixelFormat && kYVYU422PixelFormat != pixelFormat) return NO;
+	UInt8 const *const src = [data bytes];
+	size_t const length = [data length];
+	NSUInteger const sliceCount = ECVReadUInt32(src + 16);
+	if(!sliceCount || sliceCount > size.height) return NO;
+	NSUInteger const streamCount = sliceCount * ECVLosslessPlaneCount;
+	if(length < ECVLosslessHeaderSize + sizeof(UInt32) * streamCount) return NO;
+
+	size_t *const streamOffsets = calloc(streamCount + 1, sizeof(size_t));
+	streamOffsets[0] = ECVLosslessHeaderSize + sizeof(UInt32) * streamCount;
+	NSUInteger i;
+	for(i = 0; i < streamCount; i++) streamOffsets[i + 1] = streamOffsets[i] + ECVReadUInt32(src + ECVLosslessHeaderSize + sizeof(UInt32) * i);
+	if(streamOffsets[streamCount] > length) {
+		free(streamOffsets);
+		return NO;
+	}
+
+	UInt8 *const bytes = [buffer mutableBytes];
+	size_t const bytesPerRow = [buffer bytesPerRow];
+	ECVComponentOffsets const offsets = ECVPixelFormatComponentOffsets(pixelFormat);
+	__block volatile BOOL success = YES;
+	dispatch_apply(streamCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t const stream) {
+		NSUInteger const plane = stream / sliceCount;
+		NSUInteger const slice = stream % sliceCount;
+		NSUInteger const width = ECVPlaneWidth(size, plane);
+		NSUInteger const firstRow = ECVSliceRow(size, sliceCount, slice);
+		NSUInteger const rowCount = ECVSliceRow(size, sliceCount, slice + 1) - firstRow;
+		size_t const count = width * rowCount;
+		UInt8 *const residuals = malloc(count + width * 2);
+		if(ECVRANSDecode(src + streamOffsets[stream], streamOffsets[stream + 1] - streamOffsets[stream], residuals, count)) {
+			UInt8 *rows[2] = {residuals + count, residuals + count + width};
+			for(NSUInteger y = 0; y < rowCount; y++) {
+				ECVUnpredictRow(residuals + width * y, y ? rows[(y + 1) % 2] : NULL, width, rows[y % 2]);
+				ECVPackRow(rows[y % 2], offsets, plane, width, bytes + bytesPerRow * (firstRow + y));
+			}
+		} else success = NO;
+		free(residuals);
+	});
+	free(streamOffsets);
+	return success;
+}
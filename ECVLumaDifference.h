@@ -0,0 +1,31 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Models
+@class ECVPixelBuffer;
+
+#define ECVLumaDecimation 4 // Each decimated sample averages a 4x4 block of pixels.
+
+// Cheap frame comparisons on a decimated luma plane. Decimating averages out most analog noise and leaves 1/16th of the pixels to compare.
+extern ECVIntegerSize ECVDecimatedLumaSize(ECVIntegerSize const pixelSize);
+extern BOOL ECVDecimateLuma(ECVPixelBuffer *const buffer, UInt8 *const luma); // The buffer must be locked. The luma plane must hold ECVDecimatedLumaSize() samples. Returns NO for unsupported formats.
+extern void ECVLumaBlockSADs(UInt8 const *const a, UInt8 const *const b, ECVIntegerSize const size, NSUInteger const blockSize, UInt32 *const SADs); // One sum of absolute differences per blockSize x blockSize block of samples, row-major. Partial blocks at the edges are left out.
+extern CGFloat ECVLumaMaxBlockDifference(UInt8 const *const a, UInt8 const *const b, ECVIntegerSize const size, NSUInteger const blockSize); // The largest mean absolute difference of any block.
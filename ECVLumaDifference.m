@@ -0,0 +1,102 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVLumaDifference.h"
+
+// Models
+#import "ECVPixelBuffer.h"
+
+// Other Sources
+#import "ECVPixelFormat.h"
+
+#define ECVLumaMaxRowWidth 2048 // Decimated samples.
+
+NS_INLINE NSUInteger ECVBlockCount(NSUInteger const length, NSUInteger const blockSize)
+{
+	return blockSize ? length / blockSize : 0;
+}
+
+ECVIntegerSize ECVDecimatedLumaSize(ECVIntegerSize const pixelSize)
+{
+	return (ECVIntegerSize){pixelSize.width / ECVLumaDecimation, pixelSize.height / ECVLumaDecimation};
+}
+BOOL ECVDecimateLuma(ECVPixelBuffer *const buffer, UInt8 *const luma)
+{
+	OSType const pixelFormat = [buffer pixelFormat];
+	if(k2vuyPixelFormat != pixelFormat && kYVYU422PixelFormat != pixelFormat) return NO;
+	ECVIntegerSize const size = ECVDecimatedLumaSize([buffer pixelSize]);
+	if(!size.width || !size.height || size.width > ECVLumaMaxRowWidth) return NO;
+	UInt8 const *const bytes = [buffer bytes];
+	size_t const bytesPerRow = [buffer bytesPerRow];
+	ECVComponentOffsets const o = ECVPixelFormatComponentOffsets(pixelFormat);
+	size_t const l0 = o.luma[0], l1 = o.luma[1];
+
+	UInt16 sums[ECVLumaMaxRowWidth];
+	NSUInteger y = 0;
+	for(; y < size.height; y++) {
+		memset(sums, 0, sizeof(UInt16) * size.width);
+		NSUInteger r = 0;
+		for(; r < ECVLumaDecimation; r++) {
+			UInt8 const *const row = bytes + (y * ECVLumaDecimation + r) * bytesPerRow;
+			NSUInteger x = 0;
+			for(; x < size.width; x++) {
+				UInt8 const *const p = row + x * ECVLumaDecimation * 2; // Two pixel groups of four bytes each.
+				sums[x] += p[l0] + p[l1] + p[4 + l0] + p[4 + l1];
+			}
+		}
+		UInt8 *const dst = luma + y * size.width;
+		NSUInteger x = 0;
+		for(; x < size.width; x++) dst[x] = (UInt8)((sums[x] + 8) >> 4);
+	}
+	return YES;
+}
+void ECVLumaBlockSADs(UInt8 const *const a, UInt8 const *const b, ECVIntegerSize const size, NSUInteger const blockSize, UInt32 *const SADs)
+{
+	NSUInteger const columns = ECVBlockCount(size.width, blockSize);
+	NSUInteger const rows = ECVBlockCount(size.height, blockSize);
+	memset(SADs, 0, sizeof(UInt32) * columns * rows);
+	NSUInteger y = 0;
+	for(; y < rows * blockSize; y++) {
+		UInt8 const *const rowA = a + y * size.width;
+		UInt8 const *const rowB = b + y * size.width;
+		UInt32 *const blockRow = SADs + (y / blockSize) * columns;
+		NSUInteger column = 0;
+		for(; column < columns; column++) {
+			UInt32 sum = 0;
+			NSUInteger x = column * blockSize;
+			NSUInteger const end = x + blockSize;
+			for(; x < end; x++) sum += (UInt32)abs((int)rowA[x] - (int)rowB[x]);
+			blockRow[column] += sum;
+		}
+	}
+}
+CGFloat ECVLumaMaxBlockDifference(UInt8 const *const a, UInt8 const *const b, ECVIntegerSize const size, NSUInteger const blockSize)
+{
+	NSUInteger const count = ECVBlockCount(size.width, blockSize) * ECVBlockCount(size.height, blockSize);
+	if(!count) return 0.0;
+	UInt32 *const SADs = malloc(sizeof(UInt32) * count);
+	ECVLumaBlockSADs(a, b, size, blockSize, SADs);
+	UInt32 maxSAD = 0;
+	NSUInteger i = 0;
+	for(; i < count; i++) maxSAD = MAX(maxSAD, SADs[i]);
+	free(SADs);
+	return (CGFloat)maxSAD / (blockSize * blockSize);
+}
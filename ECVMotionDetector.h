@@ -0,0 +1,68 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVAVTarget.h"
+
+@protocol ECVMotionDetectorDelegate;
+
+#define ECVMotionDetectorBlockSize 4 // In decimated luma samples, so 16x16 pixels.
+
+// Watches the video for motion on a low-priority serial queue, which owns all of the analysis state. Frames are compared on a decimated luma plane, and a block counts as moving when it differs by more than a multiple of the typical difference of still blocks, so the threshold follows the source's noise.
+@interface ECVMotionDetector : NSObject <ECVAVTarget>
+{
+	@private
+	NSObject<ECVMotionDetectorDelegate> *_delegate;
+	NSTimeInterval _postRoll;
+	CGFloat _sensitivity;
+	dispatch_queue_t _queue;
+	volatile int32_t _analyzing;
+
+	ECVIntegerSize _lumaSize;
+	UInt8 *_previousLuma;
+	UInt8 *_currentLuma;
+	UInt32 *_SADs;
+	BOOL _hasPreviousLuma;
+	double _noiseLevel;
+	BOOL _motion;
+	NSTimeInterval _lastMotionTime;
+
+	NSUInteger _analyzedFrameCount;
+	NSUInteger _skippedFrameCount;
+	NSTimeInterval _analysisTime;
+}
+
+- (id)initWithPostRoll:(NSTimeInterval const)postRoll sensitivity:(CGFloat const)sensitivity; // Motion ends after postRoll seconds without any. Lower sensitivities need bigger changes; 4.0 is a good start.
+- (NSObject<ECVMotionDetectorDelegate> *)delegate;
+- (void)setDelegate:(NSObject<ECVMotionDetectorDelegate> *const)obj; // Once this returns, the old delegate won't be called again.
+- (NSTimeInterval)postRoll;
+- (CGFloat)sensitivity;
+
+- (BOOL)isDetectingMotion;
+- (NSString *)statisticsDescription;
+
+@end
+
+@protocol ECVMotionDetectorDelegate <NSObject>
+
+- (void)motionDetectorDidStartDetectingMotion:(ECVMotionDetector *const)sender; // Called on a background queue.
+- (void)motionDetectorDidStopDetectingMotion:(ECVMotionDetector *const)sender; // Called on a background queue.
+
+@end
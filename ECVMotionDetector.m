@@ -0,0 +1,196 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVMotionDetector.h"
+#import <libkern/OSAtomic.h>
+
+// Models
+#import "ECVVideoFrame.h"
+
+// Other Sources
+#import "ECVDebug.h"
+#import "ECVFoundationAdditions.h"
+#import "ECVLumaDifference.h"
+
+#define ECVMotionDetectorMinimumDifference 3 // Mean absolute difference per sample. Below this, even a clean source is considered still.
+#define ECVMotionDetectorNoiseAdaptation 0.05 // How quickly the noise level follows the still blocks.
+
+@interface ECVMotionDetector(Private)
+
+- (void)_analyzeFrame:(ECVVideoFrame *const)frame;
+- (void)_resetWithLumaSize:(ECVIntegerSize const)size;
+
+@end
+
+@implementation ECVMotionDetector
+
+#pragma mark -ECVMotionDetector
+
+- (id)initWithPostRoll:(NSTimeInterval const)postRoll sensitivity:(CGFloat const)sensitivity
+{
+	if((self = [super init])) {
+		_postRoll = postRoll;
+		_sensitivity = sensitivity;
+		_queue = dispatch_queue_create("ECVMotionDetector", NULL);
+		dispatch_set_target_queue(_queue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0));
+	}
+	return self;
+}
+- (NSObject<ECVMotionDetectorDelegate> *)delegate
+{
+	return _delegate;
+}
+- (void)setDelegate:(NSObject<ECVMotionDetectorDelegate> *const)obj
+{
+	dispatch_sync(_queue, ^{
+		_delegate = obj;
+	});
+}
+- (NSTimeInterval)postRoll
+{
+	return _postRoll;
+}
+- (CGFloat)sensitivity
+{
+	return _sensitivity;
+}
+
+#pragma mark -
+
+- (BOOL)isDetectingMotion
+{
+	__block BOOL motion = NO;
+	dispatch_sync(_queue, ^{
+		motion = _motion;
+	});
+	return motion;
+}
+- (NSString *)statisticsDescription
+{
+	__block NSString *description = nil;
+	dispatch_sync(_queue, ^{
+		description = [[NSString alloc] initWithFormat:@"Motion detection: %lu frames analyzed (%lu skipped), %.3f ms per frame, noise level %.1f.", (unsigned long)_analyzedFrameCount, (unsigned long)_skippedFrameCount, _analyzedFrameCount ? _analysisTime / _analyzedFrameCount * 1000.0 : 0.0, _noiseLevel / (ECVMotionDetectorBlockSize * ECVMotionDetectorBlockSize)];
+	});
+	return [description autorelease];
+}
+
+#pragma mark -ECVMotionDetector(Private)
+
+- (void)_analyzeFrame:(ECVVideoFrame *const)frame
+{
+	// On the queue.
+	NSTimeInterval const startTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+	ECVIntegerSize const size = ECVDecimatedLumaSize([frame pixelSize]);
+	if(!ECVEqualPixelSizes(size, _lumaSize)) [self _resetWithLumaSize:size];
+	if(![frame lockIfHasBytes]) return;
+	BOOL const decimated = ECVDecimateLuma(frame, _currentLuma);
+	[frame unlock];
+	if(!decimated) return;
+
+	BOOL motion = NO;
+	if(_hasPreviousLuma) {
+		NSUInteger const count = (size.width / ECVMotionDetectorBlockSize) * (size.height / ECVMotionDetectorBlockSize);
+		ECVLumaBlockSADs(_previousLuma, _currentLuma, size, ECVMotionDetectorBlockSize, _SADs);
+		double const threshold = MAX(_noiseLevel * _sensitivity, ECVMotionDetectorMinimumDifference * ECVMotionDetectorBlockSize * ECVMotionDetectorBlockSize);
+		NSUInteger movingCount = 0;
+		double stillSum = 0.0;
+		NSUInteger i = 0;
+		for(; i < count; i++) {
+			if(_SADs[i] > threshold) movingCount++;
+			else stillSum += _SADs[i];
+		}
+		if(movingCount < count) {
+			double const stillLevel = stillSum / (count - movingCount);
+			_noiseLevel = _noiseLevel ? _noiseLevel + (stillLevel - _noiseLevel) * ECVMotionDetectorNoiseAdaptation : stillLevel;
+		}
+		motion = movingCount >= MAX(count / 200, (NSUInteger)2); // Ignore a single flickering block.
+	}
+	UInt8 *const luma = _previousLuma;
+	_previousLuma = _currentLuma;
+	_currentLuma = luma;
+	_hasPreviousLuma = YES;
+
+	NSTimeInterval const time = [frame presentationTime] ?: startTime;
+	if(motion) {
+		_lastMotionTime = time;
+		if(!_motion) {
+			_motion = YES;
+			[_delegate motionDetectorDidStartDetectingMotion:self];
+		}
+	} else if(_motion && time - _lastMotionTime >= _postRoll) {
+		_motion = NO;
+		[_delegate motionDetectorDidStopDetectingMotion:self];
+	}
+	_analyzedFrameCount++;
+	_analysisTime += [NSDate ECV_timeIntervalSinceReferenceDate] - startTime;
+}
+- (void)_resetWithLumaSize:(ECVIntegerSize const)size
+{
+	_lumaSize = size;
+	_previousLuma = reallocf(_previousLuma, size.width * size.height);
+	_currentLuma = reallocf(_currentLuma, size.width * size.height);
+	_SADs = reallocf(_SADs, sizeof(UInt32) * MAX((size.width / ECVMotionDetectorBlockSize) * (size.height / ECVMotionDetectorBlockSize), (NSUInteger)1));
+	_hasPreviousLuma = NO;
+	_noiseLevel = 0.0;
+}
+
+#pragma mark -<ECVAVTarget>
+
+- (void)play
+{
+	dispatch_async(_queue, ^{
+		_hasPreviousLuma = NO;
+	});
+}
+- (void)stop
+{
+	ECVLog(ECVNotice, @"%@", [self statisticsDescription]);
+}
+- (void)pushVideoFrame:(ECVVideoFrame *const)frame
+{
+	if(!frame) return;
+	if(!OSAtomicCompareAndSwap32Barrier(0, 1, &_analyzing)) {
+		dispatch_async(_queue, ^{
+			_skippedFrameCount++; // Never queue up behind a slow analysis; the next frame will do.
+		});
+		return;
+	}
+	dispatch_async(_queue, ^{
+		NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+		[self _analyzeFrame:frame];
+		OSAtomicCompareAndSwap32Barrier(1, 0, &_analyzing);
+		[pool drain];
+	});
+}
+- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue presentationTime:(NSTimeInterval const)time {}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	if(_queue) dispatch_release(_queue);
+	if(_previousLuma) free(_previousLuma);
+	if(_currentLuma) free(_currentLuma);
+	if(_SADs) free(_SADs);
+	[super dealloc];
+}
+
+@end
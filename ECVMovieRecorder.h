@@ -31,6 +31,29 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 // Other Sources
 @class ECVAudioInput;
 @class ECVAudioPipe;
+#import "ECVHistoryBuffer.h"
+#import "ECVPixelBuffer.h"
+
+enum {
+	ECVRecordingRepeatFrames = 0, // Repeat the last encoded frame so the video keeps time with the audio.
+	ECVRecordingDropFrames = 1, // Leave the frame out, so the video comes out short.
+};
+typedef NSInteger ECVRecordingOverflowPolicy; // What to do with frames that arrive while the compress queue is full.
+
+#define ECVMovieRecorderCompressQueueCapacity 8
+#define ECVMovieRecorderRecordQueueDuration 10.0 // Seconds of frames the record queue can hold, however small they are. Its bytes are bounded by the buffer size.
+#define ECVMovieRecorderRecordQueueMinCapacity 32
+#define ECVMovieRecorderMaxEncoderCount 8
+#define ECVMovieRecorderReorderCapacity (ECVMovieRecorderMaxEncoderCount * 2)
+#define ECVMovieRecorderUnchangedBlockSize 8 // In decimated luma samples, so 32x32 pixels.
+#define ECVMovieRecorderQualityLevelCount 6 // Steps the governor can take, from the requested quality down to half size.
+
+typedef struct {
+	id *items;
+	NSUInteger capacity;
+	NSUInteger start;
+	NSUInteger count;
+} ECVObjectQueue;
 
 @interface ECVMovieRecordingOptions : NSObject
 {
@@ -46,6 +69,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 	NSRect _cropRect;
 	BOOL _upconvertsFromMono;
 	CMTime _frameRate;
+	ECVRecordingOverflowPolicy _overflowPolicy;
+	NSUInteger _encoderCount;
+	NSTimeInterval _segmentDuration;
+	unsigned long long _segmentSize;
+	BOOL _splitsOnRequest;
+	CGFloat _unchangedFrameThreshold;
+	BOOL _adaptsQuality;
+	BOOL _scalesInCodec;
+	ECVPixelBufferScalingFilter _scalingFilter;
+	NSArray *_proxies;
+	unsigned long long _bufferSize;
 
 	CGFloat _volume;
 }
@@ -62,6 +96,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 @property(assign) NSRect cropRect;
 @property(assign) BOOL upconvertsFromMono;
 @property(assign) CMTime frameRate;
+@property(assign) ECVRecordingOverflowPolicy overflowPolicy;
+@property(assign) NSUInteger encoderCount; // Number of parallel compression sessions. 0 uses one per core. Frames are always encoded intra-only.
+@property(assign) NSTimeInterval segmentDuration; // Start a new file once the current one holds this much video. 0 disables.
+@property(assign) unsigned long long segmentSize; // Start a new file once the current one holds this many bytes. 0 disables.
+@property(assign) BOOL splitsOnRequest; // Name files as segments even without a duration or size, so each -closeSegment can end one.
+@property(assign) BOOL scalesInCodec; // Hand ICM whole frames to crop and scale, instead of doing it while copying them in.
+@property(assign) ECVPixelBufferScalingFilter scalingFilter;
+@property(copy) NSArray *proxies; // More ECVMovieRecordingOptions, each recorded to its own file from the same frames. Proxies no larger than this output are scaled down from its cropped frames instead of converting the captured ones again, unless this adapts its quality.
+@property(assign) BOOL adaptsQuality; // Lower the quality, then the size, while the encoders can't keep up, and recover once they can. Ignored for lossless recording.
+@property(assign) unsigned long long bufferSize; // Bytes of encoded frames held while the movie file catches up, like ECVRecordingBufferSizeKey for stream writers. 0 only limits the queue's length.
+@property(assign) CGFloat unchangedFrameThreshold; // Frames whose luma differs from the last encoded frame by no more than this (mean absolute difference in every block) repeat it instead of being encoded. 0 disables.
 
 @property(readonly) NSDictionary *cleanAperatureDictionary;
 
@@ -70,25 +115,108 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 
 @end
 
-@interface ECVMovieRecorder : NSObject
+@interface ECVMovieRecorder : NSObject <ECVHistoryBufferRecipient>
 {
 	@private
 	NSConditionLock *_compressLock;
-	NSMutableArray *_compressQueue;
+	ECVObjectQueue _compressQueue;
+	NSCondition *_compressSpaceCondition; // Broadcast whenever an encoder takes a frame or the encoders finish.
+	NSUInteger _compressRepeatCounts[ECVMovieRecorderCompressQueueCapacity]; // Repeats to add after the frame in the same slot.
+	ECVRecordingOverflowPolicy _overflowPolicy;
+	NSUInteger _droppedFrameCount;
+	NSUInteger _repeatedFrameCount;
+	NSTimeInterval _encoderLag;
+	NSUInteger _encodedFrameCount;
+	NSTimeInterval _encodeTime;
+	NSTimeInterval _convertTime; // Part of the encode time spent filling the encoder's pixel buffer.
+	BOOL _scalesInCodec;
+	CGFloat _unchangedFrameThreshold;
+	ECVIntegerSize _lumaSize;
+	UInt8 *_referenceLuma; // From the last frame that was encoded.
+	UInt8 *_currentLuma; // The frame being added. Becomes the reference only once it's queued for encoding.
+	BOOL _hasCurrentLuma;
+	BOOL _hasReferenceLuma;
+	NSUInteger _unchangedRunLength;
+	NSUInteger _maxUnchangedRunLength;
+	NSUInteger _unchangedFrameCount;
+	NSTimeInterval _detectionTime;
+	NSUInteger _detectionCount;
+	BOOL _adaptsQuality;
+	NSTimeInterval _frameDuration; // Of the source.
+	NSUInteger _qualityLevel;
+	NSTimeInterval _averageEncodeTime;
+	NSTimeInterval _pressureStartTime;
+	NSTimeInterval _headroomStartTime;
+	NSTimeInterval _qualityChangeTime;
+	NSUInteger _qualityChangeCount;
+	NSUInteger _encoderCount;
+	NSUInteger _activeEncoderCount;
+	NSUInteger _sequenceNumber;
+	NSCondition *_reorderLock; // Broadcast whenever the next sequence number advances.
+	id _reorderFrames[ECVMovieRecorderReorderCapacity];
+	BOOL _reorderFilled[ECVMovieRecorderReorderCapacity];
+	id _reorderConvertedFrames[ECVMovieRecorderReorderCapacity]; // For the proxies, once they're back in sequence.
+	NSUInteger _reorderRepeatCounts[ECVMovieRecorderReorderCapacity];
+	NSUInteger _reorderQualityLevels[ECVMovieRecorderReorderCapacity];
+	NSTimeInterval _reorderPresentationTimes[ECVMovieRecorderReorderCapacity];
+	NSUInteger _nextSequenceNumber;
+	NSUInteger _segmentBreakSequence; // The first frame after a -closeSegment, or NSNotFound.
 	NSConditionLock *_recordLock;
-	NSMutableArray *_recordQueue;
+	ECVObjectQueue _recordQueue;
+	NSUInteger *_recordQualityLevels; // Of the frame in the same slot, counted by the record thread as it's written.
+	NSTimeInterval *_recordPresentationTimes; // 0 for repeats.
+	size_t *_recordByteCounts; // 0 for repeats, which share the earlier frame's data.
+	unsigned long long _recordBufferSize;
+	unsigned long long _recordByteCount;
+	unsigned long long _recordHighWaterMark;
+	NSUInteger _recordHighWaterCount;
+	NSTimeInterval _recordStallTime; // Encoders waiting for room.
+	NSCondition *_recordSpaceCondition; // Signaled whenever the record thread takes a frame or finishes.
+	NSUInteger _recordPopCount;
+	NSUInteger _deliveredFrameCount; // Pushed onto the record queue by the encoders.
+	NSUInteger _segmentBreakFrameCount; // Frames the record thread writes before closing the segment, or NSNotFound.
+	NSUInteger _segmentBreakCount; // Closed by request so far.
+	BOOL _compressFinished;
+	unsigned long long _losslessInputLength;
+	unsigned long long _losslessOutputLength;
+	NSTimeInterval _losslessEncodeTime;
 	ECVAudioPipe *_audioPipe;
 	BOOL _stop;
-
-	ICMEncodedFrameRef _encodedFrame;
+	NSTimeInterval _audioStartTime;
+	NSUInteger _segmentCount;
+	NSUInteger _sampleCount;
+	NSUInteger _sampleFrameCount;
+	unsigned long long _sampleByteCount;
+	NSTimeInterval _sampleTime;
+	NSArray *_proxyRecorders; // Fed our converted frames.
+	NSArray *_independentProxyRecorders; // Fed the captured frames.
+
+	id _encodedFrame;
+	NSUInteger _encodedFrameQualityLevel;
 }
 
 - (id)initWithOptions:(ECVMovieRecordingOptions *const)options error:(out NSError **const)outError;
 
 - (void)addVideoFrame:(ECVVideoFrame *const)frame;
-- (void)addAudioBufferList:(AudioBufferList const *const)bufferList;
+- (void)addAudioBufferList:(AudioBufferList const *const)bufferList presentationTime:(NSTimeInterval const)time; // Each segment's audio track is offset by the difference between its first video and audio presentation times.
 
 - (void)stopRecording;
+- (void)closeSegment; // Blocks until every frame added so far is written, then closes the file. The next frame starts a new one, so a recording can pause without being recreated.
+
+- (BOOL)isReadyForMoreVideoFrames; // Whether the compress queue has room, for callers that can wait instead of dropping frames.
+- (BOOL)waitUntilReadyForMoreVideoFramesBeforeDate:(NSDate *const)date;
+
+// These can be polled while recording.
+- (NSUInteger)compressQueueDepth;
+- (NSUInteger)reorderDepth; // Frames encoded out of order, waiting for earlier ones.
+- (NSUInteger)recordQueueDepth;
+- (unsigned long long)recordQueueHighWaterMark; // Bytes.
+- (NSUInteger)droppedFrameCount;
+- (NSUInteger)repeatedFrameCount;
+- (NSUInteger)unchangedFrameCount; // Repeated instead of encoded because nothing changed.
+- (NSTimeInterval)encoderLag; // Between capturing the last frame and handing it to the encoder.
+- (NSUInteger)qualityLevel; // 0 is the requested quality and size.
+- (NSUInteger)segmentCount; // Files started so far. Segments after the first are named "<name> 002.<ext>" and so on.
 
 @end
 
@@ -34,19 +34,113 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVAudioPipe.h"
 #endif
 #import "ECVDebug.h"
+#import "ECVFoundationAdditions.h"
 #import "ECVICM.h"
+#import "ECVLosslessCodec.h"
+#import "ECVLumaDifference.h"
 
 #define ECVAudioBufferBytesSize (ECVStandardAudioStreamBasicDescription.mBytesPerPacket * 1000) // Should be more than enough to keep up with the incoming data.
 
-@protocol ECVCompressionDelegate
+#define ECVQualityPressureLoad 0.9 // Fraction of the time each encoder has per frame.
+#define ECVQualityHeadroomLoad 0.6
+#define ECVQualityPressureDelay 0.5 // Step down quickly so the queue doesn't overflow...
+#define ECVQualityHeadroomDelay 5.0 // ...but recover slowly so we don't oscillate.
+#define ECVQualityMinChangeInterval 1.0 // Let the encoders settle before judging the new level.
+
+static struct {
+	CGFloat quality;
+	CGFloat scale;
+} const ECVQualityLevels[ECVMovieRecorderQualityLevelCount] = {
+	{1.0, 1.0},
+	{0.8, 1.0},
+	{0.6, 1.0},
+	{0.4, 1.0},
+	{0.4, 0.75},
+	{0.4, 0.5},
+};
+
+@class ECVMovieRecorder;
+
+typedef struct {
+	ECVMovieRecorder *recorder;
+	NSUInteger sequenceNumber;
+	NSUInteger repeatCount;
+	NSUInteger qualityLevel;
+	NSTimeInterval presentationTime;
+	BOOL delivered;
+	id convertedFrame;
+} ECVEncoderContext;
+
+typedef struct {
+	NSURL *URL;
+	Movie movie;
+	DataHandler dataHandler;
+	Track videoTrack;
+	Media videoMedia;
+	Track audioTrack;
+	Media audioMedia;
+	NSUInteger frameCount;
+	NSUInteger sampleCount;
+	TimeValue64 videoDuration; // What the samples we added should add up to.
+	NSTimeInterval videoStartTime; // Presentation time of its first frame.
+	unsigned long long audioFrameOffset; // Audio frames written to earlier segments.
+	NSUInteger qualityLevelFrameCounts[ECVMovieRecorderQualityLevelCount];
+	unsigned long long byteCount;
+} ECVMovieSegment;
+
+static void ECVObjectQueueCreate(ECVObjectQueue *const queue, NSUInteger const capacity)
+{
+	*queue = (ECVObjectQueue){calloc(capacity, sizeof(id)), capacity, 0, 0};
+}
+static BOOL ECVObjectQueuePush(ECVObjectQueue *const queue, id const obj)
+{
+	if(queue->count >= queue->capacity) return NO;
+	queue->items[(queue->start + queue->count++) % queue->capacity] = [obj retain];
+	return YES;
+}
+static id ECVObjectQueuePop(ECVObjectQueue *const queue)
+{
+	if(!queue->count) return nil;
+	id const obj = queue->items[queue->start];
+	queue->items[queue->start] = nil;
+	queue->start = (queue->start + 1) % queue->capacity;
+	queue->count--;
+	return [obj autorelease];
+}
+static void ECVObjectQueueDestroy(ECVObjectQueue *const queue)
+{
+	for(; queue->count; queue->count--) {
+		[queue->items[queue->start] release];
+		queue->start = (queue->start + 1) % queue->capacity;
+	}
+	free(queue->items);
+	queue->items = NULL;
+}
 
-- (void)addEncodedFrame:(ICMEncodedFrameRef const)frame;
+static size_t ECVEncodedFrameByteCount(id const frame)
+{
+	return [frame isKindOfClass:[NSData class]] ? [frame length] : (size_t)ICMEncodedFrameGetDataSize((ICMEncodedFrameRef)frame);
+}
+
+@interface ECVConvertedFrame : ECVVideoFrame
+{
+	@private
+	CVPixelBufferRef _pixelBuffer;
+}
+
+- (id)initWithPixelBuffer:(CVPixelBufferRef const)pixelBuffer videoStorage:(ECVVideoStorage *const)storage; // Already cropped and scaled by an encoder, to be scaled again for a proxy.
 
 @end
 
-static OSStatus ECVCompressionDelegateHandler(id<ECVCompressionDelegate> const movieRecorder, ICMCompressionSessionRef const session, OSStatus const error, ICMEncodedFrameRef const frame)
+@interface ECVMovieRecorder(ECVEncoderContext)
+
+- (void)addEncodedFrame:(id const)frame context:(ECVEncoderContext *const)context; // Either an ICMEncodedFrameRef or lossless NSData.
+
+@end
+
+static OSStatus ECVEncodedFrameOutputHandler(ECVEncoderContext *const context, ICMCompressionSessionRef const session, OSStatus const error, ICMEncodedFrameRef const frame)
 {
-	[movieRecorder addEncodedFrame:noErr == error ? frame : NULL];
+	[context->recorder addEncodedFrame:noErr == error ? (id)frame : nil context:context];
 	return noErr;
 }
 
@@ -67,6 +161,17 @@ static OSStatus ECVCompressionDelegateHandler(id<ECVCompressionDelegate> const m
 @synthesize cropRect = _cropRect;
 @synthesize upconvertsFromMono = _upconvertsFromMono;
 @synthesize frameRate = _frameRate;
+@synthesize overflowPolicy = _overflowPolicy;
+@synthesize encoderCount = _encoderCount;
+@synthesize segmentDuration = _segmentDuration;
+@synthesize segmentSize = _segmentSize;
+@synthesize splitsOnRequest = _splitsOnRequest;
+@synthesize unchangedFrameThreshold = _unchangedFrameThreshold;
+@synthesize scalesInCodec = _scalesInCodec;
+@synthesize scalingFilter = _scalingFilter;
+@synthesize proxies = _proxies;
+@synthesize adaptsQuality = _adaptsQuality;
+@synthesize bufferSize = _bufferSize;
 
 #pragma mark -
 
@@ -93,38 +198,95 @@ static OSStatus ECVCompressionDelegateHandler(id<ECVCompressionDelegate> const m
 {
 	return [[[ECVFrameRateConverter alloc] initWithSourceFrameRate:[[_videoStorage videoFormat] frameRate] targetFrameRate:_frameRate] autorelease];
 }
+- (BOOL)_isLossless
+{
+	return ECVLosslessCodecType == _videoCodec;
+}
 - (ECVIntegerSize)_outputSize
 {
-	return _stretchOutput ? _outputSize : [[_videoStorage videoFormat] frameSize];
+	return _stretchOutput && ![self _isLossless] ? _outputSize : [[_videoStorage videoFormat] frameSize]; // Lossless frames are stored as captured.
+}
+- (ImageDescriptionHandle)_losslessImageDescription
+{
+	ECVIntegerSize const size = [[_videoStorage videoFormat] frameSize];
+	ImageDescriptionHandle const desc = (ImageDescriptionHandle)NewHandleClear(sizeof(ImageDescription));
+	if(!desc) return NULL;
+	(**desc).idSize = sizeof(ImageDescription);
+	(**desc).cType = ECVLosslessCodecType;
+	(**desc).temporalQuality = codecLosslessQuality;
+	(**desc).spatialQuality = codecLosslessQuality;
+	(**desc).width = (short)size.width;
+	(**desc).height = (short)size.height;
+	(**desc).hRes = Long2Fix(72);
+	(**desc).vRes = Long2Fix(72);
+	(**desc).frameCount = 1;
+	(**desc).depth = 24;
+	(**desc).clutID = -1;
+	return desc;
+}
+- (NSUInteger)_encoderCount
+{
+	NSUInteger const count = _encoderCount ? _encoderCount : [[NSProcessInfo processInfo] activeProcessorCount];
+	return MIN(MAX(count, 1), ECVMovieRecorderMaxEncoderCount);
 }
-- (ICMCompressionSessionRef)_compressionSessionWithDelegate:(id<ECVCompressionDelegate> const)delegate
+- (BOOL)_isSegmented
 {
+	return _segmentDuration > 0.0 || _segmentSize || _splitsOnRequest;
+}
+- (NSRect)_cropRectInPixels
+{
+	NSRect const c = [self cropRect];
+	ECVIntegerSize const s = [[_videoStorage videoFormat] frameSize];
+	return NSMakeRect(NSMinX(c) * s.width, NSMinY(c) * s.height, NSWidth(c) * s.width, NSHeight(c) * s.height);
+}
+- (NSURL *)_URLForSegment:(NSUInteger const)index
+{
+	if(![self _isSegmented]) return _URL;
+	NSString *const path = [_URL path];
+	NSString *const name = [NSString stringWithFormat:@"%@ %03lu", [[path lastPathComponent] stringByDeletingPathExtension], (unsigned long)index + 1];
+	return [NSURL fileURLWithPath:[[[path stringByDeletingLastPathComponent] stringByAppendingPathComponent:name] stringByAppendingPathExtension:[path pathExtension]]];
+}
+- (ICMCompressionSessionRef)_compressionSessionWithContext:(ECVEncoderContext *const)context qualityLevel:(NSUInteger const)level
+{
+	if([self _isLossless]) return NULL;
 	ICMCompressionSessionOptionsRef opts = NULL;
 	ECVOSStatus(ICMCompressionSessionOptionsCreate(kCFAllocatorDefault, &opts));
 
 	ECVICMCSOSetProperty(opts, DurationsNeeded, (Boolean)true);
 	ECVICMCSOSetProperty(opts, AllowAsyncCompletion, (Boolean)true);
+	ECVICMCSOSetProperty(opts, AllowTemporalCompression, (Boolean)false); // Each session only sees every Nth frame.
+	ECVICMCSOSetProperty(opts, AllowFrameReordering, (Boolean)false);
 	NSTimeInterval frameRateInterval = 0.0;
 	if(QTGetTimeInterval(_frameRate, &frameRateInterval)) ECVICMCSOSetProperty(opts, ExpectedFrameRate, X2Fix(1.0 / frameRateInterval));
 	ECVICMCSOSetProperty(opts, CPUTimeBudget, (UInt32)QTMakeTimeScaled(_frameRate, ECVMicrosecondsPerSecond).timeValue);
-	ECVICMCSOSetProperty(opts, ScalingMode, (OSType)kICMScalingMode_StretchCleanAperture);
-	ECVICMCSOSetProperty(opts, Quality, (CodecQ)round([self videoQuality] * codecMaxQuality));
+	if(_scalesInCodec) ECVICMCSOSetProperty(opts, ScalingMode, (OSType)kICMScalingMode_StretchCleanAperture);
+	ECVICMCSOSetProperty(opts, Quality, (CodecQ)round([self videoQuality] * ECVQualityLevels[level].quality * codecMaxQuality));
 	ECVICMCSOSetProperty(opts, Depth, [_videoStorage pixelFormat]);
 	ICMEncodedFrameOutputRecord callback = {};
 	callback.frameDataAllocator = kCFAllocatorDefault;
-	callback.encodedFrameOutputCallback = (ICMEncodedFrameOutputCallback)ECVCompressionDelegateHandler;
-	callback.encodedFrameOutputRefCon = delegate;
-
-	ECVIntegerSize const frameSize = [[_videoStorage videoFormat] frameSize];
-	ICMCompressionSessionRef compressionSession = NULL;
-	ECVOSStatus(ICMCompressionSessionCreate(kCFAllocatorDefault, _outputSize.width, _outputSize.height, [self videoCodec], _frameRate.timeScale, opts, (CFDictionaryRef)[NSDictionary dictionaryWithObjectsAndKeys:
-		[NSNumber numberWithUnsignedInteger:frameSize.width], kCVPixelBufferWidthKey,
-		[NSNumber numberWithUnsignedInteger:frameSize.height], kCVPixelBufferHeightKey,
+	callback.encodedFrameOutputCallback = (ICMEncodedFrameOutputCallback)ECVEncodedFrameOutputHandler;
+	callback.encodedFrameOutputRefCon = context;
+
+	CGFloat const scale = ECVQualityLevels[level].scale;
+	ECVIntegerSize const outputSize = {round(_outputSize.width * scale / 2.0) * 2.0, round(_outputSize.height * scale / 2.0) * 2.0};
+	NSDictionary *attributes = nil;
+	if(_scalesInCodec) {
+		ECVIntegerSize const frameSize = [[_videoStorage videoFormat] frameSize];
+		attributes = [NSDictionary dictionaryWithObjectsAndKeys:
+			[NSNumber numberWithUnsignedInteger:frameSize.width], kCVPixelBufferWidthKey,
+			[NSNumber numberWithUnsignedInteger:frameSize.height], kCVPixelBufferHeightKey,
+			[NSNumber numberWithUnsignedInt:[_videoStorage pixelFormat]], kCVPixelBufferPixelFormatTypeKey,
+			[NSDictionary dictionaryWithObjectsAndKeys:
+				[self cleanAperatureDictionary], kCVImageBufferCleanApertureKey,
+				nil], kCVBufferNonPropagatedAttachmentsKey,
+			nil];
+	} else attributes = [NSDictionary dictionaryWithObjectsAndKeys:
+		[NSNumber numberWithUnsignedInteger:outputSize.width], kCVPixelBufferWidthKey,
+		[NSNumber numberWithUnsignedInteger:outputSize.height], kCVPixelBufferHeightKey,
 		[NSNumber numberWithUnsignedInt:[_videoStorage pixelFormat]], kCVPixelBufferPixelFormatTypeKey,
-		[NSDictionary dictionaryWithObjectsAndKeys:
-			[self cleanAperatureDictionary], kCVImageBufferCleanApertureKey,
-			nil], kCVBufferNonPropagatedAttachmentsKey,
-		nil], &callback, &compressionSession));
+		nil]; // Already cropped and scaled, so the codec can take it as is.
+	ICMCompressionSessionRef compressionSession = NULL;
+	ECVOSStatus(ICMCompressionSessionCreate(kCFAllocatorDefault, outputSize.width, outputSize.height, [self videoCodec], _frameRate.timeScale, opts, (CFDictionaryRef)attributes, &callback, &compressionSession));
 
 	ICMCompressionSessionOptionsRelease(opts);
 	return compressionSession;
@@ -147,6 +309,7 @@ static OSStatus ECVCompressionDelegateHandler(id<ECVCompressionDelegate> const m
 		_videoQuality = 0.5f;
 		_stretchOutput = YES;
 		_cropRect = ECVUncroppedRect;
+		_scalingFilter = ECVScaleArea;
 
 		_volume = 1.0f;
 	}
@@ -157,6 +320,7 @@ static OSStatus ECVCompressionDelegateHandler(id<ECVCompressionDelegate> const m
 	[_URL release];
 	[_videoStorage release];
 	[_audioInput release];
+	[_proxies release];
 	[super dealloc];
 }
 
@@ -168,13 +332,33 @@ enum {
 	ECVThreadFinished,
 };
 
-@interface ECVMovieRecorder(Private)<ECVCompressionDelegate>
+@interface ECVMovieRecorder(Private)
 
 - (void)_thread_compress:(ECVMovieRecordingOptions *const)options;
 - (void)_thread_record:(ECVMovieRecordingOptions *const)options;
 
-- (void)_addEncodedFrame:(ICMEncodedFrameRef const)frame frameRateConverter:(ECVFrameRateConverter *const)frameRateConverter media:(Media const)media;
-- (void)_addAudioBufferFromPipe:(ECVAudioPipe *const)audioPipe description:(SoundDescriptionHandle const)description buffer:(void *const)buffer media:(Media const)media;
+- (BOOL)_openSegment:(ECVMovieSegment *const)segment index:(NSUInteger const)index options:(ECVMovieRecordingOptions *const)options;
+- (void)_openSegmentInBackground:(ECVMovieSegment *const)segment index:(NSUInteger const)index options:(ECVMovieRecordingOptions *const)options group:(dispatch_group_t const)group;
+- (BOOL)_segment:(ECVMovieSegment const *const)segment isCompleteBeforeFrame:(id const)frame options:(ECVMovieRecordingOptions *const)options;
+- (void)_closeSegment:(ECVMovieSegment *const)segment audioOffset:(NSTimeInterval const)audioOffset;
+- (void)_finishSegment:(ECVMovieSegment *const)segment index:(NSUInteger const)index;
+- (void)_discardSegment:(ECVMovieSegment *const)segment;
+- (NSTimeInterval)_audioOffsetForSegment:(ECVMovieSegment const *const)segment;
+
+- (void)_addVideoFrame:(ECVVideoFrame *const)frame unchanged:(BOOL const)unchanged;
+- (BOOL)_isUnchangedFrame:(ECVVideoFrame *const)frame;
+- (void)_updateQualityWithEncodeTime:(NSTimeInterval const)encodeTime;
+- (void)_logQualityForSegment:(ECVMovieSegment const *const)segment index:(NSUInteger const)index;
+- (void)_deliverEncodedFrame:(id const)frame qualityLevel:(NSUInteger const)level presentationTime:(NSTimeInterval const)time;
+- (void)_signalRecordSpace;
+- (void)_requestSegmentBreak;
+- (void)_signalCompressSpace;
+- (void)_deliverConvertedFrame:(ECVVideoFrame *const)frame repeatCount:(NSUInteger const)count;
+- (NSTimeInterval)_compressTimePerFrame;
+- (void)_addVideoSample:(id const)frame count:(NSUInteger const)count description:(ImageDescriptionHandle const)description duration:(TimeValue64 const)duration segment:(ECVMovieSegment *const)segment;
+- (ByteCount)_addEncodedFrame:(ICMEncodedFrameRef const)frame count:(NSUInteger const)count media:(Media const)media;
+- (ByteCount)_addLosslessFrame:(NSData *const)data description:(ImageDescriptionHandle const)description duration:(TimeValue64 const)duration count:(NSUInteger const)count media:(Media const)media;
+- (ByteCount)_addAudioBufferFromPipe:(ECVAudioPipe *const)audioPipe description:(SoundDescriptionHandle const)description buffer:(void *const)buffer media:(Media const)media;
 
 @end
 
@@ -194,13 +378,59 @@ enum {
 	if(outError) *outError = nil;
 	if(!(self = [super init])) return nil;
 
+	NSMutableArray *const proxyRecorders = [NSMutableArray array];
+	NSMutableArray *const independentProxyRecorders = [NSMutableArray array];
+	BOOL const converts = ![options _isLossless] && ![options scalesInCodec] && ![options adaptsQuality]; // Adapting shrinks our frames below the proxy's size mid-recording.
+	ECVIntegerSize const outputSize = [options _outputSize];
+	for(ECVMovieRecordingOptions *const proxyOptions in [options proxies]) {
+		ECVMovieRecorder *const proxy = [[[ECVMovieRecorder alloc] initWithOptions:proxyOptions error:outError] autorelease];
+		if(!proxy) {
+			[proxyRecorders makeObjectsPerformSelector:@selector(stopRecording)];
+			[independentProxyRecorders makeObjectsPerformSelector:@selector(stopRecording)];
+			[self release];
+			return nil;
+		}
+		ECVIntegerSize const proxySize = [proxyOptions _outputSize];
+		BOOL const shares = converts && ![proxyOptions _isLossless] && ![proxyOptions scalesInCodec] && proxySize.width <= outputSize.width && proxySize.height <= outputSize.height;
+		[shares ? proxyRecorders : independentProxyRecorders addObject:proxy];
+	}
+	_proxyRecorders = [proxyRecorders copy];
+	_independentProxyRecorders = [independentProxyRecorders copy];
+
 	_compressLock = [[NSConditionLock alloc] initWithCondition:ECVThreadWait];
-	_compressQueue = [[NSMutableArray alloc] init];
+	ECVObjectQueueCreate(&_compressQueue, ECVMovieRecorderCompressQueueCapacity);
+	_overflowPolicy = [options overflowPolicy];
+	_encoderCount = [options _encoderCount];
+	_activeEncoderCount = _encoderCount;
+	_reorderLock = [[NSCondition alloc] init];
+	_segmentBreakSequence = NSNotFound;
+	_segmentBreakFrameCount = NSNotFound;
+	CMTime const sourceFrameRate = [[[options videoStorage] videoFormat] frameRate];
+	_frameDuration = sourceFrameRate.timescale ? (NSTimeInterval)sourceFrameRate.value / sourceFrameRate.timescale : 0.0;
 	_recordLock = [[NSConditionLock alloc] initWithCondition:ECVThreadWait];
-	_recordQueue = [[NSMutableArray alloc] init];
+	NSUInteger const recordQueueCapacity = MAX(_frameDuration ? (NSUInteger)ceil(ECVMovieRecorderRecordQueueDuration / _frameDuration) : 0, ECVMovieRecorderRecordQueueMinCapacity);
+	ECVObjectQueueCreate(&_recordQueue, recordQueueCapacity);
+	_recordQualityLevels = calloc(recordQueueCapacity, sizeof(NSUInteger));
+	_recordPresentationTimes = calloc(recordQueueCapacity, sizeof(NSTimeInterval));
+	_recordByteCounts = calloc(recordQueueCapacity, sizeof(size_t));
+	_recordBufferSize = [options bufferSize];
+	_recordSpaceCondition = [[NSCondition alloc] init];
+	_compressSpaceCondition = [[NSCondition alloc] init];
 	_audioPipe = [[options _audioPipe] retain];
+	_adaptsQuality = [options adaptsQuality] && ![options _isLossless];
+	_scalesInCodec = [options scalesInCodec];
+	_unchangedFrameThreshold = [options unchangedFrameThreshold];
+	if(_unchangedFrameThreshold > 0.0) {
+		ECVVideoFormat *const format = [[options videoStorage] videoFormat];
+		_lumaSize = ECVDecimatedLumaSize([format frameSize]);
+		_referenceLuma = malloc(_lumaSize.width * _lumaSize.height);
+		_currentLuma = malloc(_lumaSize.width * _lumaSize.height);
+		CMTime const frameRate = [format frameRate];
+		_maxUnchangedRunLength = MAX(frameRate.value ? (NSUInteger)round((double)frameRate.timescale / frameRate.value) : 0, 1); // Encode at least once a second, so segments can still switch.
+	}
 
-	[NSThread detachNewThreadSelector:@selector(_thread_compress:) toTarget:self withObject:options];
+	NSUInteger i = 0;
+	for(; i < _encoderCount; i++) [NSThread detachNewThreadSelector:@selector(_thread_compress:) toTarget:self withObject:options];
 	[NSThread detachNewThreadSelector:@selector(_thread_record:) toTarget:self withObject:options];
 
 	return self;
@@ -210,15 +440,16 @@ enum {
 
 - (void)addVideoFrame:(ECVVideoFrame *const)frame
 {
-	[_compressLock lock];
-	if(ECVThreadFinished == [_compressLock condition]) return [_compressLock unlock];
-	[_compressQueue insertObject:frame atIndex:0];
-	[_compressLock unlockWithCondition:ECVThreadRun];
+	[self _addVideoFrame:frame unchanged:_unchangedFrameThreshold > 0.0 && [self _isUnchangedFrame:frame]];
+	for(ECVMovieRecorder *const proxy in _independentProxyRecorders) [proxy addVideoFrame:frame];
 }
-- (void)addAudioBufferList:(AudioBufferList const *const)bufferList
+- (void)addAudioBufferList:(AudioBufferList const *const)bufferList presentationTime:(NSTimeInterval const)time
 {
+	for(ECVMovieRecorder *const proxy in _proxyRecorders) [proxy addAudioBufferList:bufferList presentationTime:time];
+	for(ECVMovieRecorder *const proxy in _independentProxyRecorders) [proxy addAudioBufferList:bufferList presentationTime:time];
 	[_recordLock lock];
 	if(ECVThreadFinished == [_recordLock condition]) return [_recordLock unlock];
+	if(!_audioStartTime) _audioStartTime = time;
 	[_audioPipe receiveInputBufferList:bufferList];
 	[_recordLock unlockWithCondition:ECVThreadRun];
 }
@@ -239,6 +470,137 @@ enum {
 	[_compressLock unlockWithCondition:ECVThreadRun];
 	[_recordLock lockWhenCondition:ECVThreadFinished];
 	[_recordLock unlock];
+	[_compressLock lock];
+	if(_unchangedFrameThreshold > 0.0) ECVLog(ECVNotice, @"%lu unchanged frames were repeated instead of encoded, saving about %.1f s of encoder time. Detection took %.3f ms per frame.", (unsigned long)_unchangedFrameCount, _encodedFrameCount ? _unchangedFrameCount * _encodeTime / _encodedFrameCount : 0.0, _detectionCount ? _detectionTime / _detectionCount * 1000.0 : 0.0);
+	if(_convertTime) ECVLog(ECVNotice, @"Compress threads took %.3f ms per frame, %.3f ms of it to %@.", _encodeTime / _encodedFrameCount * 1000.0, _convertTime / _encodedFrameCount * 1000.0, _scalesInCodec ? @"copy whole frames for the codec to crop and scale" : @"crop and scale frames");
+	if(_losslessInputLength && _losslessEncodeTime) ECVLog(ECVNotice, @"Lossless encoding: %.2fx at %.1f MB/s per encoder.", (double)_losslessInputLength / _losslessOutputLength, _losslessInputLength / _losslessEncodeTime / 1.0e6);
+	[_compressLock unlock];
+	ECVLog(ECVNotice, @"Recording stopped (%lu encoders): %lu frames dropped, %lu repeated because the encoder fell behind.", (unsigned long)_encoderCount, (unsigned long)[self droppedFrameCount], (unsigned long)[self repeatedFrameCount]);
+
+	// Every converted frame has been handed over by now.
+	NSTimeInterval const compressTime = [self _compressTimePerFrame];
+	for(ECVMovieRecorder *const proxy in [_proxyRecorders arrayByAddingObjectsFromArray:_independentProxyRecorders]) {
+		[proxy stopRecording];
+		NSTimeInterval const proxyCompressTime = [proxy _compressTimePerFrame];
+		ECVLog(ECVNotice, @"Proxy %@ took %.3f ms of compress time per frame, %.0f%% of the main recording's.", [_proxyRecorders containsObject:proxy] ? @"sharing our conversion" : @"converting on its own", proxyCompressTime * 1000.0, compressTime ? proxyCompressTime / compressTime * 100.0 : 0.0);
+	}
+}
+- (void)closeSegment
+{
+	// Frames still queued or being encoded belong to this segment, so the break goes in after the last sequence number handed out.
+	[_compressLock lock];
+	[_reorderLock lock];
+	[_recordLock lock];
+	NSUInteger const breakCount = _segmentBreakCount + 1;
+	[_recordLock unlock];
+	_segmentBreakSequence = _sequenceNumber + _compressQueue.count;
+	if(_nextSequenceNumber == _segmentBreakSequence) [self _requestSegmentBreak]; // Everything's already on the record queue.
+	[_reorderLock unlock];
+	[_compressLock unlock];
+
+	for(;;) {
+		[_recordSpaceCondition lock];
+		NSUInteger const popCount = _recordPopCount;
+		[_recordSpaceCondition unlock];
+		[_recordLock lock];
+		BOOL const closed = _segmentBreakCount >= breakCount || ECVThreadFinished == [_recordLock condition];
+		[_recordLock unlock];
+		if(closed) break;
+		[_recordSpaceCondition lock];
+		while(popCount == _recordPopCount) [_recordSpaceCondition wait];
+		[_recordSpaceCondition unlock];
+	}
+	for(ECVMovieRecorder *const proxy in [_proxyRecorders arrayByAddingObjectsFromArray:_independentProxyRecorders]) [proxy closeSegment]; // Shared frames were handed over before our break.
+}
+
+#pragma mark -
+
+- (BOOL)isReadyForMoreVideoFrames
+{
+	return [self compressQueueDepth] < ECVMovieRecorderCompressQueueCapacity;
+}
+- (BOOL)waitUntilReadyForMoreVideoFramesBeforeDate:(NSDate *const)date
+{
+	[_compressSpaceCondition lock];
+	BOOL ready = NO;
+	while(!(ready = [self isReadyForMoreVideoFrames]) && [_compressSpaceCondition waitUntilDate:date]);
+	[_compressSpaceCondition unlock];
+	return ready;
+}
+
+#pragma mark -
+
+- (NSUInteger)compressQueueDepth
+{
+	[_compressLock lock];
+	NSUInteger const count = _compressQueue.count;
+	[_compressLock unlock];
+	return count;
+}
+- (NSUInteger)reorderDepth
+{
+	[_reorderLock lock];
+	NSUInteger count = 0;
+	NSUInteger i = 0;
+	for(; i < ECVMovieRecorderReorderCapacity; i++) if(_reorderFilled[i]) count++;
+	[_reorderLock unlock];
+	return count;
+}
+- (NSUInteger)recordQueueDepth
+{
+	[_recordLock lock];
+	NSUInteger const count = _recordQueue.count;
+	[_recordLock unlock];
+	return count;
+}
+- (unsigned long long)recordQueueHighWaterMark
+{
+	[_recordLock lock];
+	unsigned long long const length = _recordHighWaterMark;
+	[_recordLock unlock];
+	return length;
+}
+- (NSUInteger)droppedFrameCount
+{
+	[_compressLock lock];
+	NSUInteger const count = _droppedFrameCount;
+	[_compressLock unlock];
+	return count;
+}
+- (NSUInteger)unchangedFrameCount
+{
+	[_compressLock lock];
+	NSUInteger const count = _unchangedFrameCount;
+	[_compressLock unlock];
+	return count;
+}
+- (NSUInteger)repeatedFrameCount
+{
+	[_compressLock lock];
+	NSUInteger const count = _repeatedFrameCount;
+	[_compressLock unlock];
+	return count;
+}
+- (NSTimeInterval)encoderLag
+{
+	[_compressLock lock];
+	NSTimeInterval const lag = _encoderLag;
+	[_compressLock unlock];
+	return lag;
+}
+- (NSUInteger)qualityLevel
+{
+	[_compressLock lock];
+	NSUInteger const level = _qualityLevel;
+	[_compressLock unlock];
+	return level;
+}
+- (NSUInteger)segmentCount
+{
+	[_recordLock lock];
+	NSUInteger const count = _segmentCount;
+	[_recordLock unlock];
+	return count;
 }
 
 #pragma mark -ECVMovieRecorder(Private)
@@ -248,30 +610,94 @@ enum {
 	NSAutoreleasePool *const outerPool = [[NSAutoreleasePool alloc] init];
 	ECVOSErr(EnterMoviesOnThread(kNilOptions));
 
-	ICMCompressionSessionRef const compressionSession = [options _compressionSessionWithDelegate:self];
+	ECVEncoderContext context = {self};
+	NSUInteger sessionLevel = 0;
+	ICMCompressionSessionRef compressionSession = [options _compressionSessionWithContext:&context qualityLevel:sessionLevel];
+	BOOL const lossless = [options _isLossless];
+	NSRect const cropRect = [options _cropRectInPixels];
+	BOOL const sharesFrames = !![_proxyRecorders count];
 	CVPixelBufferRef pixelBuffer = NULL;
-	ECVCVReturn(CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, ICMCompressionSessionGetPixelBufferPool(compressionSession), &pixelBuffer));
+	ECVPixelBufferScaler *const scaler = [[ECVPixelBufferScaler alloc] initWithFilter:[options scalingFilter]]; // The filter tables only depend on the geometry, so build them once per encoder.
+	if(!lossless) ECVCVReturn(CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, ICMCompressionSessionGetPixelBufferPool(compressionSession), &pixelBuffer));
 
 	for(;;) {
 		NSAutoreleasePool *const innerPool = [[NSAutoreleasePool alloc] init];
 
 		[_compressLock lockWhenCondition:ECVThreadRun];
-		ECVVideoFrame *const frame = [[[_compressQueue lastObject] retain] autorelease];
-		if(frame) [_compressQueue removeLastObject];
-		BOOL const remaining = !![_compressQueue count];
+		NSUInteger const slot = _compressQueue.start;
+		id const item = ECVObjectQueuePop(&_compressQueue);
+		ECVVideoFrame *const frame = [NSNull null] == item ? nil : item;
+		if(item) {
+			context.sequenceNumber = _sequenceNumber++;
+			context.repeatCount = _compressRepeatCounts[slot];
+			context.qualityLevel = sessionLevel;
+			context.presentationTime = [frame presentationTime];
+			context.delivered = NO;
+			context.convertedFrame = nil;
+			_compressRepeatCounts[slot] = 0;
+		}
+		BOOL const remaining = !!_compressQueue.count;
 		BOOL const stop = _stop;
-		[_compressLock unlockWithCondition:remaining ? ECVThreadRun : ECVThreadWait];
-
-		if([frame lockIfHasBytes]) {
+		NSUInteger const qualityLevel = _qualityLevel;
+		if([frame presentationTime]) _encoderLag = [NSDate ECV_timeIntervalSinceReferenceDate] - [frame presentationTime];
+		[_compressLock unlockWithCondition:remaining || stop ? ECVThreadRun : ECVThreadWait]; // Once stopping, keep waking the other encoders so they can exit too.
+		if(item) [self _signalCompressSpace];
+
+		NSTimeInterval const startTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+		if(lossless && [frame lockIfHasBytes]) {
+			NSData *const data = ECVLosslessEncodePixelBuffer(frame);
+			NSTimeInterval const encodeTime = [NSDate ECV_timeIntervalSinceReferenceDate] - startTime;
+			size_t const inputLength = [frame bytesPerRow] * [frame pixelSize].height;
+			[frame unlock];
+			[_compressLock lock];
+			_losslessInputLength += inputLength;
+			_losslessOutputLength += [data length];
+			_losslessEncodeTime += encodeTime;
+			_encodeTime += encodeTime;
+			_encodedFrameCount++;
+			[_compressLock unlock];
+			if(data) [self addEncodedFrame:data context:&context];
+		} else if([frame lockIfHasBytes]) {
+			if(qualityLevel != sessionLevel) {
+				// Sessions don't take new settings once created, but they're intra-only, so a fresh one can pick up mid-stream.
+				if(compressionSession) ICMCompressionSessionRelease(compressionSession);
+				if(pixelBuffer) CVPixelBufferRelease(pixelBuffer);
+				pixelBuffer = NULL;
+				sessionLevel = qualityLevel;
+				compressionSession = [options _compressionSessionWithContext:&context qualityLevel:sessionLevel];
+				ECVCVReturn(CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, ICMCompressionSessionGetPixelBufferPool(compressionSession), &pixelBuffer));
+			}
+			context.qualityLevel = sessionLevel;
 			ECVCVPixelBuffer *const buffer = [[[ECVCVPixelBuffer alloc] initWithPixelBuffer:pixelBuffer] autorelease];
 			[buffer lock];
-			[buffer drawPixelBuffer:frame];
+			if([frame isKindOfClass:[ECVConvertedFrame class]]) [buffer drawPixelBuffer:frame fromRect:NSMakeRect(0.0, 0.0, [frame pixelSize].width, [frame pixelSize].height) scaler:scaler]; // Already cropped.
+			else if(_scalesInCodec) [buffer drawPixelBuffer:frame];
+			else [buffer drawPixelBuffer:frame fromRect:cropRect scaler:scaler];
 			[buffer unlock];
 			[frame unlock];
+			if(sharesFrames) {
+				ECVConvertedFrame *const convertedFrame = [[[ECVConvertedFrame alloc] initWithPixelBuffer:pixelBuffer videoStorage:[frame videoStorage]] autorelease];
+				[convertedFrame setPresentationTime:[frame presentationTime]];
+				context.convertedFrame = convertedFrame;
+			}
+			NSTimeInterval const convertTime = [NSDate ECV_timeIntervalSinceReferenceDate] - startTime;
 			ECVOSStatus(ICMCompressionSessionEncodeFrame(compressionSession, pixelBuffer, 0, [options frameRate].timeValue, kICMValidTime_DisplayDurationIsValid, NULL, NULL, NULL));
-		} else if(frame) {
-			[self addEncodedFrame:NULL];
+			if(compressionSession) ECVOSStatus(ICMCompressionSessionCompleteFrames(compressionSession, true, 0, 0)); // Keep one frame in flight per encoder so the reorder window stays bounded.
+			if(sharesFrames) {
+				// The proxies hold on to this buffer until they've scaled it, so draw the next frame into another one from the pool.
+				CVPixelBufferRelease(pixelBuffer);
+				pixelBuffer = NULL;
+				ECVCVReturn(CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, ICMCompressionSessionGetPixelBufferPool(compressionSession), &pixelBuffer));
+			}
+			NSTimeInterval const encodeTime = [NSDate ECV_timeIntervalSinceReferenceDate] - startTime;
+			[_compressLock lock];
+			_encodeTime += encodeTime;
+			_convertTime += convertTime;
+			_encodedFrameCount++;
+			[self _updateQualityWithEncodeTime:encodeTime];
+			[_compressLock unlock];
 		}
+		if(item && !context.delivered) [self addEncodedFrame:nil context:&context];
 
 		if(stop && !remaining) {
 			[innerPool drain];
@@ -281,15 +707,26 @@ enum {
 		[innerPool release];
 	}
 
-	if(compressionSession) ECVOSStatus(ICMCompressionSessionCompleteFrames(compressionSession, true, 0, 0));
 	if(compressionSession) ICMCompressionSessionRelease(compressionSession);
-	CVPixelBufferRelease(pixelBuffer);
-
-	ICMEncodedFrameRelease(_encodedFrame);
-	_encodedFrame = NULL;
+	if(pixelBuffer) CVPixelBufferRelease(pixelBuffer);
+	[scaler release];
 
 	[_compressLock lock];
-	[_compressLock unlockWithCondition:ECVThreadFinished];
+	BOOL const last = !--_activeEncoderCount;
+	if(!last) {
+		[_compressLock unlockWithCondition:ECVThreadRun];
+	} else {
+		// Every encoder has handed over its frames, so the reorder buffer is empty.
+		[_encodedFrame release];
+		_encodedFrame = nil;
+
+		[_recordLock lock];
+		_compressFinished = YES;
+		[_recordLock unlockWithCondition:ECVThreadRun];
+
+		[_compressLock unlockWithCondition:ECVThreadFinished];
+		[self _signalCompressSpace];
+	}
 
 	ECVOSErr(ExitMoviesOnThread());
 	[outerPool release];
@@ -299,48 +736,107 @@ enum {
 	NSAutoreleasePool *const outerPool = [[NSAutoreleasePool alloc] init];
 	ECVOSErr(EnterMoviesOnThread(kNilOptions));
 
-	Handle dataRef = NULL;
-	OSType dataRefType = 0;
-
-	Movie movie = NULL;
-	DataHandler dataHandler = NULL;
-	ECVOSErr(QTNewDataReferenceFromCFURL((CFURLRef)[options URL], kNilOptions, &dataRef, &dataRefType));
-	ECVOSErr(CreateMovieStorage(dataRef, dataRefType, 'TVOD', smSystemScript, createMovieFileDeleteCurFile, &dataHandler, &movie));
-
-	if(!movie) {
-		ECVLog(ECVError, @"Movie could not be created.");
-		goto bail;
-	}
-
-	ECVIntegerSize const outputSize = [options _outputSize];
-	ECVVideoStorage *const videoStorage = [options videoStorage];
-	ECVFrameRateConverter *const frameRateConverter = [options _frameRateConverter];
-
-	Track const videoTrack = NewMovieTrack(movie, Long2Fix(outputSize.width), Long2Fix(outputSize.height), kNoVolume);
-	Media const videoMedia = NewTrackMedia(videoTrack, VideoMediaType, [options frameRate].timeScale, NULL, 0);
-	ECVOSErr(BeginMediaEdits(videoMedia));
+	BOOL const segmented = [options _isSegmented];
+	NSUInteger segmentIndex = 0;
+	ECVMovieSegment segment = {};
+	ECVMovieSegment nextSegment = {};
+	if(![self _openSegment:&segment index:segmentIndex++ options:options]) goto bail;
+	NSUInteger closedSegmentCount = 0;
+	[_recordLock lock];
+	_segmentCount = 1;
+	[_recordLock unlock];
+	dispatch_group_t const segmentGroup = segmented ? dispatch_group_create() : NULL;
+	if(segmented) [self _openSegmentInBackground:&nextSegment index:segmentIndex++ options:options group:segmentGroup]; // Have the next file ready before it's needed, so switching doesn't stall.
 
-	Track const audioTrack = _audioPipe ? NewMovieTrack(movie, 0, 0, (short)round([options volume] * kFullVolume)) : NULL;
-	Media const audioMedia = audioTrack ? NewTrackMedia(audioTrack, SoundMediaType, ECVStandardAudioStreamBasicDescription.mSampleRate, NULL, 0) : NULL;
+	ECVFrameRateConverter *frameRateConverter = [[options _frameRateConverter] retain];
+	ImageDescriptionHandle const losslessDescription = [options _isLossless] ? [options _losslessImageDescription] : NULL;
 	SoundDescriptionHandle soundDescription = NULL;
-	void *const audioBuffer = audioMedia ? malloc(ECVAudioBufferBytesSize) : NULL;
-	if(audioMedia) {
-		ECVOSErr(BeginMediaEdits(audioMedia));
-		ECVOSStatus(QTSoundDescriptionCreate((AudioStreamBasicDescription *)&ECVStandardAudioStreamBasicDescription, NULL, 0, NULL, 0, kQTSoundDescriptionKind_Movie_AnyVersion, &soundDescription));
-	}
+	void *const audioBuffer = segment.audioMedia ? malloc(ECVAudioBufferBytesSize) : NULL;
+	if(segment.audioMedia) ECVOSStatus(QTSoundDescriptionCreate((AudioStreamBasicDescription *)&ECVStandardAudioStreamBasicDescription, NULL, 0, NULL, 0, kQTSoundDescriptionKind_Movie_AnyVersion, &soundDescription));
+	TimeValue64 const frameDuration = [options frameRate].timeValue;
+	NSUInteger frameCount = 0;
+	unsigned long long audioFrameCount = 0;
+	id heldFrame = nil; // Repeats of a frame are held back and written as one longer sample.
+	NSUInteger heldCount = 0;
 
 	for(;;) {
 		NSAutoreleasePool *const innerPool = [[NSAutoreleasePool alloc] init];
 
 		[_recordLock lockWhenCondition:ECVThreadRun];
-		ICMEncodedFrameRef const frame = (ICMEncodedFrameRef)[[[_recordQueue lastObject] retain] autorelease];
-		if(frame) [_recordQueue removeLastObject];
-		BOOL const remaining = [_recordQueue count] || [_audioPipe hasReadyBuffers];
-		BOOL const stop = _stop;
+		NSUInteger const qualityLevel = _recordQualityLevels[_recordQueue.start];
+		NSTimeInterval const presentationTime = _recordPresentationTimes[_recordQueue.start];
+		BOOL const segmentBreak = frameCount == _segmentBreakFrameCount; // Before taking the next frame, which belongs to the next segment.
+		if(segmentBreak) _segmentBreakFrameCount = NSNotFound;
+		if(_recordQueue.count) _recordByteCount -= _recordByteCounts[_recordQueue.start];
+		id const frame = ECVObjectQueuePop(&_recordQueue);
+		BOOL const remaining = _recordQueue.count || (segment.movie && [_audioPipe hasReadyBuffers]); // Between segments, audio waits for the next frame to open one.
+		BOOL const stop = _stop && _compressFinished; // Keep draining until the encoder has flushed everything.
 		[_recordLock unlockWithCondition:remaining ? ECVThreadRun : ECVThreadWait];
+		if(frame) [self _signalRecordSpace];
+
+		if(segmentBreak) {
+			if(segmented && segment.movie) { // Unsegmented files can't be reopened without overwriting them, so they just keep going.
+				[self _addVideoSample:heldFrame count:heldCount description:losslessDescription duration:frameDuration segment:&segment];
+				[heldFrame release];
+				heldFrame = nil;
+				heldCount = 0;
+				ByteCount byteCount;
+				while((byteCount = [self _addAudioBufferFromPipe:_audioPipe description:soundDescription buffer:audioBuffer media:segment.audioMedia])) segment.byteCount += byteCount;
+				[self _finishSegment:&segment index:closedSegmentCount++];
+				audioFrameCount = 0;
+				[frameRateConverter release];
+				frameRateConverter = [[options _frameRateConverter] retain]; // Time doesn't carry over the pause.
+			}
+			[_recordLock lock];
+			if(!segment.movie) _audioStartTime = 0.0; // The next segment's audio starts with the next buffer.
+			_segmentBreakCount++;
+			[_recordLock unlock];
+			[self _signalRecordSpace];
+		}
+		if(frame && !segment.movie) {
+			// The first frame after a break opens the next file, which should be ready by now.
+			dispatch_group_wait(segmentGroup, DISPATCH_TIME_FOREVER);
+			if(nextSegment.movie) ECVOSErr(AttachMovieToCurrentThread(nextSegment.movie));
+			else [self _openSegment:&nextSegment index:segmentIndex++ options:options];
+			segment = nextSegment;
+			nextSegment = (ECVMovieSegment){};
+			[self _openSegmentInBackground:&nextSegment index:segmentIndex++ options:options group:segmentGroup];
+			[_recordLock lock];
+			_segmentCount++;
+			[_recordLock unlock];
+		}
+		if(frame && frame != heldFrame) {
+			[self _addVideoSample:heldFrame count:heldCount description:losslessDescription duration:frameDuration segment:&segment];
+			[heldFrame release];
+			heldFrame = [frame retain];
+			heldCount = 0;
+		}
+		if(frame && !heldCount && segmented && [self _segment:&segment isCompleteBeforeFrame:frame options:options] && !dispatch_group_wait(segmentGroup, DISPATCH_TIME_NOW)) { // If the next file isn't open yet, keep writing this one until another key frame.
+			if(!nextSegment.movie) [self _openSegmentInBackground:&nextSegment index:segmentIndex++ options:options group:segmentGroup]; // Try again.
+			else {
+				ECVOSErr(AttachMovieToCurrentThread(nextSegment.movie));
+				ECVMovieSegment completeSegment = segment;
+				segment = nextSegment;
+				segment.audioFrameOffset = audioFrameCount;
+				nextSegment = (ECVMovieSegment){};
+				[self _openSegmentInBackground:&nextSegment index:segmentIndex++ options:options group:segmentGroup];
+				[_recordLock lock];
+				_segmentCount++;
+				[_recordLock unlock];
+				[self _finishSegment:&completeSegment index:closedSegmentCount++];
+			}
+		}
 
-		[self _addEncodedFrame:frame frameRateConverter:frameRateConverter media:videoMedia];
-		[self _addAudioBufferFromPipe:_audioPipe description:soundDescription buffer:audioBuffer media:audioMedia];
+		if(frame) {
+			if(!segment.videoStartTime) segment.videoStartTime = presentationTime;
+			heldCount += [frameRateConverter nextFrameRepeatCountForTime:presentationTime]; // Follows the recovered capture clock, so a device that runs off its nominal rate doesn't slowly drift from the audio.
+			segment.frameCount++;
+			segment.qualityLevelFrameCounts[qualityLevel]++; // Here rather than in the encoders, so frames still in flight at a switch count towards the segment they end up in.
+			frameCount++;
+		}
+		ByteCount const audioByteCount = [self _addAudioBufferFromPipe:_audioPipe description:soundDescription buffer:audioBuffer media:segment.audioMedia];
+		segment.byteCount += audioByteCount;
+		audioFrameCount += audioByteCount / ECVStandardAudioStreamBasicDescription.mBytesPerFrame;
 
 		if(stop && !remaining) {
 			[innerPool release];
@@ -352,30 +848,35 @@ enum {
 
 	[_compressLock lockWhenCondition:ECVThreadFinished];
 	[_compressLock unlock];
+	[self _addVideoSample:heldFrame count:heldCount description:losslessDescription duration:frameDuration segment:&segment];
+	[heldFrame release];
+	ECVLog(ECVNotice, @"Wrote %lu video samples covering %lu frames (%.1f MB), %.3f ms per sample.", (unsigned long)_sampleCount, (unsigned long)_sampleFrameCount, _sampleByteCount / 1.0e6, _sampleCount ? _sampleTime / _sampleCount * 1000.0 : 0.0);
+	[_recordLock lock];
+	ECVLog(ECVNotice, @"Record queue peaked at %.1f of %.1f MB (%lu of %lu frames); encoders waited %.2f s for room.", _recordHighWaterMark / 1.0e6, _recordBufferSize / 1.0e6, (unsigned long)_recordHighWaterCount, (unsigned long)_recordQueue.capacity, _recordStallTime);
+	[_recordLock unlock];
+	[frameRateConverter release];
+	if(segment.movie) [self _finishSegment:&segment index:closedSegmentCount];
+	if(segmentGroup) {
+		dispatch_group_wait(segmentGroup, DISPATCH_TIME_FOREVER);
+		dispatch_release(segmentGroup);
+		if(nextSegment.movie) ECVOSErr(AttachMovieToCurrentThread(nextSegment.movie));
+		[self _discardSegment:&nextSegment];
+	}
+	[_recordLock lock];
+	NSUInteger const segmentCount = _segmentCount;
+	NSUInteger const deliveredFrameCount = _deliveredFrameCount;
+	[_recordLock unlock];
+	ECVLog(frameCount == deliveredFrameCount ? ECVNotice : ECVError, @"Recorded %lu of %lu encoded frames in %lu segments.", (unsigned long)frameCount, (unsigned long)deliveredFrameCount, (unsigned long)segmentCount);
 
-	if(videoMedia) ECVOSErr(InsertMediaIntoTrack(GetMediaTrack(videoMedia), 0, GetMediaDisplayStartTime(videoMedia), GetMediaDisplayDuration(videoMedia), fixed1));
-	if(audioMedia) ECVOSErr(InsertMediaIntoTrack(GetMediaTrack(audioMedia), 0, GetMediaDisplayStartTime(audioMedia), GetMediaDisplayDuration(audioMedia), fixed1));
-	if(videoMedia) ECVOSErr(EndMediaEdits(videoMedia));
-	if(audioMedia) ECVOSErr(EndMediaEdits(audioMedia));
-
-	UpdateMovieInStorage(movie, dataHandler);
-	CloseMovieStorage(dataHandler);
-
+	if(losslessDescription) DisposeHandle((Handle)losslessDescription);
 	if(soundDescription) DisposeHandle((Handle)soundDescription);
 	if(audioBuffer) free(audioBuffer);
 
-	if(videoMedia) DisposeTrackMedia(videoMedia);
-	if(videoTrack) DisposeMovieTrack(videoTrack);
-
-	if(audioMedia) DisposeTrackMedia(audioMedia);
-	if(audioTrack) DisposeMovieTrack(audioTrack);
-
-	DisposeMovie(movie);
-
 bail:
 
 	[_recordLock lock];
 	[_recordLock unlockWithCondition:ECVThreadFinished];
+	[self _signalRecordSpace];
 
 	ECVOSErr(ExitMoviesOnThread());
 	[outerPool release];
@@ -383,9 +884,127 @@ bail:
 
 #pragma mark -
 
-- (void)_addEncodedFrame:(ICMEncodedFrameRef const)frame frameRateConverter:(ECVFrameRateConverter *const)frameRateConverter media:(Media const)media
+- (BOOL)_openSegment:(ECVMovieSegment *const)segment index:(NSUInteger const)index options:(ECVMovieRecordingOptions *const)options
+{
+	*segment = (ECVMovieSegment){};
+	NSURL *const URL = [options _URLForSegment:index];
+	Handle dataRef = NULL;
+	OSType dataRefType = 0;
+	ECVOSErr(QTNewDataReferenceFromCFURL((CFURLRef)URL, kNilOptions, &dataRef, &dataRefType));
+	ECVOSErr(CreateMovieStorage(dataRef, dataRefType, 'TVOD', smSystemScript, createMovieFileDeleteCurFile, &segment->dataHandler, &segment->movie));
+	if(dataRef) DisposeHandle(dataRef);
+	if(!segment->movie) {
+		ECVLog(ECVError, @"Movie could not be created.");
+		return NO;
+	}
+	segment->URL = [URL retain];
+
+	ECVIntegerSize const outputSize = [options _outputSize];
+	segment->videoTrack = NewMovieTrack(segment->movie, Long2Fix(outputSize.width), Long2Fix(outputSize.height), kNoVolume);
+	segment->videoMedia = NewTrackMedia(segment->videoTrack, VideoMediaType, [options frameRate].timeScale, NULL, 0);
+	ECVOSErr(BeginMediaEdits(segment->videoMedia));
+
+	if(_audioPipe) {
+		segment->audioTrack = NewMovieTrack(segment->movie, 0, 0, (short)round([options volume] * kFullVolume));
+		segment->audioMedia = NewTrackMedia(segment->audioTrack, SoundMediaType, ECVStandardAudioStreamBasicDescription.mSampleRate, NULL, 0);
+		ECVOSErr(BeginMediaEdits(segment->audioMedia));
+	}
+	return YES;
+}
+- (void)_openSegmentInBackground:(ECVMovieSegment *const)segment index:(NSUInteger const)index options:(ECVMovieRecordingOptions *const)options group:(dispatch_group_t const)group
+{
+	// Creating the file can take a while on a busy disk, so it happens off the record thread. The segment isn't touched again until the group is done.
+	dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+		NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+		ECVOSErr(EnterMoviesOnThread(kNilOptions));
+		if([self _openSegment:segment index:index options:options]) ECVOSErr(DetachMovieFromCurrentThread(segment->movie)); // Along with its tracks and media. The record thread attaches it when it switches.
+		ECVOSErr(ExitMoviesOnThread());
+		[pool drain];
+	});
+}
+- (BOOL)_segment:(ECVMovieSegment const *const)segment isCompleteBeforeFrame:(id const)frame options:(ECVMovieRecordingOptions *const)options
+{
+	if(!frame || !segment->frameCount) return NO;
+	if(![frame isKindOfClass:[NSData class]] && ICMEncodedFrameGetMediaSampleFlags((ICMEncodedFrameRef)frame) & mediaSampleNotSync) return NO; // Only split on key frames, so every file plays on its own.
+	NSTimeInterval const duration = [options segmentDuration];
+	if(duration > 0.0 && GetMediaDisplayDuration(segment->videoMedia) >= (TimeValue64)round(duration * GetMediaTimeScale(segment->videoMedia))) return YES;
+	unsigned long long const size = [options segmentSize];
+	return size && segment->byteCount >= size;
+}
+- (void)_closeSegment:(ECVMovieSegment *const)segment audioOffset:(NSTimeInterval const)audioOffset
+{
+	if(!segment->movie) return;
+	Media const videoMedia = segment->videoMedia;
+	Media const audioMedia = segment->audioMedia;
+
+	if(videoMedia) ECVOSErr(InsertMediaIntoTrack(segment->videoTrack, 0, GetMediaDisplayStartTime(videoMedia), GetMediaDisplayDuration(videoMedia), fixed1));
+	if(audioMedia) {
+		if(audioOffset) ECVLog(ECVNotice, @"Audio offset from video: %+.1f ms.", audioOffset * 1000.0);
+		TimeValue64 const skippedDuration = audioOffset < 0.0 ? (TimeValue64)round(-audioOffset * ECVStandardAudioStreamBasicDescription.mSampleRate) : 0;
+		TimeValue64 const duration = GetMediaDisplayDuration(audioMedia);
+		TimeValue const trackStart = audioOffset > 0.0 ? (TimeValue)round(audioOffset * GetMovieTimeScale(segment->movie)) : 0;
+		if(skippedDuration < duration) ECVOSErr(InsertMediaIntoTrack(segment->audioTrack, trackStart, GetMediaDisplayStartTime(audioMedia) + skippedDuration, duration - skippedDuration, fixed1));
+	}
+	if(videoMedia) ECVOSErr(EndMediaEdits(videoMedia));
+	if(audioMedia) ECVOSErr(EndMediaEdits(audioMedia));
+
+	UpdateMovieInStorage(segment->movie, segment->dataHandler);
+	CloseMovieStorage(segment->dataHandler);
+
+	if(videoMedia) DisposeTrackMedia(videoMedia);
+	if(segment->videoTrack) DisposeMovieTrack(segment->videoTrack);
+	if(audioMedia) DisposeTrackMedia(audioMedia);
+	if(segment->audioTrack) DisposeMovieTrack(segment->audioTrack);
+	DisposeMovie(segment->movie);
+
+	[segment->URL release];
+	*segment = (ECVMovieSegment){};
+}
+- (void)_finishSegment:(ECVMovieSegment *const)segment index:(NSUInteger const)index
+{
+	NSUInteger const sampleCount = segment->sampleCount;
+	TimeValue64 const duration = segment->videoDuration;
+	[self _logQualityForSegment:segment index:index];
+	[self _closeSegment:segment audioOffset:[self _audioOffsetForSegment:segment]];
+	ECVLog(ECVNotice, @"Segment %lu closed with %lu samples, %lld time units.", (unsigned long)index + 1, (unsigned long)sampleCount, (long long)duration);
+}
+- (void)_discardSegment:(ECVMovieSegment *const)segment
+{
+	if(!segment->movie) return;
+	NSString *const path = [[[segment->URL path] retain] autorelease];
+	[self _closeSegment:segment audioOffset:0.0];
+	if(unlink([path fileSystemRepresentation]) < 0) ECVLog(ECVError, @"Unused segment %@ could not be removed (%s).", path, strerror(errno));
+}
+- (NSTimeInterval)_audioOffsetForSegment:(ECVMovieSegment const *const)segment
+{
+	// Each segment's audio picks up wherever the pipe was at the switch, so line it up with the segment's own first frame.
+	[_recordLock lock];
+	NSTimeInterval const audioStartTime = _audioStartTime;
+	[_recordLock unlock];
+	if(!segment->videoStartTime || !audioStartTime) return 0.0;
+	return audioStartTime + segment->audioFrameOffset / ECVStandardAudioStreamBasicDescription.mSampleRate - segment->videoStartTime; // Positive when the audio started after the video.
+}
+
+#pragma mark -
+
+- (void)_addVideoSample:(id const)frame count:(NSUInteger const)count description:(ImageDescriptionHandle const)description duration:(TimeValue64 const)duration segment:(ECVMovieSegment *const)segment
 {
-	if(!frame) return;
+	if(!frame || !count) return;
+	Media const media = segment->videoMedia;
+	NSTimeInterval const startTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+	ByteCount const size = [frame isKindOfClass:[NSData class]] ? [self _addLosslessFrame:frame description:description duration:duration count:count media:media] : [self _addEncodedFrame:(ICMEncodedFrameRef)frame count:count media:media];
+	_sampleTime += [NSDate ECV_timeIntervalSinceReferenceDate] - startTime;
+	_sampleCount++;
+	_sampleFrameCount += count;
+	_sampleByteCount += size;
+	segment->byteCount += size;
+	if(!size) return;
+	segment->sampleCount++;
+	segment->videoDuration += duration * count;
+}
+- (ByteCount)_addEncodedFrame:(ICMEncodedFrameRef const)frame count:(NSUInteger const)count media:(Media const)media
+{
+	if(!frame) return 0;
 
 	UInt8 const *const dataPtr = ICMEncodedFrameGetDataPtr(frame);
 	ByteCount const bufferSize = ICMEncodedFrameGetDataSize(frame);
@@ -395,45 +1014,330 @@ bail:
 	ECVOSStatus(ICMEncodedFrameGetImageDescription(frame, &descriptionHandle));
 	MediaSampleFlags const mediaSampleFlags = ICMEncodedFrameGetMediaSampleFlags(frame);
 
-	NSUInteger const count = [frameRateConverter nextFrameRepeatCount];
-
-	for(NSUInteger i = 0; i < count; ++i) {
-		ECVOSStatus(AddMediaSample2(media, dataPtr, bufferSize, decodeDuration, displayOffset, (SampleDescriptionHandle)descriptionHandle, 1, mediaSampleFlags, NULL));
-	}
+	ECVOSStatus(AddMediaSample2(media, dataPtr, bufferSize, decodeDuration * count, displayOffset, (SampleDescriptionHandle)descriptionHandle, 1, mediaSampleFlags, NULL)); // Repeats just make the sample last longer.
+	return bufferSize;
 }
-- (void)_addAudioBufferFromPipe:(ECVAudioPipe *const)audioPipe description:(SoundDescriptionHandle const)description buffer:(void *const)buffer media:(Media const)media
+- (ByteCount)_addLosslessFrame:(NSData *const)data description:(ImageDescriptionHandle const)description duration:(TimeValue64 const)duration count:(NSUInteger const)count media:(Media const)media
 {
-	if(![audioPipe hasReadyBuffers]) return;
+	if(!description) return 0;
+	ECVOSStatus(AddMediaSample2(media, [data bytes], [data length], duration * count, 0, (SampleDescriptionHandle)description, 1, 0, NULL));
+	return [data length];
+}
+- (ByteCount)_addAudioBufferFromPipe:(ECVAudioPipe *const)audioPipe description:(SoundDescriptionHandle const)description buffer:(void *const)buffer media:(Media const)media
+{
+	if(!media || ![audioPipe hasReadyBuffers]) return 0;
 	AudioBufferList outputBufferList = {1, {2, ECVAudioBufferBytesSize, buffer}};
 	[audioPipe requestOutputBufferList:&outputBufferList];
 	ByteCount const size = outputBufferList.mBuffers[0].mDataByteSize;
-	if(!size || !outputBufferList.mBuffers[0].mData) return;
+	if(!size || !outputBufferList.mBuffers[0].mData) return 0;
 	AddMediaSample2(media, outputBufferList.mBuffers[0].mData, size, 1, 0, (SampleDescriptionHandle)description, size / ECVStandardAudioStreamBasicDescription.mBytesPerFrame, 0, NULL);
+	return size;
 }
-
-#pragma mark -ECVMovieRecorder(Private)<ECVCompressionDelegate>
-
-- (void)addEncodedFrame:(ICMEncodedFrameRef const)frame
+- (void)_addVideoFrame:(ECVVideoFrame *const)frame unchanged:(BOOL const)unchanged
 {
+	// A nil frame repeats the previous one, which is how proxies follow the main recording.
+	[_compressLock lock];
+	if(ECVThreadFinished == [_compressLock condition]) return [_compressLock unlock];
+	if(unchanged) {
+		if(frame) {
+			_unchangedFrameCount++;
+			_unchangedRunLength++; // Keep comparing against the encoded frame, so slow changes still add up.
+		}
+		if(_compressQueue.count) {
+			_compressRepeatCounts[(_compressQueue.start + _compressQueue.count - 1) % _compressQueue.capacity]++;
+			return [_compressLock unlockWithCondition:ECVThreadRun];
+		}
+	}
+	if(!ECVObjectQueuePush(&_compressQueue, unchanged ? [NSNull null] : (id)frame)) { // The encoder repeats the previous frame for NSNull.
+		// Never block the capture thread. Queued frames pin storage buffers, so we don't grow the queue either.
+		if(ECVRecordingRepeatFrames == _overflowPolicy) {
+			_compressRepeatCounts[(_compressQueue.start + _compressQueue.count - 1) % _compressQueue.capacity]++;
+			_repeatedFrameCount++;
+		} else {
+			_droppedFrameCount++;
+		}
+	} else if(!unchanged && frame) {
+		// Only frames that will really be encoded become the reference. Otherwise later frames would be compared against one that never made it into the movie.
+		if(_hasCurrentLuma) {
+			UInt8 *const luma = _referenceLuma;
+			_referenceLuma = _currentLuma;
+			_currentLuma = luma;
+		}
+		_hasReferenceLuma = _hasCurrentLuma;
+		_unchangedRunLength = 0;
+	}
+	_hasCurrentLuma = NO;
+	[_compressLock unlockWithCondition:ECVThreadRun];
+}
+- (BOOL)_isUnchangedFrame:(ECVVideoFrame *const)frame
+{
+	// Only called from -addVideoFrame:, which isn't reentrant.
+	NSTimeInterval const startTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+	BOOL decimated = NO;
+	_hasCurrentLuma = NO;
+	if(!ECVEqualPixelSizes(ECVDecimatedLumaSize([frame pixelSize]), _lumaSize)) return NO;
+	if([frame lockIfHasBytes]) {
+		decimated = ECVDecimateLuma(frame, _currentLuma);
+		[frame unlock];
+	}
+	if(!decimated) return NO;
+	_hasCurrentLuma = YES; // -_addVideoFrame:unchanged: decides whether it becomes the reference.
+	BOOL const unchanged = _hasReferenceLuma && _unchangedRunLength < _maxUnchangedRunLength && ECVLumaMaxBlockDifference(_referenceLuma, _currentLuma, _lumaSize, ECVMovieRecorderUnchangedBlockSize) <= _unchangedFrameThreshold;
+	_detectionTime += [NSDate ECV_timeIntervalSinceReferenceDate] - startTime;
+	_detectionCount++;
+	return unchanged;
+}
+- (void)_updateQualityWithEncodeTime:(NSTimeInterval const)encodeTime
+{
+	// Called with the compress lock held.
+	if(!_adaptsQuality || !_frameDuration) return;
+	_averageEncodeTime = _averageEncodeTime ? _averageEncodeTime * 0.9 + encodeTime * 0.1 : encodeTime;
+	NSTimeInterval const time = [NSDate ECV_timeIntervalSinceReferenceDate];
+	double const load = _averageEncodeTime / (_frameDuration * _encoderCount); // Each encoder only has to keep up with every Nth frame.
+	double const fill = (double)_compressQueue.count / _compressQueue.capacity;
+	BOOL const pressure = load > ECVQualityPressureLoad || fill > 0.75;
+	BOOL const headroom = load < ECVQualityHeadroomLoad && fill < 0.25;
+	if(!pressure) _pressureStartTime = 0.0;
+	else if(!_pressureStartTime) _pressureStartTime = time;
+	if(!headroom) _headroomStartTime = 0.0;
+	else if(!_headroomStartTime) _headroomStartTime = time;
+	if(time - _qualityChangeTime < ECVQualityMinChangeInterval) return;
+
+	NSUInteger level = _qualityLevel;
+	if(pressure && time - _pressureStartTime >= ECVQualityPressureDelay && level + 1 < ECVMovieRecorderQualityLevelCount) level++;
+	else if(headroom && time - _headroomStartTime >= ECVQualityHeadroomDelay && level) level--;
+	else return;
+	ECVLog(ECVNotice, @"Encoders %@ (%.0f%% load, %lu frames queued), now at level %lu: quality %.0f%%, size %.0f%%.", level > _qualityLevel ? @"falling behind" : @"caught up", load * 100.0, (unsigned long)_compressQueue.count, (unsigned long)level, ECVQualityLevels[level].quality * 100.0, ECVQualityLevels[level].scale * 100.0);
+	_qualityLevel = level;
+	_qualityChangeTime = time;
+	_qualityChangeCount++;
+	_pressureStartTime = 0.0;
+	_headroomStartTime = 0.0;
+}
+- (void)_logQualityForSegment:(ECVMovieSegment const *const)segment index:(NSUInteger const)index
+{
+	if(!_adaptsQuality) return;
+	NSMutableArray *const levels = [NSMutableArray array];
+	NSUInteger i = 0;
+	for(; i < ECVMovieRecorderQualityLevelCount; i++) if(segment->qualityLevelFrameCounts[i]) [levels addObject:[NSString stringWithFormat:@"%lu at level %lu", (unsigned long)segment->qualityLevelFrameCounts[i], (unsigned long)i]];
+	[_compressLock lock];
+	NSUInteger const changeCount = _qualityChangeCount;
+	_qualityChangeCount = 0;
+	[_compressLock unlock];
+	ECVLog(ECVNotice, @"Segment %lu quality: %@ (%lu changes).", (unsigned long)index + 1, [levels count] ? [levels componentsJoinedByString:@", "] : @"no frames", (unsigned long)changeCount);
+}
+- (void)_deliverEncodedFrame:(id const)frame qualityLevel:(NSUInteger const)level presentationTime:(NSTimeInterval const)time
+{
+	// A nil frame repeats the previous one, at its level. Repeats have no time of their own.
+	size_t byteCount = 0;
 	if(frame && frame != _encodedFrame) {
-		ICMEncodedFrameRelease(_encodedFrame);
-		_encodedFrame = ICMEncodedFrameRetain(frame);
+		[_encodedFrame release];
+		_encodedFrame = [frame retain];
+		_encodedFrameQualityLevel = level;
+		byteCount = ECVEncodedFrameByteCount(frame);
 	}
 	if(!_encodedFrame) return;
 	[_recordLock lock];
-	[_recordQueue insertObject:(id)_encodedFrame atIndex:0];
+	BOOL pushed = NO;
+	NSTimeInterval stallStartTime = 0.0;
+	for(;;) {
+		BOOL const fits = !_recordBufferSize || !_recordByteCount || _recordByteCount + byteCount <= _recordBufferSize; // An empty queue always takes one frame, however big.
+		if((pushed = fits && ECVObjectQueuePush(&_recordQueue, _encodedFrame))) break;
+		if(ECVThreadFinished == [_recordLock condition]) break;
+		if(!stallStartTime) stallStartTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+		// Wait for the record thread. If this takes long enough, the compress queue fills up and the overflow policy kicks in.
+		[_recordSpaceCondition lock];
+		NSUInteger const popCount = _recordPopCount; // Any pop after our failed push changes this, so we can't miss it.
+		[_recordSpaceCondition unlock];
+		[_recordLock unlockWithCondition:ECVThreadRun];
+		[_recordSpaceCondition lock];
+		while(popCount == _recordPopCount) [_recordSpaceCondition wait];
+		[_recordSpaceCondition unlock];
+		[_recordLock lock];
+	}
+	if(stallStartTime) _recordStallTime += [NSDate ECV_timeIntervalSinceReferenceDate] - stallStartTime;
+	if(pushed) {
+		NSUInteger const slot = (_recordQueue.start + _recordQueue.count - 1) % _recordQueue.capacity;
+		_recordQualityLevels[slot] = _encodedFrameQualityLevel;
+		_recordPresentationTimes[slot] = frame ? time : 0.0;
+		_recordByteCounts[slot] = byteCount;
+		_recordByteCount += byteCount;
+		_recordHighWaterMark = MAX(_recordHighWaterMark, _recordByteCount);
+		_recordHighWaterCount = MAX(_recordHighWaterCount, _recordQueue.count);
+		_deliveredFrameCount++;
+	}
+	if(ECVThreadFinished == [_recordLock condition]) return [_recordLock unlock];
+	[_recordLock unlockWithCondition:ECVThreadRun];
+}
+- (void)_requestSegmentBreak
+{
+	// Called with the reorder lock held, once every frame before the break has been delivered.
+	_segmentBreakSequence = NSNotFound;
+	[_recordLock lock];
+	if(ECVThreadFinished == [_recordLock condition]) return [_recordLock unlock];
+	_segmentBreakFrameCount = _deliveredFrameCount;
 	[_recordLock unlockWithCondition:ECVThreadRun];
 }
+- (void)_signalRecordSpace
+{
+	[_recordSpaceCondition lock];
+	_recordPopCount++;
+	[_recordSpaceCondition broadcast];
+	[_recordSpaceCondition unlock];
+}
+- (void)_signalCompressSpace
+{
+	[_compressSpaceCondition lock];
+	[_compressSpaceCondition broadcast];
+	[_compressSpaceCondition unlock];
+}
+- (void)_deliverConvertedFrame:(ECVVideoFrame *const)frame repeatCount:(NSUInteger const)count
+{
+	// In sequence, so each proxy gets the same frames and repeats we record.
+	for(ECVMovieRecorder *const proxy in _proxyRecorders) {
+		[proxy _addVideoFrame:frame unchanged:!frame];
+		NSUInteger i = 0;
+		for(; i < count; i++) [proxy _addVideoFrame:nil unchanged:YES];
+	}
+}
+- (NSTimeInterval)_compressTimePerFrame
+{
+	[_compressLock lock];
+	NSTimeInterval const time = _encodedFrameCount ? _encodeTime / _encodedFrameCount : 0.0;
+	[_compressLock unlock];
+	return time;
+}
+
+#pragma mark -ECVMovieRecorder(ECVEncoderContext)
+
+- (void)addEncodedFrame:(id const)frame context:(ECVEncoderContext *const)context
+{
+	// Called on the encoder threads, possibly out of order. Frames are passed on in sequence.
+	NSUInteger const sequenceNumber = context->sequenceNumber;
+	context->delivered = YES;
+	[_reorderLock lock];
+	while(sequenceNumber >= _nextSequenceNumber + ECVMovieRecorderReorderCapacity) [_reorderLock wait]; // Our slot is still taken by an earlier frame.
+	NSUInteger const slot = sequenceNumber % ECVMovieRecorderReorderCapacity;
+	_reorderFrames[slot] = [frame retain];
+	_reorderRepeatCounts[slot] = context->repeatCount;
+	_reorderQualityLevels[slot] = context->qualityLevel;
+	_reorderPresentationTimes[slot] = context->presentationTime;
+	_reorderConvertedFrames[slot] = [context->convertedFrame retain];
+	_reorderFilled[slot] = YES;
+	for(;;) {
+		NSUInteger const next = _nextSequenceNumber % ECVMovieRecorderReorderCapacity;
+		if(!_reorderFilled[next]) break;
+		id const readyFrame = _reorderFrames[next];
+		[self _deliverEncodedFrame:readyFrame qualityLevel:_reorderQualityLevels[next] presentationTime:_reorderPresentationTimes[next]];
+		NSUInteger i = 0;
+		for(; i < _reorderRepeatCounts[next]; i++) [self _deliverEncodedFrame:nil qualityLevel:0 presentationTime:0.0];
+		[self _deliverConvertedFrame:_reorderConvertedFrames[next] repeatCount:_reorderRepeatCounts[next]];
+		[readyFrame release];
+		[_reorderConvertedFrames[next] release];
+		_reorderFrames[next] = nil;
+		_reorderConvertedFrames[next] = nil;
+		_reorderFilled[next] = NO;
+		_nextSequenceNumber++;
+		if(_nextSequenceNumber == _segmentBreakSequence) [self _requestSegmentBreak];
+		[_reorderLock broadcast];
+	}
+	[_reorderLock unlock];
+}
 
 #pragma mark -NSObject
 
 - (void)dealloc
 {
 	[_compressLock release];
-	[_compressQueue release];
+	ECVObjectQueueDestroy(&_compressQueue);
+	[_reorderLock release];
 	[_recordLock release];
-	[_recordQueue release];
+	ECVObjectQueueDestroy(&_recordQueue);
+	free(_recordQualityLevels);
+	free(_recordPresentationTimes);
+	free(_recordByteCounts);
+	[_recordSpaceCondition release];
+	[_compressSpaceCondition release];
 	[_audioPipe release];
+	[_proxyRecorders release];
+	[_independentProxyRecorders release];
+	if(_referenceLuma) free(_referenceLuma);
+	if(_currentLuma) free(_currentLuma);
+	[super dealloc];
+}
+
+@end
+
+@implementation ECVConvertedFrame
+
+#pragma mark -ECVConvertedFrame
+
+- (id)initWithPixelBuffer:(CVPixelBufferRef const)pixelBuffer videoStorage:(ECVVideoStorage *const)storage
+{
+	NSParameterAssert(pixelBuffer);
+	if((self = [super initWithVideoStorage:storage])) {
+		_pixelBuffer = CVPixelBufferRetain(pixelBuffer);
+	}
+	return self;
+}
+
+#pragma mark -ECVPixelBuffer(ECVAbstract)
+
+- (ECVIntegerSize)pixelSize
+{
+	return (ECVIntegerSize){CVPixelBufferGetWidth(_pixelBuffer), CVPixelBufferGetHeight(_pixelBuffer)};
+}
+- (size_t)bytesPerRow
+{
+	return CVPixelBufferGetBytesPerRow(_pixelBuffer);
+}
+- (OSType)pixelFormat
+{
+	return CVPixelBufferGetPixelFormatType(_pixelBuffer);
+}
+
+#pragma mark -
+
+- (NSRange)validRange
+{
+	return [self fullRange];
+}
+
+#pragma mark -ECVVideoFrame(ECVAbstract)
+
+- (void const *)bytes
+{
+	return CVPixelBufferGetBaseAddress(_pixelBuffer);
+}
+
+#pragma mark -
+
+- (BOOL)hasBytes
+{
+	return YES;
+}
+- (BOOL)lockIfHasBytes
+{
+	[self lock];
+	return YES;
+}
+
+#pragma mark -ECVVideoFrame(ECVAbstract) <NSLocking>
+
+- (void)lock
+{
+	CVPixelBufferLockBaseAddress(_pixelBuffer, kNilOptions); // Proxies on different encoder threads can lock it at once.
+}
+- (void)unlock
+{
+	CVPixelBufferUnlockBaseAddress(_pixelBuffer, kNilOptions);
+}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	CVPixelBufferRelease(_pixelBuffer);
 	[super dealloc];
 }
 
@@ -30,6 +30,14 @@ enum {
 };
 typedef NSUInteger ECVPixelBufferDrawingOptions;
 
+enum {
+	ECVScaleBilinear,
+	ECVScaleArea, // Averages everything each output pixel covers, so shrinking doesn't alias.
+};
+typedef NSUInteger ECVPixelBufferScalingFilter;
+
+@class ECVPixelBufferScaler;
+
 @interface ECVPixelBuffer : NSObject
 
 - (NSRange)fullRange;
@@ -67,6 +75,8 @@ typedef NSUInteger ECVPixelBufferDrawingOptions;
 - (void)drawPixelBuffer:(ECVPixelBuffer *)src;
 - (void)drawPixelBuffer:(ECVPixelBuffer *)src options:(ECVPixelBufferDrawingOptions)options;
 - (void)drawPixelBuffer:(ECVPixelBuffer *)src options:(ECVPixelBufferDrawingOptions)options atPoint:(ECVIntegerPoint)point;
+- (void)drawPixelBuffer:(ECVPixelBuffer *)src fromRect:(NSRect)rect filter:(ECVPixelBufferScalingFilter)filter; // Crops (in source pixels) and scales to fill the receiver in one pass. Both must have the same pixel format.
+- (void)drawPixelBuffer:(ECVPixelBuffer *)src fromRect:(NSRect)rect scaler:(ECVPixelBufferScaler *)scaler; // Same, but reuses the scaler's tables while the geometry stays the same.
 
 - (void)clearRange:(NSRange)range;
 - (void)clear;
@@ -103,3 +113,15 @@ typedef NSUInteger ECVPixelBufferDrawingOptions;
 - (NSMutableData *)mutableData;
 
 @end
+
+@interface ECVPixelBufferScaler : NSObject // Not thread safe, so give each thread its own.
+{
+	@private
+	ECVPixelBufferScalingFilter _filter;
+	struct ECVScalerTables *_tables;
+}
+
+- (id)initWithFilter:(ECVPixelBufferScalingFilter)filter;
+- (ECVPixelBufferScalingFilter)filter;
+
+@end
@@ -24,6 +24,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 // Other Sources
 #import "ECVPixelFormat.h"
 
+@interface ECVPixelBufferScaler(Private)
+
+- (void)_scalePixelBuffer:(ECVPixelBuffer *const)src fromRect:(NSRect const)rect toPixelBuffer:(ECVMutablePixelBuffer *const)dst;
+
+@end
+
 typedef struct {
 	NSInteger location;
 	NSUInteger length;
@@ -129,6 +135,208 @@ static void ECVDrawRect(ECVMutablePixelBuffer *dst, ECVPixelBuffer *src, ECVInte
 	}
 }
 
+#define ECVFilterShift 14
+#define ECVFilterOne (1 << ECVFilterShift)
+
+typedef struct {
+	NSUInteger tapCount;
+	NSInteger *indexes; // tapCount per output sample, clamped to the source.
+	UInt16 *weights; // Each group sums to ECVFilterOne.
+	UInt32 *offsets; // Byte offsets of the indexes within a row, once it's known which part of the row is used.
+} ECVFilter;
+
+static ECVFilter ECVFilterCreate(double const start, double const length, NSInteger const minIndex, NSInteger const maxIndex, NSUInteger const count, ECVPixelBufferScalingFilter const type)
+{
+	double const ratio = length / count;
+	BOOL const area = ECVScaleArea == type && ratio > 1.0; // Enlarging with area is the same as bilinear.
+	NSUInteger const tapCount = area ? (NSUInteger)ceil(ratio) + 1 : 2;
+	ECVFilter const filter = {tapCount, malloc(sizeof(NSInteger) * tapCount * count), malloc(sizeof(UInt16) * tapCount * count), malloc(sizeof(UInt32) * tapCount * count)};
+	double weights[tapCount];
+	NSUInteger i = 0;
+	for(; i < count; i++) {
+		NSInteger first;
+		NSUInteger j;
+		if(area) {
+			double const a = start + i * ratio;
+			double const b = a + ratio;
+			first = (NSInteger)floor(a);
+			for(j = 0; j < tapCount; j++) weights[j] = MAX(MIN(first + j + 1.0, b) - MAX(first + (double)j, a), 0.0) / ratio;
+		} else {
+			double const center = start + (i + 0.5) * ratio - 0.5;
+			first = (NSInteger)floor(center);
+			weights[1] = center - first;
+			weights[0] = 1.0 - weights[1];
+		}
+		NSInteger total = 0;
+		for(j = 0; j < tapCount; j++) {
+			NSUInteger const k = i * tapCount + j;
+			NSInteger const weight = j + 1 < tapCount ? (NSInteger)floor(weights[j] * ECVFilterOne) : ECVFilterOne - total; // Rounding down leaves the remainder for the last tap.
+			filter.indexes[k] = MIN(MAX(first + (NSInteger)j, minIndex), maxIndex - 1);
+			filter.weights[k] = (UInt16)MIN(MAX(weight, 0), ECVFilterOne);
+			total += filter.weights[k];
+		}
+	}
+	return filter;
+}
+static void ECVFilterDestroy(ECVFilter const filter)
+{
+	free(filter.indexes);
+	free(filter.weights);
+	free(filter.offsets);
+}
+static BOOL ECVFilterIsIdentity(ECVFilter const *const filter, NSUInteger const count)
+{
+	NSUInteger i = 0;
+	for(; i < count; i++) if(ECVFilterOne != filter->weights[i * filter->tapCount] || filter->indexes[i * filter->tapCount] != filter->indexes[0] + (NSInteger)i) return NO;
+	return YES;
+}
+static void ECVFilterSetOffsets(ECVFilter const *const filter, NSUInteger const count, NSInteger const base, size_t const stride, size_t const offset)
+{
+	NSUInteger i = 0;
+	for(; i < count * filter->tapCount; i++) filter->offsets[i] = (UInt32)((filter->indexes[i] - base) * stride + offset);
+}
+static void ECVFilterRow(ECVFilter const *const filter, NSUInteger const count, UInt8 const *const src, UInt8 *const dst, size_t const stride)
+{
+	UInt32 const *const offsets = filter->offsets;
+	UInt16 const *const weights = filter->weights;
+	NSUInteger i = 0;
+	if(2 == filter->tapCount) { // Bilinear, and the most common case by far.
+		for(; i < count; i++) dst[i * stride] = (UInt8)((ECVFilterOne / 2 + weights[i * 2] * src[offsets[i * 2]] + weights[i * 2 + 1] * src[offsets[i * 2 + 1]]) >> ECVFilterShift);
+		return;
+	}
+	for(; i < count; i++) {
+		UInt32 sum = ECVFilterOne / 2;
+		NSUInteger j = 0;
+		for(; j < filter->tapCount; j++) sum += weights[i * filter->tapCount + j] * src[offsets[i * filter->tapCount + j]];
+		dst[i * stride] = (UInt8)(sum >> ECVFilterShift);
+	}
+}
+struct ECVScalerTables {
+	NSRect srcRect; // The key: the tables only change with the geometry, which is normally the same for a whole recording.
+	ECVIntegerSize dstSize;
+	NSInteger minRow;
+	NSInteger maxRow;
+	NSInteger pairCount;
+	OSType pixelFormat;
+	ECVPixelBufferScalingFilter type;
+
+	ECVFilter rows;
+	ECVFilter luma;
+	ECVFilter chroma;
+	NSInteger firstPair;
+	size_t spanLength;
+	BOOL copiesColumns;
+	UInt32 *sums;
+	UInt8 *span;
+};
+
+static void ECVScalerTablesDestroy(struct ECVScalerTables *const tables)
+{
+	free(tables->span);
+	free(tables->sums);
+	ECVFilterDestroy(tables->chroma);
+	ECVFilterDestroy(tables->luma);
+	ECVFilterDestroy(tables->rows);
+	free(tables);
+}
+static struct ECVScalerTables *ECVScalerTablesCreate(NSRect const srcRect, ECVIntegerSize const dstSize, NSInteger const minRow, NSInteger const maxRow, NSInteger const pairCount, OSType const pixelFormat, ECVPixelBufferScalingFilter const type)
+{
+	struct ECVScalerTables *const tables = calloc(1, sizeof(struct ECVScalerTables));
+	tables->srcRect = srcRect;
+	tables->dstSize = dstSize;
+	tables->minRow = minRow;
+	tables->maxRow = maxRow;
+	tables->pairCount = pairCount;
+	tables->pixelFormat = pixelFormat;
+	tables->type = type;
+
+	// Both components only need each source row once, so filter vertically over just the cropped span, then horizontally from that.
+	ECVComponentOffsets const offsets = ECVPixelFormatComponentOffsets(pixelFormat);
+	tables->rows = ECVFilterCreate(NSMinY(srcRect), NSHeight(srcRect), minRow, maxRow, dstSize.height, type);
+	tables->luma = ECVFilterCreate(NSMinX(srcRect), NSWidth(srcRect), 0, pairCount * 2, dstSize.width / 2 * 2, type);
+	tables->chroma = ECVFilterCreate(NSMinX(srcRect) / 2.0, NSWidth(srcRect) / 2.0, 0, pairCount, dstSize.width / 2, type);
+	NSInteger const firstPair = MIN(tables->luma.indexes[0] / 2, tables->chroma.indexes[0]);
+	NSInteger const lastPair = MAX(tables->luma.indexes[(dstSize.width / 2 * 2) * tables->luma.tapCount - 1] / 2, tables->chroma.indexes[dstSize.width / 2 * tables->chroma.tapCount - 1]);
+	ECVFilterSetOffsets(&tables->luma, dstSize.width / 2 * 2, firstPair * 2, 2, offsets.luma[0]); // Luma samples are two bytes apart.
+	ECVFilterSetOffsets(&tables->chroma, dstSize.width / 2, firstPair, 4, 0);
+	tables->firstPair = firstPair;
+	tables->spanLength = (lastPair - firstPair + 1) * 4;
+	tables->copiesColumns = ECVFilterIsIdentity(&tables->luma, dstSize.width / 2 * 2) && !(tables->luma.indexes[0] % 2); // A crop that lines up with the pixel pairs.
+	tables->sums = malloc(sizeof(UInt32) * tables->spanLength);
+	tables->span = malloc(tables->spanLength);
+	return tables;
+}
+static BOOL ECVScalerTablesMatch(struct ECVScalerTables const *const tables, NSRect const srcRect, ECVIntegerSize const dstSize, NSInteger const minRow, NSInteger const maxRow, NSInteger const pairCount, OSType const pixelFormat, ECVPixelBufferScalingFilter const type)
+{
+	if(!tables) return NO;
+	if(!NSEqualRects(tables->srcRect, srcRect) || tables->dstSize.width != dstSize.width || tables->dstSize.height != dstSize.height) return NO;
+	return tables->minRow == minRow && tables->maxRow == maxRow && tables->pairCount == pairCount && tables->pixelFormat == pixelFormat && tables->type == type;
+}
+static void ECVScaleRect(ECVMutablePixelBuffer *const dst, ECVPixelBuffer *const src, NSRect const srcRect, ECVPixelBufferScalingFilter const type, struct ECVScalerTables **const cache)
+{
+	OSType const pixelFormat = [src pixelFormat];
+	NSCParameterAssert([dst pixelFormat] == pixelFormat);
+	NSCParameterAssert(cache);
+	ECVComponentOffsets const offsets = ECVPixelFormatComponentOffsets(pixelFormat);
+	ECVIntegerSize const dstSize = [dst pixelSize];
+	size_t const srcBytesPerRow = [src bytesPerRow];
+	size_t const dstBytesPerRow = [dst bytesPerRow];
+	NSRange const validRange = [src validRange];
+	NSInteger const minRow = (validRange.location + srcBytesPerRow - 1) / srcBytesPerRow;
+	NSInteger const maxRow = MIN(NSMaxRange(validRange) / srcBytesPerRow, [src pixelSize].height);
+	NSInteger const pairCount = [src pixelSize].width / 2;
+	if(minRow >= maxRow || !pairCount || dstSize.width < 2 || !dstSize.height || NSIsEmptyRect(srcRect)) return;
+
+	if(!ECVScalerTablesMatch(*cache, srcRect, dstSize, minRow, maxRow, pairCount, pixelFormat, type)) {
+		if(*cache) ECVScalerTablesDestroy(*cache);
+		*cache = ECVScalerTablesCreate(srcRect, dstSize, minRow, maxRow, pairCount, pixelFormat, type);
+	}
+	struct ECVScalerTables const *const tables = *cache;
+	ECVFilter const *const rows = &tables->rows;
+	ECVFilter const *const luma = &tables->luma;
+	ECVFilter const *const chroma = &tables->chroma;
+	size_t const spanLength = tables->spanLength;
+	UInt32 *const sums = tables->sums;
+	UInt8 *const span = tables->span;
+
+	UInt8 const *const srcBytes = (UInt8 const *)[src bytes] - validRange.location + tables->firstPair * 4;
+	UInt8 *const dstBytes = [dst mutableBytes];
+	NSUInteger y = 0;
+	for(; y < dstSize.height; y++) {
+		UInt16 const *const weights = rows->weights + y * rows->tapCount;
+		NSInteger const *const indexes = rows->indexes + y * rows->tapCount;
+		UInt8 const *row = span;
+		NSUInteger i, j;
+		if(ECVFilterOne == weights[0]) {
+			row = srcBytes + indexes[0] * srcBytesPerRow; // Nothing to blend, so read the source directly.
+		} else if(2 == rows->tapCount) {
+			UInt8 const *const row0 = srcBytes + indexes[0] * srcBytesPerRow;
+			UInt8 const *const row1 = srcBytes + indexes[1] * srcBytesPerRow;
+			UInt32 const weight0 = weights[0];
+			UInt32 const weight1 = weights[1];
+			for(i = 0; i < spanLength; i++) span[i] = (UInt8)((ECVFilterOne / 2 + weight0 * row0[i] + weight1 * row1[i]) >> ECVFilterShift);
+		} else {
+			for(i = 0; i < spanLength; i++) sums[i] = ECVFilterOne / 2;
+			for(j = 0; j < rows->tapCount; j++) {
+				UInt32 const weight = weights[j];
+				if(!weight) continue;
+				UInt8 const *const tapRow = srcBytes + indexes[j] * srcBytesPerRow;
+				for(i = 0; i < spanLength; i++) sums[i] += weight * tapRow[i];
+			}
+			for(i = 0; i < spanLength; i++) span[i] = (UInt8)(sums[i] >> ECVFilterShift);
+		}
+
+		UInt8 *const dstRow = dstBytes + y * dstBytesPerRow;
+		if(tables->copiesColumns) {
+			memcpy(dstRow, row + (luma->indexes[0] / 2 - tables->firstPair) * 4, dstSize.width / 2 * 4);
+			continue;
+		}
+		ECVFilterRow(luma, dstSize.width / 2 * 2, row, dstRow + offsets.luma[0], 2);
+		ECVFilterRow(chroma, dstSize.width / 2, row + offsets.blueChroma, dstRow + offsets.blueChroma, 4);
+		ECVFilterRow(chroma, dstSize.width / 2, row + offsets.redChroma, dstRow + offsets.redChroma, 4);
+	}
+}
+
 @implementation ECVPixelBuffer
 
 #pragma mark -ECVPixelBuffer
@@ -208,6 +416,17 @@ static void ECVDrawRect(ECVMutablePixelBuffer *dst, ECVPixelBuffer *src, ECVInte
 	ECVIntegerPoint const srcPoint = (ECVIntegerPoint){0, 0};
 	ECVDrawRect(self, src, dstPoint, srcPoint, [src pixelSize], options);
 }
+- (void)drawPixelBuffer:(ECVPixelBuffer *)src fromRect:(NSRect)rect filter:(ECVPixelBufferScalingFilter)filter
+{
+	struct ECVScalerTables *tables = NULL;
+	ECVScaleRect(self, src, rect, filter, &tables);
+	if(tables) ECVScalerTablesDestroy(tables);
+}
+- (void)drawPixelBuffer:(ECVPixelBuffer *)src fromRect:(NSRect)rect scaler:(ECVPixelBufferScaler *)scaler
+{
+	NSParameterAssert(scaler);
+	[scaler _scalePixelBuffer:src fromRect:rect toPixelBuffer:self];
+}
 
 #pragma mark -
 
@@ -363,3 +582,36 @@ static void ECVDrawRect(ECVMutablePixelBuffer *dst, ECVPixelBuffer *src, ECVInte
 }
 
 @end
+
+@implementation ECVPixelBufferScaler
+
+#pragma mark -ECVPixelBufferScaler
+
+- (id)initWithFilter:(ECVPixelBufferScalingFilter)filter
+{
+	if((self = [super init])) {
+		_filter = filter;
+	}
+	return self;
+}
+- (ECVPixelBufferScalingFilter)filter
+{
+	return _filter;
+}
+
+#pragma mark -ECVPixelBufferScaler(Private)
+
+- (void)_scalePixelBuffer:(ECVPixelBuffer *const)src fromRect:(NSRect const)rect toPixelBuffer:(ECVMutablePixelBuffer *const)dst
+{
+	ECVScaleRect(dst, src, rect, _filter, &_tables);
+}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	if(_tables) ECVScalerTablesDestroy(_tables);
+	[super dealloc];
+}
+
+@end
@@ -73,3 +73,19 @@ static GLenum ECVPixelFormatToGLType(OSType const t)
 	ECVCAssertNotReached(@"Unknown pixel format '%@' (%lu)", [(NSString *)UTCreateStringForOSType(t) autorelease], (unsigned long)t);
 	return 0;
 }
+
+typedef struct {
+	size_t luma[2];
+	size_t blueChroma;
+	size_t redChroma;
+} ECVComponentOffsets; // Within each two-pixel group.
+
+static ECVComponentOffsets ECVPixelFormatComponentOffsets(OSType const t)
+{
+	switch(t) {
+		case k2vuyPixelFormat: return (ECVComponentOffsets){{1, 3}, 0, 2};
+		case kYVYU422PixelFormat: return (ECVComponentOffsets){{0, 2}, 3, 1};
+	}
+	ECVCAssertNotReached(@"Unknown pixel format '%@' (%lu)", [(NSString *)UTCreateStringForOSType(t) autorelease], (unsigned long)t);
+	return (ECVComponentOffsets){{1, 3}, 0, 2};
+}
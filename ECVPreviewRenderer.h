@@ -0,0 +1,54 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVAVTarget.h"
+
+// Models
+@class ECVPixelBuffer;
+
+@protocol ECVPreviewRendererDelegate;
+
+// Makes small RGB previews of the video on the CPU, so thumbnails don't need an OpenGL context and don't add to the texture uploads.
+@interface ECVPreviewRenderer : NSObject <ECVAVTarget>
+{
+	@private
+	NSObject<ECVPreviewRendererDelegate> *_delegate;
+	ECVIntegerSize _outputSize;
+	NSTimeInterval _interval;
+	NSTimeInterval _lastRenderTime;
+	volatile int32_t _rendering;
+}
+
++ (void)drawPixelBuffer:(ECVPixelBuffer *const)buffer toBGRABytes:(UInt8 *const)bytes bytesPerRow:(size_t const)bytesPerRow size:(ECVIntegerSize const)size; // The buffer must be locked. Draw into part of a larger image to build mosaics.
+
+- (id)initWithOutputSize:(ECVIntegerSize const)size interval:(NSTimeInterval const)interval;
+- (NSObject<ECVPreviewRendererDelegate> *)delegate;
+- (void)setDelegate:(NSObject<ECVPreviewRendererDelegate> *const)obj; // Main thread only.
+- (ECVIntegerSize)outputSize;
+- (NSTimeInterval)interval; // Frames arriving sooner are skipped, as are frames arriving while the last one is still rendering.
+
+@end
+
+@protocol ECVPreviewRendererDelegate <NSObject>
+
+- (void)previewRenderer:(ECVPreviewRenderer *const)sender didRenderImage:(CGImageRef const)image; // Called on the main thread.
+
+@end
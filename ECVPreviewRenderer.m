@@ -0,0 +1,171 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVPreviewRenderer.h"
+#import <libkern/OSAtomic.h>
+
+// Models
+#import "ECVVideoFrame.h"
+
+// Other Sources
+#import "ECVDebug.h"
+#import "ECVFoundationAdditions.h"
+#import "ECVPixelFormat.h"
+
+NS_INLINE UInt8 ECVClampComponent(NSInteger const x)
+{
+	return x < 0 ? 0 : (x > 0xff ? 0xff : (UInt8)x);
+}
+static void ECVDrawPreviewRows(UInt8 const *const src, size_t const srcBytesPerRow, ECVIntegerSize const srcSize, ECVComponentOffsets const o, UInt8 *const dst, size_t const dstBytesPerRow, ECVIntegerSize const dstSize, NSUInteger const firstRow, NSUInteger const lastRow)
+{
+	NSUInteger const srcWidth = srcSize.width & ~(NSUInteger)1;
+	NSUInteger oy = firstRow;
+	for(; oy < lastRow; ++oy) {
+		NSUInteger const y0 = oy * srcSize.height / dstSize.height;
+		NSUInteger const y1 = MAX(y0 + 1, (oy + 1) * srcSize.height / dstSize.height);
+		UInt8 *const out = dst + oy * dstBytesPerRow;
+		NSUInteger ox = 0;
+		for(; ox < dstSize.width; ++ox) {
+			// Boxes are rounded out to whole pixel pairs so that every sample has both chroma components.
+			NSUInteger const x0 = (ox * srcWidth / dstSize.width) & ~(NSUInteger)1;
+			NSUInteger const x1 = MIN(srcWidth, MAX(x0 + 2, (((ox + 1) * srcWidth / dstSize.width) + 1) & ~(NSUInteger)1));
+			NSUInteger lumaSum = 0, blueSum = 0, redSum = 0;
+			NSUInteger y = y0;
+			for(; y < y1; ++y) {
+				UInt8 const *const row = src + y * srcBytesPerRow;
+				NSUInteger x = x0;
+				for(; x < x1; x += 2) {
+					UInt8 const *const p = row + x * 2;
+					lumaSum += p[o.luma[0]] + p[o.luma[1]];
+					blueSum += p[o.blueChroma];
+					redSum += p[o.redChroma];
+				}
+			}
+			// Averaging before converting is equivalent because the conversion is linear, and it only costs one conversion per output pixel.
+			NSUInteger const pairs = (y1 - y0) * (x1 - x0) / 2;
+			NSInteger const c = 298 * ((NSInteger)((lumaSum + pairs) / (pairs * 2)) - 16); // Rec. 601, video range, 8.8 fixed point.
+			NSInteger const d = (NSInteger)((blueSum + pairs / 2) / pairs) - 128;
+			NSInteger const e = (NSInteger)((redSum + pairs / 2) / pairs) - 128;
+			UInt8 *const pixel = out + ox * 4;
+			pixel[0] = ECVClampComponent((c + 516 * d + 128) >> 8);
+			pixel[1] = ECVClampComponent((c - 100 * d - 208 * e + 128) >> 8);
+			pixel[2] = ECVClampComponent((c + 409 * e + 128) >> 8);
+			pixel[3] = 0xff;
+		}
+	}
+}
+
+@interface ECVPreviewRenderer(Private)
+
+- (void)_renderFrame:(ECVVideoFrame *const)frame;
+
+@end
+
+@implementation ECVPreviewRenderer
+
+#pragma mark +ECVPreviewRenderer
+
++ (void)drawPixelBuffer:(ECVPixelBuffer *const)buffer toBGRABytes:(UInt8 *const)bytes bytesPerRow:(size_t const)bytesPerRow size:(ECVIntegerSize const)size
+{
+	ECVIntegerSize const srcSize = [buffer pixelSize];
+	if(!size.width || !size.height || srcSize.width < 2 || !srcSize.height) return;
+	UInt8 const *const src = [buffer bytes];
+	size_t const srcBytesPerRow = [buffer bytesPerRow];
+	ECVComponentOffsets const offsets = ECVPixelFormatComponentOffsets([buffer pixelFormat]);
+	size_t const sliceCount = MIN((size_t)size.height, [[NSProcessInfo processInfo] activeProcessorCount] * 2);
+	dispatch_apply(sliceCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t const i) {
+		ECVDrawPreviewRows(src, srcBytesPerRow, srcSize, offsets, bytes, bytesPerRow, size, size.height * i / sliceCount, size.height * (i + 1) / sliceCount);
+	});
+}
+
+#pragma mark -ECVPreviewRenderer
+
+- (id)initWithOutputSize:(ECVIntegerSize const)size interval:(NSTimeInterval const)interval
+{
+	if((self = [super init])) {
+		_outputSize = size;
+		_interval = interval;
+	}
+	return self;
+}
+- (NSObject<ECVPreviewRendererDelegate> *)delegate
+{
+	return _delegate;
+}
+- (void)setDelegate:(NSObject<ECVPreviewRendererDelegate> *const)obj
+{
+	NSParameterAssert([NSThread isMainThread]);
+	_delegate = obj;
+}
+- (ECVIntegerSize)outputSize
+{
+	return _outputSize;
+}
+- (NSTimeInterval)interval
+{
+	return _interval;
+}
+
+#pragma mark -ECVPreviewRenderer(Private)
+
+- (void)_renderFrame:(ECVVideoFrame *const)frame
+{
+	if(![frame lockIfHasBytes]) return;
+	size_t const bytesPerRow = _outputSize.width * 4;
+	NSMutableData *const data = [NSMutableData dataWithLength:bytesPerRow * _outputSize.height];
+	[[self class] drawPixelBuffer:frame toBGRABytes:[data mutableBytes] bytesPerRow:bytesPerRow size:_outputSize];
+	[frame unlock];
+
+	CGDataProviderRef const provider = CGDataProviderCreateWithCFData((CFDataRef)data);
+	CGColorSpaceRef const colorSpace = CGColorSpaceCreateDeviceRGB();
+	CGImageRef const image = CGImageCreate(_outputSize.width, _outputSize.height, 8, 32, bytesPerRow, colorSpace, kCGImageAlphaNoneSkipFirst | kCGBitmapByteOrder32Little, provider, NULL, false, kCGRenderingIntentDefault);
+	dispatch_async(dispatch_get_main_queue(), ^{
+		[_delegate previewRenderer:self didRenderImage:image]; // The delegate is only changed on the main thread, so it can't go away under us here.
+		CGImageRelease(image);
+	});
+	CGColorSpaceRelease(colorSpace);
+	CGDataProviderRelease(provider);
+}
+
+#pragma mark -<ECVAVTarget>
+
+- (void)play
+{
+	_lastRenderTime = 0.0;
+}
+- (void)stop {}
+- (void)pushVideoFrame:(ECVVideoFrame *const)frame
+{
+	if(!frame) return;
+	NSTimeInterval const time = [frame presentationTime] ?: [NSDate ECV_timeIntervalSinceReferenceDate];
+	if(time - _lastRenderTime < _interval) return;
+	if(!OSAtomicCompareAndSwap32Barrier(0, 1, &_rendering)) return; // Never queue up behind a slow render.
+	_lastRenderTime = time;
+	dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+		NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+		[self _renderFrame:frame];
+		OSAtomicCompareAndSwap32Barrier(1, 0, &_rendering);
+		[pool drain];
+	});
+}
+- (void)pushAudioBufferListValue:(NSValue *const)bufferListValue presentationTime:(NSTimeInterval const)time {}
+
+@end
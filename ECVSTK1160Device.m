@@ -51,6 +51,8 @@ enum {
 - (BOOL)_initializeResolution;
 - (BOOL)_setStreaming:(BOOL)flag;
 - (BOOL)_SAA711XExpect:(u_int8_t)val;
+- (BOOL)_writeSAA711XRegister:(u_int8_t)reg value:(int16_t)val;
+- (BOOL)_readSAA711XRegister:(u_int8_t)reg value:(out u_int8_t *)outVal;
 
 @end
 
@@ -157,6 +159,27 @@ enum {
 	ECVLog(ECVError, @"Invalid SAA711X result %x (expected %x)", (unsigned)result, (unsigned)val);
 	return NO;
 }
+- (BOOL)_writeSAA711XRegister:(u_int8_t)reg value:(int16_t)val
+{
+	if(![self writeIndex:0x204 value:reg]) return NO;
+	if(![self writeIndex:0x205 value:val]) return NO;
+	if(![self writeIndex:0x200 value:0x01]) return NO;
+	if(![self _SAA711XExpect:0x04]) {
+		ECVLog(ECVError, @"SAA711X failed to write %x to %x", (unsigned)val, (unsigned)reg);
+		return NO;
+	}
+	return YES;
+}
+- (BOOL)_readSAA711XRegister:(u_int8_t)reg value:(out u_int8_t *)outVal
+{
+	if(![self writeIndex:0x208 value:reg]) return NO;
+	if(![self writeIndex:0x200 value:0x20]) return NO;
+	if(![self _SAA711XExpect:0x01]) {
+		ECVLog(ECVError, @"SAA711X failed to read %x", (unsigned)reg);
+		return NO;
+	}
+	return [self readIndex:0x209 value:outVal];
+}
 
 #pragma mark -ECVCaptureDevice
 
@@ -302,24 +325,17 @@ enum {
 
 - (BOOL)writeSAA711XRegister:(u_int8_t)reg value:(int16_t)val
 {
-	if(![self writeIndex:0x204 value:reg]) return NO;
-	if(![self writeIndex:0x205 value:val]) return NO;
-	if(![self writeIndex:0x200 value:0x01]) return NO;
-	if(![self _SAA711XExpect:0x04]) {
-		ECVLog(ECVError, @"SAA711X failed to write %x to %x", (unsigned)val, (unsigned)reg);
-		return NO;
-	}
-	return YES;
+	[self lockControlRequests]; // Each access is several requests, which the read thread must not interleave with.
+	BOOL const success = [self _writeSAA711XRegister:reg value:val];
+	[self unlockControlRequests];
+	return success;
 }
 - (BOOL)readSAA711XRegister:(u_int8_t)reg value:(out u_int8_t *)outVal
 {
-	if(![self writeIndex:0x208 value:reg]) return NO;
-	if(![self writeIndex:0x200 value:0x20]) return NO;
-	if(![self _SAA711XExpect:0x01]) {
-		ECVLog(ECVError, @"SAA711X failed to read %x", (unsigned)reg);
-		return NO;
-	}
-	return [self readIndex:0x209 value:outVal];
+	[self lockControlRequests];
+	BOOL const success = [self _readSAA711XRegister:reg value:outVal];
+	[self unlockControlRequests];
+	return success;
 }
 
 #pragma mark -<VT1612ADevice>
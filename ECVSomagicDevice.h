@@ -21,18 +21,35 @@ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVCaptureDevice.h"
 
+// Models
+@class ECVFieldHistory;
+
 @interface ECVSomagicDevice : ECVCaptureDevice
 {
 	@private
 	NSInteger _offset;
+	ECVFieldHistory *_fieldHistory;
+	NSUInteger _rowState;
+	UInt8 _rowFlags;
 	BOOL _signalLock;
-	NSUInteger _discard;
+	BOOL _signalAcquired;
 	UInt8 _flags;
 	NSUInteger _hState, _vState;
+
+	UInt64 _lockPosition;
+	UInt64 _lockRowPosition;
+	BOOL _lockRowActive;
+	BOOL _lockFieldValid;
+	NSUInteger _lockRows;
+	NSUInteger _lockFieldStarts;
+	NSUInteger _lockConsistentFields;
+	NSUInteger _lockPreviousRows;
+	UInt8 _lockPreviousFlags;
 }
 
 - (BOOL)getStartOfRow:(out NSUInteger *const)outRow flags:(out UInt8 *const)outFlags withBytes:(UInt8 const *const)bytes length:(NSUInteger const)length;
 - (BOOL)getStartOfField:(out NSUInteger *const)outField flags:(out UInt8 *const)outFlags withBytes:(UInt8 const *const)bytes length:(NSUInteger const)length;
+- (BOOL)getLockedStartOfField:(out NSUInteger *const)outField flags:(out UInt8 *const)outFlags withBytes:(UInt8 const *const)bytes length:(NSUInteger const)length;
 - (void)writePacketBytes:(UInt8 const *)bytes length:(NSUInteger)length toStorage:(ECVVideoStorage *const)storage;
 
 @end
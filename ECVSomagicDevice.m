@@ -20,27 +20,27 @@ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import "ECVSomagicDevice.h"
+
+// Models
+#import "ECVFieldHistory.h"
+#import "ECVVideoFrame.h"
+
+// Other Sources
 #import "ECVDebug.h"
+#import "ECVSomagicSync.h"
+
+#define RECV(request, idx, val, ...) ECVControlRequestMake(ECVControlRead, (request), (val), (idx), __VA_ARGS__)
+#define SEND(request, idx, val, ...) ECVControlRequestMake(ECVControlWrite, (request), (val), (idx), __VA_ARGS__)
 
-#define RECV(request, idx, val, ...) \
-	do { \
-		u_int8_t const expected[] = {__VA_ARGS__}; \
-		u_int8_t data[] = {__VA_ARGS__}; \
-		size_t const length = sizeof(expected); \
-		if(![self readRequest:(request) value:(val) index:(idx) length:length data:data]) return; \
-		if(memcmp(expected, data, length) != 0) ECVLog(ECVNotice, @"Line %d, read %04x: Expected %@, received %@", __LINE__, (idx), [NSData dataWithBytesNoCopy:(void *)expected length:length freeWhenDone:NO], [NSData dataWithBytesNoCopy:(void *)data length:length freeWhenDone:NO]); \
-	} while(0)
-#define SEND(request, idx, val, ...) \
-	do { \
-		u_int8_t data[] = {__VA_ARGS__}; \
-		if(![self writeRequest:(request) value:(val) index:(idx) length:sizeof(data) data:data]) return; \
-	} while(0)
+#define ECVSomagicLockFields 2 // Consecutive consistent fields required before we trust the signal.
+#define ECVSomagicLockGiveUpFields 16 // Lock on whatever we have rather than showing nothing forever.
 
-enum {
-	ECVSomagicLineEnd = 1 << 4,
-	ECVSomagicVerticalBlanking = 1 << 5,
-	ECVSomagicLowField = 1 << 6,
-};
+@interface ECVSomagicDevice(Private)
+
+- (void)_startFieldWithFlags:(UInt8 const)flags inStorage:(ECVVideoStorage *const)storage;
+- (void)_concealRange:(NSRange const)range inStorage:(ECVVideoStorage *const)storage;
+
+@end
 
 @implementation ECVSomagicDevice
 
@@ -48,16 +48,7 @@ enum {
 
 - (BOOL)getStartOfRow:(out NSUInteger *const)outRow flags:(out UInt8 *const)outFlags withBytes:(UInt8 const *const)bytes length:(NSUInteger const)length
 {
-	for(NSUInteger i = 0; i < length; ++i) {
-		switch(_hState) {
-			case 0: if(0xff == bytes[i]) _hState++; else _hState = 0; break;
-			case 1: if(0x00 == bytes[i]) _hState++; else _hState = 0; break;
-			case 2: if(0x00 == bytes[i]) _hState++; else _hState = 0; break;
-			case 3: if(0x00 != bytes[i] && !(ECVSomagicLineEnd & bytes[i])) { _hState++; _flags = bytes[i]; } else _hState = 0; break;
-			case 4: _hState = 0; *outRow = i; *outFlags = _flags; return YES;
-		}
-	}
-	return NO;
+	return ECVSomagicGetStartOfRow(&_hState, &_flags, bytes, length, outRow, outFlags);
 }
 - (BOOL)getStartOfField:(out NSUInteger *const)outField flags:(out UInt8 *const)outFlags withBytes:(UInt8 const *const)bytes length:(NSUInteger const)length
 {
@@ -65,6 +56,7 @@ enum {
 		NSUInteger row;
 		UInt8 flags;
 		if(![self getStartOfRow:&row flags:&flags withBytes:bytes+i length:length-i]) return NO;
+		row += i;
 		i = row;
 		switch(_vState) {
 			case 0: if(ECVSomagicVerticalBlanking & flags) _vState++; break;
@@ -78,17 +70,68 @@ enum {
 	}
 	return NO;
 }
+- (BOOL)getLockedStartOfField:(out NSUInteger *const)outField flags:(out UInt8 *const)outFlags withBytes:(UInt8 const *const)bytes length:(NSUInteger const)length
+{
+	NSUInteger const bytesPerRow = ECVPixelFormatBytesPerPixel([self pixelFormat]) * 720 + 8;
+	for(NSUInteger i = 0; i < length; ++i) {
+		NSUInteger row;
+		UInt8 flags;
+		if(![self getStartOfRow:&row flags:&flags withBytes:bytes+i length:length-i]) break;
+		row += i;
+		i = row;
+		UInt64 const position = _lockPosition + row;
+		BOOL const active = !(ECVSomagicVerticalBlanking & flags);
+		if(active && _lockRowActive && position - _lockRowPosition != bytesPerRow) _lockFieldValid = NO; // Dropped or corrupt line.
+		_lockRowPosition = position;
+		_lockRowActive = active;
+		if(!active) {
+			_vState = 1;
+			continue;
+		}
+		if(!_vState) {
+			_lockRows++;
+			continue;
+		}
+		_vState = 0;
+
+		if(_lockFieldStarts) {
+			BOOL consistent = _lockFieldValid && _lockRows;
+			if(_lockPreviousRows) {
+				if(!(ECVSomagicLowField & (flags ^ _lockPreviousFlags))) consistent = NO; // Fields should alternate.
+				if(MAX(_lockRows, _lockPreviousRows) - MIN(_lockRows, _lockPreviousRows) > 1) consistent = NO; // NTSC fields differ by at most one line.
+			}
+			_lockConsistentFields = consistent ? _lockConsistentFields + 1 : 0;
+			_lockPreviousRows = consistent ? _lockRows : 0;
+		}
+		_lockPreviousFlags = flags;
+		_lockFieldStarts++;
+		_lockFieldValid = YES;
+		_lockRows = 1;
+		if(_lockConsistentFields < ECVSomagicLockFields && _lockFieldStarts <= ECVSomagicLockGiveUpFields) continue;
+		if(_lockConsistentFields < ECVSomagicLockFields) ECVLog(ECVNotice, @"Somagic signal never became consistent; locking anyway.");
+		*outField = row;
+		*outFlags = flags;
+		return YES;
+	}
+	_lockPosition += length;
+	return NO;
+}
 - (void)writePacketBytes:(UInt8 const *)bytes length:(NSUInteger)length toStorage:(ECVVideoStorage *const)storage
 {
 	if(!_signalLock) {
 		NSUInteger i;
 		UInt8 flags;
-		if(![self getStartOfField:&i flags:&flags withBytes:bytes length:length]) return;
+		if(_signalAcquired) {
+			if(![self getStartOfField:&i flags:&flags withBytes:bytes length:length]) return;
+		} else {
+			if(![self getLockedStartOfField:&i flags:&flags withBytes:bytes length:length]) return;
+			_signalAcquired = YES;
+			[self signalDidLock];
+		}
 		bytes += i;
 		length -= i;
 		_signalLock = YES;
-		[self pushVideoFrame:[storage finishedFrameWithNextFieldType:ECVSomagicLowField & flags ? ECVLowField : ECVHighField]];
-		_offset = 0;
+		[self _startFieldWithFlags:flags inStorage:storage];
 	}
 
 	ECVIntegerSize const s = {720, [[self videoFormat] frameSize].height};
@@ -96,15 +139,38 @@ enum {
 	NSUInteger const bytesPerRow = ECVPixelFormatBytesPerPixel(pixelFormat) * s.width + 8;
 	NSUInteger const fieldLength = bytesPerRow * s.height;
 
-	NSUInteger const remaining = fieldLength - _offset;
-	NSUInteger const main = MIN(length, remaining);
-	NSUInteger const extra = length - main;
+	// Packets are shorter than a row, so each one contains at most one row start. Use it to check that we haven't lost anything.
+	NSUInteger main = MIN(length, fieldLength - _offset);
+	BOOL truncated = NO;
+	NSUInteger row;
+	UInt8 rowFlags;
+	if(ECVSomagicGetStartOfRow(&_rowState, &_rowFlags, bytes, main, &row, &rowFlags)) {
+		if(ECVSomagicVerticalBlanking & rowFlags) {
+			main = row; // Active video ended early, so we lost whole lines. Don't let this field eat into the next one.
+			truncated = YES;
+		} else {
+			NSUInteger const misalignment = (_offset + row) % bytesPerRow;
+			if(misalignment) {
+				NSUInteger const lost = MIN(bytesPerRow - misalignment, fieldLength - _offset);
+				[self _concealRange:NSMakeRange(_offset, lost) inStorage:storage];
+				_offset += lost;
+				main = MIN(length, fieldLength - _offset);
+			}
+		}
+	}
 	if(main) {
 		ECVPointerPixelBuffer *const b1 = [[ECVPointerPixelBuffer alloc] initWithPixelSize:s bytesPerRow:bytesPerRow pixelFormat:pixelFormat bytes:bytes validRange:NSMakeRange(_offset, main)];
 		[storage drawPixelBuffer:b1 atPoint:(ECVIntegerPoint){-8, 0}];
 		[b1 release];
+		[_fieldHistory recordBytes:bytes inRange:NSMakeRange(_offset, main)];
 		_offset += main;
 	}
+	if(truncated) {
+		[self _concealRange:NSMakeRange(_offset, fieldLength - _offset) inStorage:storage];
+		_offset = fieldLength;
+		_vState = 1; // We've already seen the blanking row.
+	}
+	NSUInteger const extra = length - main;
 	if(extra) {
 		bytes += length-extra;
 		length = extra;
@@ -113,13 +179,32 @@ enum {
 		if(![self getStartOfField:&i flags:&flags withBytes:bytes length:length]) {
 			_signalLock = NO;
 		} else {
-			[self pushVideoFrame:[storage finishedFrameWithNextFieldType:ECVSomagicLowField & flags ? ECVLowField : ECVHighField]];
-			_offset = 0;
+			[self _startFieldWithFlags:flags inStorage:storage];
 		}
 		[self writePacketBytes:bytes+i length:length-i toStorage:storage];
 	}
 }
 
+#pragma mark -ECVSomagicDevice(Private)
+
+- (void)_startFieldWithFlags:(UInt8 const)flags inStorage:(ECVVideoStorage *const)storage
+{
+	ECVFieldType const fieldType = ECVSomagicLowField & flags ? ECVLowField : ECVHighField;
+	ECVVideoFrame *const frame = [storage finishedFrameWithNextFieldType:fieldType];
+	[frame setConcealedLines:[_fieldHistory concealedLines]];
+	[self pushVideoFrame:frame];
+	[_fieldHistory beginFieldWithType:fieldType];
+	_offset = 0;
+	_rowState = 0;
+}
+- (void)_concealRange:(NSRange const)range inStorage:(ECVVideoStorage *const)storage
+{
+	if(!range.length) return;
+	ECVPointerPixelBuffer *const buffer = [[ECVPointerPixelBuffer alloc] initWithPixelSize:(ECVIntegerSize){720, [[self videoFormat] frameSize].height} bytesPerRow:[_fieldHistory bytesPerRow] pixelFormat:[self pixelFormat] bytes:[_fieldHistory bytesForConcealingRange:range] validRange:range];
+	[storage drawPixelBuffer:buffer atPoint:(ECVIntegerPoint){-8, 0}];
+	[buffer release];
+}
+
 #pragma mark -ECVCaptureDevice
 
 - (id)initWithService:(io_service_t)service
@@ -132,354 +217,378 @@ enum {
 {
 	_offset = 0;
 	_signalLock = NO;
-	_discard = 0;
+	_signalAcquired = NO;
 	_flags = 0;
 	_hState = 0;
 	_vState = 0;
+	_lockPosition = 0;
+	_lockRowPosition = 0;
+	_lockRowActive = NO;
+	_lockFieldValid = NO;
+	_lockRows = 0;
+	_lockFieldStarts = 0;
+	_lockConsistentFields = 0;
+	_lockPreviousRows = 0;
+	_lockPreviousFlags = 0;
+	_rowState = 0;
+	_rowFlags = 0;
+	NSUInteger const bytesPerRow = ECVPixelFormatBytesPerPixel([self pixelFormat]) * 720 + 8;
+	[_fieldHistory release]; // In case an earlier -read bailed out early.
+	_fieldHistory = [[ECVFieldHistory alloc] initWithFieldLength:bytesPerRow * [[self videoFormat] frameSize].height bytesPerRow:bytesPerRow pixelFormat:[self pixelFormat]];
 	if([[self videoSource] composite]) {
 		// GET_DESCRIPTOR_FROM_DEVICE
 		// GET_DESCRIPTOR_FROM_DEVICE
 		// GET_DESCRIPTOR_FROM_DEVICE
 		// SELECT_CONFIGURATION
-		RECV(kUSBRqClearFeature, 0x0000, 0x0001, 0x01, 0x05);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x84, 0xb9, 0x4f, 0xb8, 0x71);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x84, 0xb9, 0x4f, 0xb8, 0x71);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x31, 0xa5, 0x00, 0x00, 0x50, 0x18, 0x85, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x31, 0xa5, 0xc8, 0x00, 0x50, 0x18, 0x85, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x80, 0x00, 0x50, 0x18, 0x85, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x00, 0x00, 0x50, 0x18, 0x85, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x34, 0x00, 0x00, 0x50, 0x18, 0x85, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x34, 0x05, 0x00, 0x50, 0x18, 0x85, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x34, 0x01, 0x00, 0x50, 0x18, 0x85, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x01, 0x00, 0x50, 0x18, 0x85, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x00, 0x00, 0x50, 0x18, 0x85, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x90, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x15, 0x00, 0x00, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x0d, 0x00, 0x00, 0x00, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x0d, 0x00, 0x00, 0x00, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0x53, 0x1e, 0xb4, 0xf2);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xd1);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xd1);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe7, 0x51, 0x1e, 0xb4, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0xe7, 0x51, 0x1e, 0xb4, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0x53, 0x1e, 0xb4, 0xf2);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xd1);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xd1);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe7, 0x51, 0x1e, 0xb4, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0xe7, 0x51, 0x1e, 0xb4, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0x53, 0x1e, 0xb4, 0xf2);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xd1);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xd1);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x5c, 0x5b, 0x1e, 0xb4, 0xf2);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xb1);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xb1);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xb3, 0x58, 0x53, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xec, 0x5b, 0x1e, 0xb4, 0xb1);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xec, 0x5b, 0x1e, 0xb4, 0xb1);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x08, 0x64, 0xf4, 0x87, 0x20);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x08, 0x64, 0xf4, 0x87, 0x20);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x01, 0x08, 0x8a, 0xed, 0xb6, 0x54, 0x80, 0x78);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc7, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x03, 0x33, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x04, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x05, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x06, 0xe9, 0xff, 0x2c, 0x5c, 0x54, 0x80, 0xcc);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x07, 0x0d, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x08, 0x98, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0xff, 0x2c, 0x5c, 0x54, 0x80, 0xcc);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x2c, 0x5c, 0x54, 0x80, 0xcc);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0f, 0x2a, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x10, 0x40, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x11, 0x0c, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x12, 0x01, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x13, 0x80, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x14, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x15, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x16, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x17, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x40, 0x02, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x58, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x59, 0x54, 0xff, 0x2c, 0x5c, 0x54, 0x80, 0xcc);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5a, 0x07, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5b, 0x03, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5e, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc0, 0xb4, 0x00, 0x00, 0x00, 0x00, 0xd4);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x01, 0xb4, 0x00, 0x00, 0x00, 0x00, 0xd4);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0x00, 0x00, 0x50, 0x18, 0x85, 0x67);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc0, 0x87, 0x00, 0x00, 0x00, 0x00, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x01, 0x87, 0x00, 0x00, 0x00, 0x00, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x40, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x85, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x00, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x5b, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x9d, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x00, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x10, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0xdf, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x40, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5a, 0x0a, 0x9d, 0x20, 0x49, 0x0b, 0x01, 0x0b);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x59, 0x54, 0x9d, 0x20, 0x49, 0x0b, 0x01, 0x0b);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5b, 0x83, 0x9d, 0x20, 0x49, 0x0b, 0x01, 0x0b);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x10, 0x40, 0x9d, 0x20, 0x49, 0x0b, 0x01, 0x0b);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x55, 0xff, 0x9d, 0x20, 0x49, 0x0b, 0x01, 0x0b);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x41, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x42, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x43, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x44, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x45, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x46, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x47, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x48, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x49, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4a, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4b, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4c, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4d, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4e, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4f, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x50, 0x77, 0x00, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x51, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x52, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x53, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x54, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0x01, 0x01, 0x54, 0x77, 0xb8, 0x02);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0x01, 0x01, 0x54, 0x77, 0xb8, 0x02);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0x01, 0x01, 0x54, 0x77, 0xb8, 0x02);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0x01, 0x01, 0x54, 0x77, 0xb8, 0x02);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0x00, 0x00, 0x50, 0x18, 0x85, 0x67);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x20, 0x05, 0x4a, 0x8a, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x9a, 0x04, 0x00, 0x00, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x01, 0x00, 0x00, 0x00, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x0001, 0x01, 0x05);
+		static ECVControlRequest const compositeRequests[] = {
+			RECV(kUSBRqClearFeature, 0x0000, 0x0001, 0x01, 0x05),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x84, 0xb9, 0x4f, 0xb8, 0x71),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x84, 0xb9, 0x4f, 0xb8, 0x71),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x31, 0xa5, 0x00, 0x00, 0x50, 0x18, 0x85, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x31, 0xa5, 0xc8, 0x00, 0x50, 0x18, 0x85, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x80, 0x00, 0x50, 0x18, 0x85, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x00, 0x00, 0x50, 0x18, 0x85, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x34, 0x00, 0x00, 0x50, 0x18, 0x85, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x34, 0x05, 0x00, 0x50, 0x18, 0x85, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x34, 0x01, 0x00, 0x50, 0x18, 0x85, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x01, 0x00, 0x50, 0x18, 0x85, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x00, 0x00, 0x50, 0x18, 0x85, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x90, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x15, 0x00, 0x00, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x0d, 0x00, 0x00, 0x00, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x0d, 0x00, 0x00, 0x00, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0x53, 0x1e, 0xb4, 0xf2),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xd1),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xd1),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe7, 0x51, 0x1e, 0xb4, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0xe7, 0x51, 0x1e, 0xb4, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0x53, 0x1e, 0xb4, 0xf2),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xd1),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xd1),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe7, 0x51, 0x1e, 0xb4, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0xe7, 0x51, 0x1e, 0xb4, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0x53, 0x1e, 0xb4, 0xf2),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xd1),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xd1),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x5c, 0x5b, 0x1e, 0xb4, 0xf2),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xb1),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xb1),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xb3, 0x58, 0x53, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xec, 0x5b, 0x1e, 0xb4, 0xb1),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xec, 0x5b, 0x1e, 0xb4, 0xb1),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0x59, 0x1e, 0xb4, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x08, 0x64, 0xf4, 0x87, 0x20),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x08, 0x64, 0xf4, 0x87, 0x20),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x01, 0x08, 0x8a, 0xed, 0xb6, 0x54, 0x80, 0x78),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc7, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x03, 0x33, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x04, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x05, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x06, 0xe9, 0xff, 0x2c, 0x5c, 0x54, 0x80, 0xcc),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x07, 0x0d, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x08, 0x98, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0xff, 0x2c, 0x5c, 0x54, 0x80, 0xcc),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x2c, 0x5c, 0x54, 0x80, 0xcc),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0f, 0x2a, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x10, 0x40, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x11, 0x0c, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x12, 0x01, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x13, 0x80, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x14, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x15, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x16, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x17, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x40, 0x02, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x58, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x59, 0x54, 0xff, 0x2c, 0x5c, 0x54, 0x80, 0xcc),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5a, 0x07, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5b, 0x03, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5e, 0x00, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc0, 0xb4, 0x00, 0x00, 0x00, 0x00, 0xd4),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x01, 0xb4, 0x00, 0x00, 0x00, 0x00, 0xd4),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0x00, 0x00, 0x50, 0x18, 0x85, 0x67),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc0, 0x87, 0x00, 0x00, 0x00, 0x00, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x01, 0x87, 0x00, 0x00, 0x00, 0x00, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x40, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x85, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x00, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x5b, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x9d, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x00, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x10, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0xdf, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x40, 0x18, 0x85, 0x67, 0xf0, 0xdc, 0x9d, 0x20),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5a, 0x0a, 0x9d, 0x20, 0x49, 0x0b, 0x01, 0x0b),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x59, 0x54, 0x9d, 0x20, 0x49, 0x0b, 0x01, 0x0b),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5b, 0x83, 0x9d, 0x20, 0x49, 0x0b, 0x01, 0x0b),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x10, 0x40, 0x9d, 0x20, 0x49, 0x0b, 0x01, 0x0b),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x55, 0xff, 0x9d, 0x20, 0x49, 0x0b, 0x01, 0x0b),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x41, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x42, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x43, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x44, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x45, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x46, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x47, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x48, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x49, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4a, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4b, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4c, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4d, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4e, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4f, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x50, 0x77, 0x00, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x51, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x52, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x53, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x54, 0x77, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0x01, 0x01, 0x54, 0x77, 0xb8, 0x02),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0x01, 0x01, 0x54, 0x77, 0xb8, 0x02),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0x01, 0x01, 0x54, 0x77, 0xb8, 0x02),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0x01, 0x01, 0x54, 0x77, 0xb8, 0x02),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0x00, 0x00, 0x50, 0x18, 0x85, 0x67),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x20, 0x05, 0x4a, 0x8a, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x9a, 0x04, 0x00, 0x00, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x85, 0x01, 0x00, 0x00, 0x00, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x0001, 0x01, 0x05),
+		};
+		if(![self performControlRequests:compositeRequests count:numberof(compositeRequests)]) return;
 		// GET_DESCRIPTOR_FROM_DEVICE
 		// SELECT_INTERFACE
 		[self setAlternateInterface:2];
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x00, 0x50, 0x18, 0x85, 0x00);
+		static ECVControlRequest const compositeStartRequests[] = {
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x00, 0x50, 0x18, 0x85, 0x00),
+		};
+		if(![self performControlRequests:compositeStartRequests count:numberof(compositeStartRequests)]) return;
 	} else {
 		// GET_DESCRIPTOR_FROM_DEVICE
 		// GET_DESCRIPTOR_FROM_DEVICE
 		// GET_DESCRIPTOR_FROM_DEVICE
 		// SELECT_CONFIGURATION
-		RECV(kUSBRqClearFeature, 0x0000, 0x0001, 0x01, 0x05);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x84, 0x39, 0x50, 0xb8, 0x71);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x84, 0x39, 0x50, 0xb8, 0x71);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x31, 0xa5, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x31, 0xa5, 0xc8, 0x00, 0xf0, 0xc9, 0x88, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x80, 0x00, 0xf0, 0xc9, 0x88, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x34, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x34, 0x05, 0x00, 0xf0, 0xc9, 0x88, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x34, 0x01, 0x00, 0xf0, 0xc9, 0x88, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x01, 0x00, 0xf0, 0xc9, 0x88, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x90, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x15, 0x00, 0x00, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x0d, 0x00, 0x00, 0x00, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x0d, 0x00, 0x00, 0x00, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0xd3, 0xc4, 0xb3, 0xf2);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xa6);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xa6);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe7, 0xd1, 0xc4, 0xb3, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0xe7, 0xd1, 0xc4, 0xb3, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0xd3, 0xc4, 0xb3, 0xf2);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xa6);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xa6);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe7, 0xd1, 0xc4, 0xb3, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0xe7, 0xd1, 0xc4, 0xb3, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0xd3, 0xc4, 0xb3, 0xf2);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xa6);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xa6);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x5c, 0xdb, 0xc4, 0xb3, 0xf2);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xc6);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xc6);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xb3, 0x58, 0x53, 0x80, 0xe8);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xec, 0xdb, 0xc4, 0xb3, 0xc6);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xec, 0xdb, 0xc4, 0xb3, 0xc6);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x01, 0x08, 0x8a, 0xed, 0xb6, 0x54, 0x80, 0x28);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc7, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x03, 0x33, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x04, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x05, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x06, 0xe9, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x07, 0x0d, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x08, 0x98, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0f, 0x2a, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x10, 0x40, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x11, 0x0c, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x12, 0x01, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x13, 0x80, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x14, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x15, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x16, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x17, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x40, 0x02, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x58, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x59, 0x54, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5a, 0x07, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5b, 0x03, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5e, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc7, 0xb3, 0x00, 0x00, 0x00, 0x00, 0xd4);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x01, 0xb3, 0x00, 0x00, 0x00, 0x00, 0xd4);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x67);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc7, 0x87, 0x00, 0x00, 0x00, 0x00, 0x50);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x01, 0x87, 0x00, 0x00, 0x00, 0x00, 0x50);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x40, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x88, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x00, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x5b, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x8b, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x00, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x10, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x23, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x40, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5a, 0x0a, 0x8b, 0x48, 0x5a, 0x0b, 0x01, 0x0b);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x59, 0x54, 0x8b, 0x48, 0x5a, 0x0b, 0x01, 0x0b);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5b, 0x83, 0x8b, 0x48, 0x5a, 0x0b, 0x01, 0x0b);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x10, 0x40, 0x8b, 0x48, 0x5a, 0x0b, 0x01, 0x0b);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x55, 0xff, 0x8b, 0x48, 0x5a, 0x0b, 0x01, 0x0b);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x41, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x42, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x43, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x44, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x45, 0x77, 0xff, 0x2c, 0x5c, 0x54, 0x80, 0xcc);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x46, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x47, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x48, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x49, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4a, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4b, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4c, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4d, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4e, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4f, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x50, 0x77, 0xff, 0x2c, 0x5c, 0x54, 0x80, 0xcc);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x51, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x52, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x53, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x54, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0x01, 0x01, 0x54, 0x77, 0xff, 0x02);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0x01, 0x01, 0x54, 0x77, 0xff, 0x02);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0x01, 0x01, 0x54, 0x77, 0xff, 0x02);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0x01, 0x01, 0x54, 0x77, 0xff, 0x02);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x67);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x20, 0x05, 0x4a, 0x8a, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x6c, 0x03, 0x00, 0x00, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x01, 0x00, 0x00, 0x00, 0x00);
-		RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00);
-		SEND(kUSBRqClearFeature, 0x0000, 0x0001, 0x01, 0x05);
+		static ECVControlRequest const SVideoRequests[] = {
+			RECV(kUSBRqClearFeature, 0x0000, 0x0001, 0x01, 0x05),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x84, 0x39, 0x50, 0xb8, 0x71),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x84, 0x39, 0x50, 0xb8, 0x71),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x31, 0xa5, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x31, 0xa5, 0xc8, 0x00, 0xf0, 0xc9, 0x88, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x80, 0x00, 0xf0, 0xc9, 0x88, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x34, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x34, 0x05, 0x00, 0xf0, 0xc9, 0x88, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x34, 0x01, 0x00, 0xf0, 0xc9, 0x88, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x01, 0x00, 0xf0, 0xc9, 0x88, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x00, 0x33, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x90, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x15, 0x00, 0x00, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x0d, 0x00, 0x00, 0x00, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x0d, 0x00, 0x00, 0x00, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0xd3, 0xc4, 0xb3, 0xf2),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xa6),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xa6),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe7, 0xd1, 0xc4, 0xb3, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0xe7, 0xd1, 0xc4, 0xb3, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0xd3, 0xc4, 0xb3, 0xf2),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xa6),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xa6),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe7, 0xd1, 0xc4, 0xb3, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0xe7, 0xd1, 0xc4, 0xb3, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xfc, 0xd3, 0xc4, 0xb3, 0xf2),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xa6),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xa6),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x5c, 0xdb, 0xc4, 0xb3, 0xf2),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xe4, 0x7a, 0x6e, 0x80, 0xc6),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xe4, 0x7a, 0x6e, 0x80, 0xc6),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0xb3, 0x58, 0x53, 0x80, 0xe8),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0xec, 0xdb, 0xc4, 0xb3, 0xc6),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0xec, 0xdb, 0xc4, 0xb3, 0xc6),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x80, 0x47, 0xd9, 0xc4, 0xb3, 0x01),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3a, 0x80, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x00, 0x3b, 0x00, 0x27, 0x74, 0x6e, 0x80, 0x08),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x01, 0x08, 0x8a, 0xed, 0xb6, 0x54, 0x80, 0x28),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc7, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x03, 0x33, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x04, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x05, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x06, 0xe9, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x07, 0x0d, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x08, 0x98, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x81, 0xb8, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0f, 0x2a, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x10, 0x40, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x11, 0x0c, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x12, 0x01, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x13, 0x80, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x14, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x15, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x16, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x17, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x40, 0x02, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x58, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x59, 0x54, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5a, 0x07, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5b, 0x03, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5e, 0x00, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc7, 0xb3, 0x00, 0x00, 0x00, 0x00, 0xd4),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x01, 0xb3, 0x00, 0x00, 0x00, 0x00, 0xd4),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x67),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x02, 0xc7, 0x87, 0x00, 0x00, 0x00, 0x00, 0x50),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0e, 0x01, 0x87, 0x00, 0x00, 0x00, 0x00, 0x50),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x40, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x88, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x00, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x5b, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x8b, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x00, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0x84, 0x00, 0x01, 0x10, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x23, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xa0, 0x00, 0x01, 0x40, 0xc9, 0x88, 0x67, 0xa0, 0x22, 0x8b, 0x48),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5a, 0x0a, 0x8b, 0x48, 0x5a, 0x0b, 0x01, 0x0b),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x59, 0x54, 0x8b, 0x48, 0x5a, 0x0b, 0x01, 0x0b),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x5b, 0x83, 0x8b, 0x48, 0x5a, 0x0b, 0x01, 0x0b),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x10, 0x40, 0x8b, 0x48, 0x5a, 0x0b, 0x01, 0x0b),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x55, 0xff, 0x8b, 0x48, 0x5a, 0x0b, 0x01, 0x0b),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x41, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x42, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x43, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x44, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x45, 0x77, 0xff, 0x2c, 0x5c, 0x54, 0x80, 0xcc),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x46, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x47, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x48, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x49, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4a, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4b, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4c, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4d, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4e, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x4f, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x50, 0x77, 0xff, 0x2c, 0x5c, 0x54, 0x80, 0xcc),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x51, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x52, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x53, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x54, 0x77, 0xff, 0x02, 0x01, 0x00, 0x00, 0x10),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0a, 0x80, 0x01, 0x01, 0x54, 0x77, 0xff, 0x02),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0b, 0x40, 0x01, 0x01, 0x54, 0x77, 0xff, 0x02),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0d, 0x00, 0x01, 0x01, 0x54, 0x77, 0xff, 0x02),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x0c, 0x40, 0x01, 0x01, 0x54, 0x77, 0xff, 0x02),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x4a, 0xc0, 0x01, 0x01, 0x09, 0x01, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x67),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x24, 0xbd, 0x54, 0x80, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x20, 0x05, 0x4a, 0x8a, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x6c, 0x03, 0x00, 0x00, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x88, 0x01, 0x00, 0x00, 0x00, 0x00),
+			RECV(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x20, 0x82, 0x01, 0x30, 0x80, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00),
+			SEND(kUSBRqClearFeature, 0x0000, 0x0001, 0x01, 0x05),
+		};
+		if(![self performControlRequests:SVideoRequests count:numberof(SVideoRequests)]) return;
 		// GET_DESCRIPTOR_FROM_DEVICE
 		// SELECT_INTERFACE
 		[self setAlternateInterface:2];
-		SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x00);
+		static ECVControlRequest const SVideoStartRequests[] = {
+			SEND(kUSBRqClearFeature, 0x0000, 0x000b, 0x0b, 0x00, 0x00, 0x82, 0x01, 0x17, 0x40, 0x00, 0x00, 0xf0, 0xc9, 0x88, 0x00),
+		};
+		if(![self performControlRequests:SVideoStartRequests count:numberof(SVideoStartRequests)]) return;
 	}
 	[super read];
 	[self setAlternateInterface:0];
+	[_fieldHistory release];
+	_fieldHistory = nil;
 }
 - (void)writeBytes:(UInt8 const *const)bytes length:(NSUInteger const)length toStorage:(ECVVideoStorage *const)storage
 {
-	if(_discard < 724*263*2*20) {
-		_discard += length;
-		return;
-	}
 	NSUInteger const packetLength = 1024;
 	NSUInteger const headerLength = 4;
 	for(NSUInteger i = headerLength; i < length; i += packetLength) {
@@ -521,4 +630,12 @@ enum {
 	return k2vuyPixelFormat;
 }
 
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	[_fieldHistory release];
+	[super dealloc];
+}
+
 @end
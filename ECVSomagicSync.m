@@ -0,0 +1,42 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVSomagicSync.h"
+
+BOOL ECVSomagicGetStartOfRow(NSUInteger *const state, UInt8 *const pendingFlags, UInt8 const *const bytes, NSUInteger const length, NSUInteger *const outRow, UInt8 *const outFlags)
+{
+	for(NSUInteger i = 0; i < length; ++i) {
+		if(!*state) {
+			// 0xff is reserved for sync codes and never appears in active video, so let memchr() skip straight to the next candidate. The state machine below still handles matches split across packets.
+			UInt8 const *const candidate = memchr(bytes + i, 0xff, length - i);
+			if(!candidate) return NO;
+			i = candidate - bytes;
+		}
+		switch(*state) {
+			case 0: if(0xff == bytes[i]) (*state)++; else *state = 0; break;
+			case 1: if(0x00 == bytes[i]) (*state)++; else *state = 0; break;
+			case 2: if(0x00 == bytes[i]) (*state)++; else *state = 0; break;
+			case 3: if(0x00 != bytes[i] && !(ECVSomagicLineEnd & bytes[i])) { (*state)++; *pendingFlags = bytes[i]; } else *state = 0; break;
+			case 4: *state = 0; *outRow = i; *outFlags = *pendingFlags; return YES;
+		}
+	}
+	return NO;
+}
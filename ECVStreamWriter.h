@@ -0,0 +1,136 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import <CoreMedia/CoreMedia.h>
+#import <CoreAudio/CoreAudioTypes.h>
+#import <sys/uio.h>
+
+// Models
+@class ECVVideoStorage;
+@class ECVVideoFrame;
+@class ECVPixelBuffer;
+
+// Other Sources
+@class ECVAudioInput;
+@class ECVAudioPipe;
+@class ECVDiskWriter;
+#import "ECVHistoryBuffer.h"
+
+extern NSString *const ECVRecordingBufferSizeKey; // Bytes held in memory while the disk catches up. QuickTime recordings use it for their queue of encoded frames.
+extern NSString *const ECVRecordingSyncIntervalKey; // Seconds between syncs. 0 only syncs at the end.
+
+#define ECVStreamWriterMaxPendingFrames 16
+
+// Writes recordings without QuickTime, so it works in 64-bit builds. Frames are copied once into an ECVDiskWriter, which releases their storage slots quickly even when the disk stalls.
+@interface ECVStreamWriter : NSObject <ECVHistoryBufferRecipient>
+{
+	@private
+	NSURL *_URL;
+	int _fileDescriptor;
+	ECVIntegerSize _pixelSize;
+	OSType _pixelFormat;
+	OSType _videoCodec;
+	CMTime _frameRate;
+	ECVAudioPipe *_audioPipe;
+	dispatch_queue_t _queue;
+	volatile int32_t _pendingFrameCount;
+	NSCondition *_readyCondition; // Broadcast whenever a pending frame has been written.
+	ECVDiskWriter *_diskWriter;
+	BOOL _stopped;
+
+	NSUInteger _frameCount;
+	NSUInteger _writtenFrameCount;
+	NSUInteger _droppedFrameCount;
+	NSUInteger _repeatedFrameCount;
+	UInt64 _audioFrameCount;
+	NSTimeInterval _frameTime;
+}
+
++ (Class)writerClassForPathExtension:(NSString *const)extension; // ECVY4MWriter for "y4m", ECVMatroskaWriter for "mkv".
+
+- (id)initWithURL:(NSURL *const)URL videoStorage:(ECVVideoStorage *const)storage videoCodec:(OSType const)codec audioInput:(ECVAudioInput *const)input upconvertsFromMono:(BOOL const)flag error:(out NSError **const)outError; // Codecs other than ECVLosslessCodecType are written uncompressed.
+- (NSURL *)URL;
+- (ECVIntegerSize)pixelSize;
+- (OSType)pixelFormat;
+- (OSType)videoCodec;
+- (CMTime)frameRate;
+- (BOOL)hasAudio;
+
+- (void)addVideoFrame:(ECVVideoFrame *const)frame; // Never blocks. Frames are dropped if too many are pending.
+- (void)addAudioBufferList:(AudioBufferList const *const)bufferList presentationTime:(NSTimeInterval const)time;
+- (void)stopRecording; // Blocks until everything is written.
+
+- (BOOL)isReadyForMoreVideoFrames; // Whether -addVideoFrame: would accept another frame right now.
+- (BOOL)waitUntilReadyForMoreVideoFramesBeforeDate:(NSDate *const)date;
+
+- (NSUInteger)frameCount; // Including repeats in place of dropped frames and frames without bytes, so later frames keep their timing in both formats.
+- (NSUInteger)writtenFrameCount; // Distinct frames, not counting repeats.
+- (NSUInteger)droppedFrameCount;
+- (NSUInteger)repeatedFrameCount;
+
+// For subclasses, on the writer queue.
+- (off_t)fileLength; // Including bytes that haven't reached the disk.
+- (UInt64)audioFrameCount;
+- (void)appendBytes:(void const *const)bytes length:(size_t const)length;
+- (void)writeVectors:(struct iovec const *const)vectors count:(NSUInteger const)count;
+- (void)writeBytes:(void const *const)bytes length:(size_t const)length atOffset:(off_t const)offset; // For patching sizes.
+
+@end
+
+@interface ECVStreamWriter(ECVAbstract)
+
+- (void)writeHeader;
+- (void)writeVideoFrame:(ECVPixelBuffer *const)frame; // Locked.
+- (BOOL)repeatVideoFrame; // Shows the last video frame for one more frame. Returns NO if there isn't one yet.
+- (void)writeTrailer;
+
+@end
+
+@interface ECVStreamWriter(ECVOptional)
+
+- (void)writeVideoData:(NSData *const)data; // Without this, frames are always written uncompressed.
+- (void)writeAudioBytes:(void const *const)bytes length:(size_t const)length frameCount:(NSUInteger const)count; // Without this, audio is ignored.
+
+@end
+
+// YUV4MPEG2. Planar, so each frame is de-interleaved once on the way out. There is no audio track.
+@interface ECVY4MWriter : ECVStreamWriter
+{
+	@private
+	UInt8 *_planes; // Still holds the last frame, for repeats.
+	size_t _planesLength;
+}
+
+@end
+
+// Matroska with uncompressed or lossless video and 32-bit float PCM audio.
+@interface ECVMatroskaWriter : ECVStreamWriter
+{
+	@private
+	off_t _segmentOffset;
+	off_t _durationOffset;
+	off_t _clusterOffset;
+	UInt64 _clusterTimecode;
+	UInt64 _lastTimecode;
+	BOOL _hasVideoFrame; // Repeats just leave a gap in the timecodes.
+}
+
+@end
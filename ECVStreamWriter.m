@@ -0,0 +1,574 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVStreamWriter.h"
+#import <fcntl.h>
+#import <libkern/OSAtomic.h>
+
+// Models
+#import "ECVVideoFormat.h"
+#import "ECVVideoStorage.h"
+#import "ECVVideoFrame.h"
+
+// Other Sources
+#if defined(ECV_ENABLE_AUDIO)
+#import "ECVAudioDevice.h"
+#import "ECVAudioPipe.h"
+#endif
+#import "ECVDebug.h"
+#import "ECVDiskWriter.h"
+#import "ECVEBML.h"
+#import "ECVFoundationAdditions.h"
+#import "ECVLosslessCodec.h"
+#import "ECVPixelFormat.h"
+
+#define ECVStreamWriterAudioBufferFrames 1000
+
+NSString *const ECVRecordingBufferSizeKey = @"ECVRecordingBufferSize";
+NSString *const ECVRecordingSyncIntervalKey = @"ECVRecordingSyncInterval";
+
+@interface ECVStreamWriter(Private)
+
+- (void)_writeFrame:(ECVVideoFrame *const)frame;
+- (void)_repeatFrame;
+- (void)_writeAvailableAudio;
+
+@end
+
+@implementation ECVStreamWriter
+
+#pragma mark +ECVStreamWriter
+
++ (Class)writerClassForPathExtension:(NSString *const)extension
+{
+	NSString *const e = [extension lowercaseString];
+	if([@"y4m" isEqualToString:e]) return [ECVY4MWriter class];
+	if([@"mkv" isEqualToString:e]) return [ECVMatroskaWriter class];
+	return Nil;
+}
+
+#pragma mark -ECVStreamWriter
+
+- (id)initWithURL:(NSURL *const)URL videoStorage:(ECVVideoStorage *const)storage videoCodec:(OSType const)codec audioInput:(ECVAudioInput *const)input upconvertsFromMono:(BOOL const)flag error:(out NSError **const)outError
+{
+	if(outError) *outError = nil;
+	if(!(self = [super init])) return nil;
+
+	_URL = [URL copy];
+	_fileDescriptor = -1;
+	_pixelSize = [[storage videoFormat] frameSize];
+	_pixelFormat = [storage pixelFormat];
+	_videoCodec = ECVLosslessCodecType == codec && [self respondsToSelector:@selector(writeVideoData:)] ? codec : 0;
+	_frameRate = [[storage videoFormat] frameRate];
+#if defined(ECV_ENABLE_AUDIO)
+	ECVAudioStream *const inputStream = [[[input streams] objectEnumerator] nextObject];
+	if(inputStream && [self respondsToSelector:@selector(writeAudioBytes:length:frameCount:)]) {
+		_audioPipe = [[ECVAudioPipe alloc] initWithInputDescription:[inputStream basicDescription] outputDescription:ECVStandardAudioStreamBasicDescription upconvertFromMono:flag];
+		[_audioPipe setDropsBuffers:NO];
+	}
+#endif
+
+	_fileDescriptor = open([[URL path] fileSystemRepresentation], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(-1 == _fileDescriptor) {
+		if(outError) *outError = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+		[self release];
+		return nil;
+	}
+	NSUserDefaults *const d = [NSUserDefaults standardUserDefaults];
+	_diskWriter = [[ECVDiskWriter alloc] initWithFileDescriptor:_fileDescriptor capacity:(size_t)MAX([d integerForKey:ECVRecordingBufferSizeKey], 0) syncInterval:[d doubleForKey:ECVRecordingSyncIntervalKey]];
+	if(!_diskWriter) {
+		if(outError) *outError = [NSError errorWithDomain:NSPOSIXErrorDomain code:ENOMEM userInfo:nil];
+		[self release];
+		return nil;
+	}
+	_readyCondition = [[NSCondition alloc] init];
+	_queue = dispatch_queue_create("ECVStreamWriter", NULL);
+	dispatch_async(_queue, ^{
+		[self writeHeader];
+	});
+	return self;
+}
+- (NSURL *)URL
+{
+	return [[_URL retain] autorelease];
+}
+- (ECVIntegerSize)pixelSize
+{
+	return _pixelSize;
+}
+- (OSType)pixelFormat
+{
+	return _pixelFormat;
+}
+- (OSType)videoCodec
+{
+	return _videoCodec;
+}
+- (CMTime)frameRate
+{
+	return _frameRate;
+}
+- (BOOL)hasAudio
+{
+	return !!_audioPipe;
+}
+
+#pragma mark -
+
+- (void)addVideoFrame:(ECVVideoFrame *const)frame
+{
+	if(OSAtomicIncrement32Barrier(&_pendingFrameCount) > ECVStreamWriterMaxPendingFrames) {
+		// Pending frames pin storage buffers, so don't let a slow disk take them all.
+		OSAtomicDecrement32Barrier(&_pendingFrameCount);
+		dispatch_async(_queue, ^{
+			_droppedFrameCount++;
+			[self _repeatFrame];
+		});
+		return;
+	}
+	dispatch_async(_queue, ^{
+		[self _writeFrame:frame];
+		OSAtomicDecrement32Barrier(&_pendingFrameCount);
+		[_readyCondition lock];
+		[_readyCondition broadcast];
+		[_readyCondition unlock];
+	});
+}
+- (void)addAudioBufferList:(AudioBufferList const *const)bufferList presentationTime:(NSTimeInterval const)time
+{
+#if defined(ECV_ENABLE_AUDIO)
+	if(!_audioPipe) return;
+	[_audioPipe receiveInputBufferList:bufferList];
+	dispatch_async(_queue, ^{
+		[self _writeAvailableAudio];
+	});
+#endif
+}
+- (void)stopRecording
+{
+	dispatch_sync(_queue, ^{
+		if(_stopped) return;
+		[self _writeAvailableAudio];
+		[self writeTrailer];
+		_stopped = YES;
+		[_diskWriter close];
+		close(_fileDescriptor);
+		_fileDescriptor = -1;
+	});
+	off_t const length = [_diskWriter length];
+	NSTimeInterval const writeTime = [_diskWriter writeTime];
+	ECVLog(ECVNotice, @"Wrote %lu frames and %lu repeats (%lu dropped), %.1f MB at %.1f MB/s, %.2f ms per frame.", (unsigned long)_writtenFrameCount, (unsigned long)_repeatedFrameCount, (unsigned long)_droppedFrameCount, length / 1.0e6, writeTime ? length / writeTime / 1.0e6 : 0.0, _writtenFrameCount ? _frameTime / _writtenFrameCount * 1000.0 : 0.0);
+	ECVLog(ECVNotice, @"Disk buffer peaked at %.1f of %.1f MB; waited %.2f s for room, %.2f s syncing.", [_diskWriter highWaterMark] / 1.0e6, [_diskWriter capacity] / 1.0e6, [_diskWriter stallTime], [_diskWriter syncTime]);
+}
+
+#pragma mark -
+
+- (BOOL)isReadyForMoreVideoFrames
+{
+	return _pendingFrameCount < ECVStreamWriterMaxPendingFrames;
+}
+- (BOOL)waitUntilReadyForMoreVideoFramesBeforeDate:(NSDate *const)date
+{
+	[_readyCondition lock];
+	BOOL ready = NO;
+	while(!(ready = [self isReadyForMoreVideoFrames]) && [_readyCondition waitUntilDate:date]);
+	[_readyCondition unlock];
+	return ready;
+}
+
+#pragma mark -
+
+- (NSUInteger)frameCount
+{
+	return _frameCount;
+}
+- (NSUInteger)writtenFrameCount
+{
+	return _writtenFrameCount;
+}
+- (NSUInteger)droppedFrameCount
+{
+	return _droppedFrameCount;
+}
+- (NSUInteger)repeatedFrameCount
+{
+	return _repeatedFrameCount;
+}
+
+#pragma mark -
+
+- (off_t)fileLength
+{
+	return [_diskWriter length];
+}
+- (UInt64)audioFrameCount
+{
+	return _audioFrameCount;
+}
+- (void)appendBytes:(void const *const)bytes length:(size_t const)length
+{
+	if(!_stopped) [_diskWriter appendBytes:bytes length:length];
+}
+- (void)writeVectors:(struct iovec const *const)vectors count:(NSUInteger const)count
+{
+	NSUInteger i = 0;
+	for(; i < count; i++) [self appendBytes:vectors[i].iov_base length:vectors[i].iov_len];
+}
+- (void)writeBytes:(void const *const)bytes length:(size_t const)length atOffset:(off_t const)offset
+{
+	[_diskWriter writeBytes:bytes length:length atOffset:offset];
+}
+
+#pragma mark -ECVStreamWriter(Private)
+
+- (void)_writeFrame:(ECVVideoFrame *const)frame
+{
+	if(_stopped || [_diskWriter failed]) return;
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	NSTimeInterval const startTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+	BOOL written = NO;
+	if(ECVLosslessCodecType == _videoCodec) {
+		NSData *data = nil;
+		if([frame lockIfHasBytes]) {
+			data = ECVLosslessEncodePixelBuffer(frame);
+			[frame unlock];
+		}
+		if(data) [self writeVideoData:data];
+		written = !!data;
+	} else if([frame lockIfHasBytes]) {
+		[self writeVideoFrame:frame];
+		[frame unlock];
+		written = YES;
+	}
+	if(written) {
+		_frameCount++;
+		_writtenFrameCount++;
+		_frameTime += [NSDate ECV_timeIntervalSinceReferenceDate] - startTime;
+	} else {
+		[self _repeatFrame];
+	}
+	[pool release];
+}
+- (void)_repeatFrame
+{
+	// Fill the slot with the previous frame. Matroska leaves a gap in the timecodes, so the previous block lasts longer; Y4M has no timestamps, so it writes the frame again rather than pull later frames earlier.
+	if(_stopped || [_diskWriter failed]) return;
+	if([self repeatVideoFrame]) _repeatedFrameCount++;
+	_frameCount++; // Before the first frame there's nothing to repeat, so Matroska starts a little late.
+}
+- (void)_writeAvailableAudio
+{
+#if defined(ECV_ENABLE_AUDIO)
+	if([_diskWriter failed]) return;
+	UInt8 buffer[ECVStreamWriterAudioBufferFrames * sizeof(Float32) * ECVChannelsPerFrame];
+	while([_audioPipe hasReadyBuffers]) {
+		AudioBufferList outputBufferList = {1, {2, sizeof(buffer), buffer}};
+		[_audioPipe requestOutputBufferList:&outputBufferList];
+		ByteCount const size = outputBufferList.mBuffers[0].mDataByteSize;
+		if(!size || !outputBufferList.mBuffers[0].mData) break;
+		NSUInteger const count = size / ECVStandardAudioStreamBasicDescription.mBytesPerFrame;
+		[self writeAudioBytes:outputBufferList.mBuffers[0].mData length:size frameCount:count];
+		_audioFrameCount += count;
+	}
+#endif
+}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	if(!_stopped) [_diskWriter close]; // Never stopped, so the write thread may still be using the descriptor. This joins it.
+	if(-1 != _fileDescriptor) close(_fileDescriptor);
+	if(_queue) dispatch_release(_queue);
+	[_diskWriter release];
+	[_readyCondition release];
+	[_URL release];
+	[_audioPipe release];
+	[super dealloc];
+}
+
+@end
+
+@implementation ECVY4MWriter
+
+#pragma mark -ECVStreamWriter(ECVAbstract)
+
+- (void)writeHeader
+{
+	ECVIntegerSize const s = [self pixelSize];
+	CMTime const r = [self frameRate];
+	NSData *const header = [[NSString stringWithFormat:@"YUV4MPEG2 W%lu H%lu F%lld:%lld Ip A0:0 C422\n", (unsigned long)s.width, (unsigned long)s.height, (long long)r.timescale, (long long)r.value] dataUsingEncoding:NSASCIIStringEncoding];
+	[self appendBytes:[header bytes] length:[header length]];
+}
+- (void)writeVideoFrame:(ECVPixelBuffer *const)frame
+{
+	ECVIntegerSize const s = [frame pixelSize];
+	size_t const lumaLength = s.width * s.height;
+	size_t const chromaLength = s.width / 2 * s.height;
+	if(!_planes) _planes = malloc(lumaLength + chromaLength * 2);
+	UInt8 *const y = _planes;
+	UInt8 *const cb = y + lumaLength;
+	UInt8 *const cr = cb + chromaLength;
+	UInt8 const *const src = [frame bytes];
+	size_t const bytesPerRow = [frame bytesPerRow];
+	ECVComponentOffsets const o = ECVPixelFormatComponentOffsets([frame pixelFormat]);
+	NSUInteger row, i;
+	for(row = 0; row < s.height; row++) {
+		UInt8 const *const p = src + bytesPerRow * row;
+		UInt8 *const rowY = y + s.width * row;
+		UInt8 *const rowCb = cb + s.width / 2 * row;
+		UInt8 *const rowCr = cr + s.width / 2 * row;
+		for(i = 0; i < s.width / 2; i++) {
+			rowY[i * 2 + 0] = p[i * 4 + o.luma[0]];
+			rowY[i * 2 + 1] = p[i * 4 + o.luma[1]];
+			rowCb[i] = p[i * 4 + o.blueChroma];
+			rowCr[i] = p[i * 4 + o.redChroma];
+		}
+	}
+	_planesLength = lumaLength + chromaLength * 2;
+	[self repeatVideoFrame];
+}
+- (BOOL)repeatVideoFrame
+{
+	if(!_planesLength) return NO;
+	static char const tag[] = "FRAME\n";
+	[self appendBytes:tag length:sizeof(tag) - 1];
+	struct iovec const vector = {_planes, _planesLength};
+	[self writeVectors:&vector count:1];
+	return YES;
+}
+- (void)writeTrailer {}
+
+#pragma mark -NSObject
+
+- (void)dealloc
+{
+	free(_planes);
+	[super dealloc];
+}
+
+@end
+
+#define ECVMatroskaSegmentID 0x18538067
+#define ECVMatroskaInfoID 0x1549A966
+#define ECVMatroskaTimecodeScaleID 0x2AD7B1
+#define ECVMatroskaDurationID 0x4489
+#define ECVMatroskaMuxingAppID 0x4D80
+#define ECVMatroskaWritingAppID 0x5741
+#define ECVMatroskaTracksID 0x1654AE6B
+#define ECVMatroskaTrackEntryID 0xAE
+#define ECVMatroskaTrackNumberID 0xD7
+#define ECVMatroskaTrackUIDID 0x73C5
+#define ECVMatroskaTrackTypeID 0x83
+#define ECVMatroskaFlagLacingID 0x9C
+#define ECVMatroskaCodecIDID 0x86
+#define ECVMatroskaCodecPrivateID 0x63A2
+#define ECVMatroskaDefaultDurationID 0x23E383
+#define ECVMatroskaVideoID 0xE0
+#define ECVMatroskaPixelWidthID 0xB0
+#define ECVMatroskaPixelHeightID 0xBA
+#define ECVMatroskaColourSpaceID 0x2EB524
+#define ECVMatroskaAudioID 0xE1
+#define ECVMatroskaSamplingFrequencyID 0xB5
+#define ECVMatroskaChannelsID 0x9F
+#define ECVMatroskaBitDepthID 0x6264
+#define ECVMatroskaClusterID 0x1F43B675
+#define ECVMatroskaTimecodeID 0xE7
+#define ECVMatroskaSimpleBlockID 0xA3
+
+#define ECVMatroskaVideoTrack 1
+#define ECVMatroskaAudioTrack 2
+#define ECVMatroskaTimecodesPerSecond 1000 // A timecode scale of 1 ms.
+#define ECVMatroskaClusterDuration 1000
+@interface ECVMatroskaWriter(Private)
+
+- (UInt64)_videoTimecodeForFrame:(NSUInteger const)index;
+- (void)_patchSizeAtOffset:(off_t const)offset;
+- (void)_appendBlockHeaderWithTrack:(UInt8 const)track timecode:(UInt64 const)timecode length:(size_t const)length;
+
+@end
+
+@implementation ECVMatroskaWriter
+
+#pragma mark -ECVMatroskaWriter(Private)
+
+- (UInt64)_videoTimecodeForFrame:(NSUInteger const)index
+{
+	CMTime const r = [self frameRate];
+	return r.timescale ? (UInt64)index * r.value * ECVMatroskaTimecodesPerSecond / r.timescale : 0;
+}
+- (void)_patchSizeAtOffset:(off_t const)offset
+{
+	// The size field is the 8 bytes right before the element's data.
+	UInt8 bytes[8];
+	ECVEBMLEncodeSize8([self fileLength] - offset, bytes);
+	[self writeBytes:bytes length:sizeof(bytes) atOffset:offset - sizeof(bytes)];
+}
+- (void)_appendBlockHeaderWithTrack:(UInt8 const)track timecode:(UInt64 const)timecode length:(size_t const)length
+{
+	SInt64 const delta = (SInt64)timecode - (SInt64)_clusterTimecode;
+	NSMutableData *const data = [NSMutableData data];
+	if(!_clusterOffset || delta >= ECVMatroskaClusterDuration || delta < INT16_MIN) {
+		if(_clusterOffset) [self _patchSizeAtOffset:_clusterOffset];
+		ECVEBMLAppendUnknownSizeMaster(data, ECVMatroskaClusterID);
+		_clusterOffset = [self fileLength] + [data length];
+		_clusterTimecode = timecode;
+		ECVEBMLAppendUnsigned(data, ECVMatroskaTimecodeID, timecode);
+	}
+	SInt16 const relative = (SInt16)((SInt64)timecode - (SInt64)_clusterTimecode);
+	UInt8 const header[4] = {0x80 | track, (UInt8)((UInt16)relative >> 8), (UInt8)relative, 0x80}; // Every frame is a keyframe.
+	ECVEBMLAppendID(data, ECVMatroskaSimpleBlockID);
+	ECVEBMLAppendSize(data, sizeof(header) + length);
+	[data appendBytes:header length:sizeof(header)];
+	[self appendBytes:[data bytes] length:[data length]];
+	_lastTimecode = MAX(_lastTimecode, timecode);
+}
+
+#pragma mark -ECVStreamWriter(ECVAbstract)
+
+- (void)writeHeader
+{
+	NSMutableData *const data = [NSMutableData data];
+
+	NSMutableData *const EBML = [NSMutableData data];
+	ECVEBMLAppendUnsigned(EBML, ECVEBMLVersionID, 1);
+	ECVEBMLAppendUnsigned(EBML, ECVEBMLReadVersionID, 1);
+	ECVEBMLAppendUnsigned(EBML, ECVEBMLMaxIDLengthID, 4);
+	ECVEBMLAppendUnsigned(EBML, ECVEBMLMaxSizeLengthID, 8);
+	ECVEBMLAppendString(EBML, ECVEBMLDocTypeID, "matroska");
+	ECVEBMLAppendUnsigned(EBML, ECVEBMLDocTypeVersionID, 2);
+	ECVEBMLAppendUnsigned(EBML, ECVEBMLDocTypeReadVersionID, 2);
+	ECVEBMLAppendMaster(data, ECVEBMLHeaderID, EBML);
+
+	ECVEBMLAppendUnknownSizeMaster(data, ECVMatroskaSegmentID);
+	_segmentOffset = [data length];
+
+	NSMutableData *const info = [NSMutableData data];
+	ECVEBMLAppendUnsigned(info, ECVMatroskaTimecodeScaleID, 1000000000 / ECVMatroskaTimecodesPerSecond);
+	ECVEBMLAppendString(info, ECVMatroskaMuxingAppID, "EasyCapViewer");
+	ECVEBMLAppendString(info, ECVMatroskaWritingAppID, "EasyCapViewer");
+	ECVEBMLAppendFloat(info, ECVMatroskaDurationID, 0.0); // Last, so we know where to patch it.
+	ECVEBMLAppendMaster(data, ECVMatroskaInfoID, info);
+	_durationOffset = [data length] - sizeof(CFSwappedFloat64);
+
+	ECVIntegerSize const s = [self pixelSize];
+	CMTime const r = [self frameRate];
+	BOOL const lossless = ECVLosslessCodecType == [self videoCodec];
+	NSMutableData *const tracks = [NSMutableData data];
+	NSMutableData *const videoEntry = [NSMutableData data];
+	ECVEBMLAppendUnsigned(videoEntry, ECVMatroskaTrackNumberID, ECVMatroskaVideoTrack);
+	ECVEBMLAppendUnsigned(videoEntry, ECVMatroskaTrackUIDID, ECVMatroskaVideoTrack);
+	ECVEBMLAppendUnsigned(videoEntry, ECVMatroskaTrackTypeID, 1);
+	ECVEBMLAppendUnsigned(videoEntry, ECVMatroskaFlagLacingID, 0);
+	if(r.timescale) ECVEBMLAppendUnsigned(videoEntry, ECVMatroskaDefaultDurationID, (UInt64)r.value * 1000000000ULL / r.timescale);
+	NSMutableData *const video = [NSMutableData data];
+	ECVEBMLAppendUnsigned(video, ECVMatroskaPixelWidthID, s.width);
+	ECVEBMLAppendUnsigned(video, ECVMatroskaPixelHeightID, s.height);
+	if(lossless) {
+		ECVEBMLAppendString(videoEntry, ECVMatroskaCodecIDID, "V_MS/VFW/FOURCC");
+		UInt8 bitmapInfoHeader[40] = {};
+		OSWriteLittleInt32(bitmapInfoHeader, 0, sizeof(bitmapInfoHeader));
+		OSWriteLittleInt32(bitmapInfoHeader, 4, (UInt32)s.width);
+		OSWriteLittleInt32(bitmapInfoHeader, 8, (UInt32)s.height);
+		OSWriteLittleInt16(bitmapInfoHeader, 12, 1);
+		OSWriteLittleInt16(bitmapInfoHeader, 14, 16);
+		OSWriteBigInt32(bitmapInfoHeader, 16, ECVLosslessCodecType);
+		ECVEBMLAppendBinary(videoEntry, ECVMatroskaCodecPrivateID, bitmapInfoHeader, sizeof(bitmapInfoHeader));
+	} else {
+		ECVEBMLAppendString(videoEntry, ECVMatroskaCodecIDID, "V_UNCOMPRESSED");
+		UInt8 colourSpace[4];
+		OSWriteBigInt32(colourSpace, 0, k2vuyPixelFormat == [self pixelFormat] ? 'UYVY' : 'YVYU');
+		ECVEBMLAppendBinary(video, ECVMatroskaColourSpaceID, colourSpace, sizeof(colourSpace));
+	}
+	ECVEBMLAppendMaster(videoEntry, ECVMatroskaVideoID, video);
+	ECVEBMLAppendMaster(tracks, ECVMatroskaTrackEntryID, videoEntry);
+#if defined(ECV_ENABLE_AUDIO)
+	if([self hasAudio]) {
+		NSMutableData *const audioEntry = [NSMutableData data];
+		ECVEBMLAppendUnsigned(audioEntry, ECVMatroskaTrackNumberID, ECVMatroskaAudioTrack);
+		ECVEBMLAppendUnsigned(audioEntry, ECVMatroskaTrackUIDID, ECVMatroskaAudioTrack);
+		ECVEBMLAppendUnsigned(audioEntry, ECVMatroskaTrackTypeID, 2);
+		ECVEBMLAppendUnsigned(audioEntry, ECVMatroskaFlagLacingID, 0);
+		ECVEBMLAppendString(audioEntry, ECVMatroskaCodecIDID, "A_PCM/FLOAT/IEEE");
+		NSMutableData *const audio = [NSMutableData data];
+		ECVEBMLAppendFloat(audio, ECVMatroskaSamplingFrequencyID, ECVStandardAudioStreamBasicDescription.mSampleRate);
+		ECVEBMLAppendUnsigned(audio, ECVMatroskaChannelsID, ECVStandardAudioStreamBasicDescription.mChannelsPerFrame);
+		ECVEBMLAppendUnsigned(audio, ECVMatroskaBitDepthID, ECVStandardAudioStreamBasicDescription.mBitsPerChannel);
+		ECVEBMLAppendMaster(audioEntry, ECVMatroskaAudioID, audio);
+		ECVEBMLAppendMaster(tracks, ECVMatroskaTrackEntryID, audioEntry);
+	}
+#endif
+	ECVEBMLAppendMaster(data, ECVMatroskaTracksID, tracks);
+
+	off_t const start = [self fileLength];
+	_segmentOffset += start;
+	_durationOffset += start;
+	[self appendBytes:[data bytes] length:[data length]];
+}
+- (void)writeVideoFrame:(ECVPixelBuffer *const)frame
+{
+	ECVIntegerSize const s = [frame pixelSize];
+	size_t const rowLength = s.width * ECVPixelFormatBytesPerPixel([frame pixelFormat]);
+	size_t const bytesPerRow = [frame bytesPerRow];
+	UInt8 const *const bytes = [frame bytes];
+	_hasVideoFrame = YES;
+	[self _appendBlockHeaderWithTrack:ECVMatroskaVideoTrack timecode:[self _videoTimecodeForFrame:[self frameCount]] length:rowLength * s.height];
+	if(rowLength == bytesPerRow) {
+		struct iovec const vector = {(void *)bytes, rowLength * s.height};
+		return [self writeVectors:&vector count:1];
+	}
+	struct iovec *const vectors = malloc(sizeof(struct iovec) * s.height); // Rows straight from the storage slot; the disk writer's copy is the only one.
+	NSUInteger i = 0;
+	for(; i < s.height; i++) vectors[i] = (struct iovec){(void *)(bytes + bytesPerRow * i), rowLength};
+	[self writeVectors:vectors count:s.height];
+	free(vectors);
+}
+- (BOOL)repeatVideoFrame
+{
+	return _hasVideoFrame; // The frame index still advances, so the next block's timecode leaves room for this one.
+}
+- (void)writeTrailer
+{
+	if(_clusterOffset) [self _patchSizeAtOffset:_clusterOffset];
+	[self _patchSizeAtOffset:_segmentOffset];
+	CFSwappedFloat64 const duration = CFConvertDoubleHostToSwapped(MAX([self _videoTimecodeForFrame:[self frameCount]], _lastTimecode));
+	[self writeBytes:&duration length:sizeof(duration) atOffset:_durationOffset];
+}
+
+#pragma mark -ECVStreamWriter(ECVOptional)
+
+- (void)writeVideoData:(NSData *const)data
+{
+	_hasVideoFrame = YES;
+	[self _appendBlockHeaderWithTrack:ECVMatroskaVideoTrack timecode:[self _videoTimecodeForFrame:[self frameCount]] length:[data length]];
+	struct iovec const vector = {(void *)[data bytes], [data length]};
+	[self writeVectors:&vector count:1];
+}
+- (void)writeAudioBytes:(void const *const)bytes length:(size_t const)length frameCount:(NSUInteger const)count
+{
+#if defined(ECV_ENABLE_AUDIO)
+	UInt64 const timecode = [self audioFrameCount] * ECVMatroskaTimecodesPerSecond / (UInt64)ECVStandardAudioStreamBasicDescription.mSampleRate;
+	[self _appendBlockHeaderWithTrack:ECVMatroskaAudioTrack timecode:timecode length:length];
+	[self appendBytes:bytes length:length]; // Small, so it gets coalesced with the next frame.
+#endif
+}
+
+@end
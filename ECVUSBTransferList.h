@@ -26,6 +26,12 @@ typedef struct {
 	UInt8 *data;
 } ECVUSBTransfer;
 
+enum {
+	ECVUSBTransferLowLatencyProfile = 0,
+	ECVUSBTransferRobustProfile = 1,
+};
+typedef NSInteger ECVUSBTransferProfile;
+
 @interface ECVUSBTransferList : NSObject
 {
 	@private
@@ -43,5 +49,48 @@ typedef struct {
 
 - (ECVUSBTransfer *)transfers;
 - (ECVUSBTransfer *)transferAtIndex:(NSUInteger)i;
+- (void)invalidateTransfer:(ECVUSBTransfer *)transfer;
+
+@end
+
+@interface ECVUSBTransferDepthController : NSObject
+{
+	@private
+	NSUInteger _minimumDepth;
+	NSUInteger _maximumDepth;
+	NSUInteger _depth;
+	UInt64 _transferDuration;
+	NSUInteger _bytesPerTransfer;
+
+	UInt64 _previousCompletionTime;
+	UInt64 _jitter;
+	SInt64 _windowMinimumSlack;
+	UInt64 _windowDuration;
+	NSUInteger _windowUnderruns;
+
+	NSUInteger _underrunCount;
+	NSUInteger _increaseCount;
+	NSUInteger _decreaseCount;
+}
+
++ (NSUInteger)microframesPerTransferForProfile:(ECVUSBTransferProfile)profile;
++ (NSUInteger)maximumDepthForProfile:(ECVUSBTransferProfile)profile;
+
+// Durations are in nanoseconds.
+- (id)initWithProfile:(ECVUSBTransferProfile)profile transferDuration:(UInt64)transferDuration bytesPerTransfer:(NSUInteger)bytesPerTransfer;
+- (NSUInteger)minimumDepth;
+- (NSUInteger)maximumDepth;
+- (NSUInteger)depth;
+- (NSUInteger)updatedDepth; // Call once per pass over the transfer list, before resubmitting anything.
+
+- (void)noteCompletionTime:(UInt64)time;
+- (void)noteSubmissionSlack:(SInt64)slack;
+- (void)noteUnderrun;
+
+- (NSTimeInterval)latency;
+- (NSTimeInterval)jitter;
+- (NSUInteger)underrunCount;
+- (NSUInteger)bufferedBytes;
+- (NSUInteger)allocatedBytes;
 
 @end
@@ -24,6 +24,25 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 // Other Sources
 #import "ECVDebug.h"
 
+#define ECVUSBTransferAdjustmentInterval (250ULL * 1000 * 1000) // Nanoseconds.
+
+typedef struct {
+	NSUInteger microframesPerTransfer;
+	NSUInteger minimumDepth;
+	NSUInteger initialDepth;
+	NSUInteger maximumDepth;
+} ECVUSBTransferProfileInfo;
+
+static ECVUSBTransferProfileInfo ECVUSBTransferProfileGetInfo(ECVUSBTransferProfile const profile)
+{
+	switch(profile) {
+		case ECVUSBTransferLowLatencyProfile: return (ECVUSBTransferProfileInfo){8, 4, 8, 32};
+		case ECVUSBTransferRobustProfile: return (ECVUSBTransferProfileInfo){32, 16, 32, 64};
+	}
+	ECVCAssertNotReached(@"Invalid USB transfer profile %ld.", (long)profile);
+	return (ECVUSBTransferProfileInfo){32, 16, 32, 64};
+}
+
 @implementation ECVUSBTransferList
 
 #pragma mark -ECVUSBTransferList
@@ -52,6 +71,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 				IOUSBLowLatencyIsocFrame *const frame = transfer->frames + j;
 				frame->frStatus = kIOReturnInvalid; // Ignore them to start out.
 				frame->frReqCount = _frameRequestSize;
+				frame->frActCount = 0;
 			}
 		}
 
@@ -76,6 +96,14 @@ bail:
 	NSParameterAssert(i < _numberOfTransfers);
 	return _transfers + i;
 }
+- (void)invalidateTransfer:(ECVUSBTransfer *)transfer
+{
+	NSUInteger i;
+	for(i = 0; i < _microframesPerTransfer; ++i) {
+		transfer->frames[i].frStatus = kIOReturnInvalid;
+		transfer->frames[i].frActCount = 0;
+	}
+}
 
 #pragma mark -NSObject
 
@@ -94,3 +122,129 @@ bail:
 }
 
 @end
+
+@implementation ECVUSBTransferDepthController
+
+#pragma mark +ECVUSBTransferDepthController
+
++ (NSUInteger)microframesPerTransferForProfile:(ECVUSBTransferProfile)profile
+{
+	return ECVUSBTransferProfileGetInfo(profile).microframesPerTransfer;
+}
++ (NSUInteger)maximumDepthForProfile:(ECVUSBTransferProfile)profile
+{
+	return ECVUSBTransferProfileGetInfo(profile).maximumDepth;
+}
+
+#pragma mark -ECVUSBTransferDepthController
+
+- (id)initWithProfile:(ECVUSBTransferProfile)profile transferDuration:(UInt64)transferDuration bytesPerTransfer:(NSUInteger)bytesPerTransfer
+{
+	NSParameterAssert(transferDuration);
+	if((self = [super init])) {
+		ECVUSBTransferProfileInfo const info = ECVUSBTransferProfileGetInfo(profile);
+		_minimumDepth = info.minimumDepth;
+		_maximumDepth = info.maximumDepth;
+		_depth = info.initialDepth;
+		_transferDuration = transferDuration;
+		_bytesPerTransfer = bytesPerTransfer;
+		_windowMinimumSlack = INT64_MAX;
+	}
+	return self;
+}
+- (NSUInteger)minimumDepth { return _minimumDepth; }
+- (NSUInteger)maximumDepth { return _maximumDepth; }
+- (NSUInteger)depth
+{
+	@synchronized(self) {
+		return _depth;
+	}
+}
+- (NSUInteger)updatedDepth
+{
+	@synchronized(self) {
+		NSUInteger depth = _depth;
+		if(_windowUnderruns) {
+			depth = MIN(_depth + MAX(_depth / 2, 1), _maximumDepth);
+		} else if(_windowDuration >= ECVUSBTransferAdjustmentInterval) {
+			// We want at least one transfer of headroom beyond the jitter we've seen. Shrink slowly, grow quickly.
+			SInt64 const margin = (SInt64)(_transferDuration + _jitter * 4);
+			if(_windowMinimumSlack < margin) depth = MIN(_depth + 1, _maximumDepth);
+			else if(_windowMinimumSlack > margin + (SInt64)_transferDuration) depth = MAX(_depth - 1, _minimumDepth);
+		} else return _depth;
+		if(depth > _depth) ++_increaseCount;
+		if(depth < _depth) ++_decreaseCount;
+		_depth = depth;
+		_windowMinimumSlack = INT64_MAX;
+		_windowDuration = 0;
+		_windowUnderruns = 0;
+		return _depth;
+	}
+}
+
+#pragma mark -
+
+- (void)noteCompletionTime:(UInt64)time
+{
+	@synchronized(self) {
+		if(_previousCompletionTime && time > _previousCompletionTime) {
+			UInt64 const interval = time - _previousCompletionTime;
+			UInt64 const deviation = interval > _transferDuration ? interval - _transferDuration : _transferDuration - interval;
+			_jitter = (UInt64)((SInt64)_jitter + ((SInt64)deviation - (SInt64)_jitter) / 16); // Same estimator as RFC 3550.
+			_windowDuration += interval;
+		}
+		_previousCompletionTime = time;
+	}
+}
+- (void)noteSubmissionSlack:(SInt64)slack
+{
+	@synchronized(self) {
+		_windowMinimumSlack = MIN(_windowMinimumSlack, slack);
+	}
+}
+- (void)noteUnderrun
+{
+	@synchronized(self) {
+		++_underrunCount;
+		++_windowUnderruns;
+		_previousCompletionTime = 0;
+	}
+}
+
+#pragma mark -
+
+- (NSTimeInterval)latency
+{
+	return (NSTimeInterval)[self depth] * _transferDuration / 1e9;
+}
+- (NSTimeInterval)jitter
+{
+	@synchronized(self) {
+		return _jitter / 1e9;
+	}
+}
+- (NSUInteger)underrunCount
+{
+	@synchronized(self) {
+		return _underrunCount;
+	}
+}
+- (NSUInteger)bufferedBytes
+{
+	return [self depth] * _bytesPerTransfer;
+}
+- (NSUInteger)allocatedBytes
+{
+	return _maximumDepth * _bytesPerTransfer;
+}
+
+#pragma mark -NSObject
+
+- (NSString *)description
+{
+	@synchronized(self) {
+		return [NSString stringWithFormat:@"<%@ %p: depth %lu (%lu-%lu), latency %.1f ms, jitter %.2f ms, %lu underruns, %lu increases, %lu decreases, %lu of %lu bytes buffered>", [self class], self, (unsigned long)_depth, (unsigned long)_minimumDepth, (unsigned long)_maximumDepth, _depth * _transferDuration / 1e6, _jitter / 1e6, (unsigned long)_underrunCount, (unsigned long)_increaseCount, (unsigned long)_decreaseCount, (unsigned long)(_depth * _bytesPerTransfer), (unsigned long)(_maximumDepth * _bytesPerTransfer)];
+	}
+}
+
+@end
@@ -29,10 +29,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 {
 	@private
 	ECVVideoStorage *_videoStorage;
+	NSUInteger _concealedLines;
+	NSTimeInterval _presentationTime;
 }
 
 - (id)initWithVideoStorage:(ECVVideoStorage *)storage;
 @property(readonly) id videoStorage;
+@property(assign) NSUInteger concealedLines; // Lines filled in from an earlier field because their data was lost.
+@property(assign) NSTimeInterval presentationTime; // On the recovered capture clock, comparable with audio presentation times.
 
 @end
 
@@ -41,6 +41,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 	return self;
 }
 @synthesize videoStorage = _videoStorage;
+@synthesize concealedLines = _concealedLines;
+@synthesize presentationTime = _presentationTime;
 
 #pragma mark -ECVPixelBuffer(ECVAbstract)
 
@@ -28,6 +28,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 
 @protocol ECVVideoViewCell, ECVVideoViewDelegate;
 
+#define ECVVideoViewMailboxSize 16
+#define ECVVideoViewTextureCount 2
+
 @interface ECVVideoView : NSOpenGLView
 #if defined(MAC_OS_X_VERSION_10_6)
 <NSWindowDelegate>
@@ -46,9 +49,27 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 	BOOL _showDroppedFrames;
 	NSCell<ECVVideoViewCell> *_cell;
 
-	NSMutableData *_textureNames;
-	NSMutableArray *_frames;
+	GLuint _textureNames[ECVVideoViewTextureCount];
+	GLuint _pixelBufferNames[ECVVideoViewTextureCount];
+	NSUInteger _textureIndex;
+	NSMutableArray *_frames; // Oldest first. Only touched by the display link.
+	ECVVideoFrame *_lastFrame; // The one in the current texture.
+	NSTimeInterval _lastFrameTime; // When it was uploaded.
 	CGFloat _frameDropStrength;
+
+	ECVVideoFrame *_mailbox[ECVVideoViewMailboxSize];
+	NSTimeInterval _mailboxArrivalTimes[ECVVideoViewMailboxSize];
+	volatile int32_t _mailboxHead; // Only advanced by -pushFrame:.
+	volatile int32_t _mailboxTail; // Only advanced by the display link.
+	volatile int32_t _mailboxOverflowCount;
+	int32_t _reportedOverflowCount;
+
+	NSTimeInterval _targetLatency;
+	NSTimeInterval _arrivalDelay; // Only touched by the display link.
+	NSTimeInterval _arrivalJitter;
+	NSTimeInterval _displayLatency;
+	NSTimeInterval _renderTime;
+	NSTimeInterval _framePinTime;
 }
 
 // These methods must be called from the main thread.
@@ -65,7 +86,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 @property(assign) GLint magFilter;
 @property(assign) BOOL showDroppedFrames;
 @property(nonatomic, retain) NSCell<ECVVideoViewCell> *cell;
-- (void)pushFrame:(ECVVideoFrame *)frame;
+@property(assign) NSTimeInterval targetLatency; // The jitter buffer holds frames at least this long, and longer if they arrive unevenly.
+@property(readonly) NSTimeInterval bufferLatency; // What the jitter buffer is actually holding frames for.
+@property(readonly) NSTimeInterval displayLatency; // Estimated time from capture to glass.
+@property(readonly) NSTimeInterval renderTime; // CPU time the display link spends per refresh.
+@property(readonly) NSTimeInterval framePinTime; // How long each frame stays locked while it's copied for upload.
+- (void)pushFrame:(ECVVideoFrame *)frame; // Lock-free. Only call from one thread at a time.
 
 @end
 
@@ -23,6 +23,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #import <OpenGL/gl.h>
 #import <OpenGL/glext.h>
 #import <OpenGL/glu.h>
+#import <libkern/OSAtomic.h>
 
 // Models
 #import "ECVVideoFormat.h"
@@ -32,15 +33,24 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 // Other Sources
 #import "ECVAppKitAdditions.h"
 #import "ECVDebug.h"
+#import "ECVFoundationAdditions.h"
 #import "ECVOpenGLAdditions.h"
 #import "ECVPixelFormat.h"
 
+#define ECVVideoViewMaximumLatency 0.25 // Seconds.
+#define ECVVideoViewMaximumBufferedFrames 16 // More than ECVVideoViewMaximumLatency holds at any capture rate.
+#define ECVVideoViewStallFrameCount 2.5 // Frame durations without a new frame before we show a drop.
+
 @interface ECVVideoView(Private)
 
-- (GLuint)_textureNameAtIndex:(NSUInteger)index;
+- (void)_receiveFrames;
+- (NSTimeInterval)_bufferLatency;
+- (ECVVideoFrame *)_lockedFrameForDeadline:(NSTimeInterval)deadline;
+
+- (void)_uploadFrame:(ECVVideoFrame *)frame;
 
-- (void)_drawOneFrame;
-- (void)_drawFrame:(ECVVideoFrame *)frame;
+- (void)_drawOneFrameAtTime:(NSTimeInterval)outputTime;
+- (void)_drawCurrentTexture;
 - (void)_drawFrameDropIndicatorWithStrength:(CGFloat)strength;
 - (void)_drawCropAdjustmentBox;
 - (void)_drawResizeHandle;
@@ -50,7 +60,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 static CVReturn ECVDisplayLinkOutputCallback(CVDisplayLinkRef displayLink, const CVTimeStamp *inNow, const CVTimeStamp *inOutputTime, CVOptionFlags flagsIn, CVOptionFlags *flagsOut, ECVVideoView *view)
 {
 	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
-	[view _drawOneFrame];
+	NSTimeInterval const outputTime = inOutputTime->flags & kCVTimeStampHostTimeValid ? (NSTimeInterval)inOutputTime->hostTime / CVGetHostClockFrequency() : [NSDate ECV_timeIntervalSinceReferenceDate];
+	[view _drawOneFrameAtTime:outputTime];
 	[pool drain];
 	return kCVReturnSuccess;
 }
@@ -83,28 +94,31 @@ static CVReturn ECVDisplayLinkOutputCallback(CVDisplayLinkRef displayLink, const
 	CGLContextObj const contextObj = ECVLockContext([self openGLContext]);
 	ECVGLError(glEnable(GL_TEXTURE_RECTANGLE_EXT));
 
-	if(_textureNames) ECVGLError(glDeleteTextures((GLint)[_videoStorage numberOfBuffers], [_textureNames bytes]));
-	[_textureNames release];
+	if(_textureNames[0]) {
+		ECVGLError(glDeleteTextures(ECVVideoViewTextureCount, _textureNames));
+		ECVGLError(glDeleteBuffers(ECVVideoViewTextureCount, _pixelBufferNames));
+	}
 	[_frames release];
+	[_lastFrame release];
+	_lastFrame = nil;
 
 	[_videoStorage release];
 	_videoStorage = [storage retain];
 
-	ECVGLError(glTextureRangeAPPLE(GL_TEXTURE_RECTANGLE_EXT, (GLint)[_videoStorage bufferSize] * (GLint)[_videoStorage numberOfBuffers], [_videoStorage allBufferBytes]));
-	_textureNames = [[NSMutableData alloc] initWithLength:[_videoStorage numberOfBuffers] * sizeof(GLuint)];
-	ECVGLError(glGenTextures((GLint)[_videoStorage numberOfBuffers], [_textureNames mutableBytes]));
+	// We copy each frame into a pixel buffer object instead of texturing straight from the storage, so frames can be unlocked as soon as the copy is queued.
+	ECVGLError(glGenTextures(ECVVideoViewTextureCount, _textureNames));
+	ECVGLError(glGenBuffers(ECVVideoViewTextureCount, _pixelBufferNames));
+	_textureIndex = 0;
 	_frames = [[NSMutableArray alloc] init];
 
 	ECVIntegerSize const s = [[_videoStorage videoFormat] frameSize];
 	GLenum const format = ECVPixelFormatToGLFormat([_videoStorage pixelFormat]);
 	GLenum const type = ECVPixelFormatToGLType([_videoStorage pixelFormat]);
 	NSUInteger i = 0;
-	for(; i < [_videoStorage numberOfBuffers]; i++) {
-		ECVGLError(glBindTexture(GL_TEXTURE_RECTANGLE_EXT, [self _textureNameAtIndex:i]));
-		ECVGLError(glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_STORAGE_HINT_APPLE, GL_STORAGE_CACHED_APPLE));
-		ECVGLError(glPixelStorei(GL_UNPACK_CLIENT_STORAGE_APPLE, GL_TRUE));
+	for(; i < ECVVideoViewTextureCount; i++) {
+		ECVGLError(glBindTexture(GL_TEXTURE_RECTANGLE_EXT, _textureNames[i]));
 		ECVGLError(glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_MAG_FILTER, [self magFilter]));
-		ECVGLError(glTexImage2D(GL_TEXTURE_RECTANGLE_EXT, 0, GL_RGB, (GLint)s.width, (GLint)s.height, 0, format, type, [_videoStorage bytesAtIndex:i]));
+		ECVGLError(glTexImage2D(GL_TEXTURE_RECTANGLE_EXT, 0, GL_RGB, (GLint)s.width, (GLint)s.height, 0, format, type, NULL));
 	}
 
 	ECVGLError(glDisable(GL_TEXTURE_RECTANGLE_EXT));
@@ -166,8 +180,8 @@ static CVReturn ECVDisplayLinkOutputCallback(CVDisplayLinkRef displayLink, const
 	CGLContextObj const contextObj = ECVLockContext([self openGLContext]);
 	_magFilter = filter;
 	NSUInteger i = 0;
-	if(_textureNames) for(; i < [_videoStorage numberOfBuffers]; i++) {
-		ECVGLError(glBindTexture(GL_TEXTURE_RECTANGLE_EXT, [self _textureNameAtIndex:i]));
+	if(_textureNames[0]) for(; i < ECVVideoViewTextureCount; i++) {
+		ECVGLError(glBindTexture(GL_TEXTURE_RECTANGLE_EXT, _textureNames[i]));
 		ECVGLError(glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_MAG_FILTER, _magFilter));
 	}
 	ECVUnlockContext(contextObj);
@@ -186,61 +200,191 @@ static CVReturn ECVDisplayLinkOutputCallback(CVDisplayLinkRef displayLink, const
 	[self setNeedsDisplay:YES];
 	[[self window] invalidateCursorRectsForView:self];
 }
-- (void)pushFrame:(ECVVideoFrame *)frame
+- (NSTimeInterval)targetLatency
+{
+	CGLContextObj const contextObj = ECVLockContext([self openGLContext]);
+	NSTimeInterval const r = _targetLatency;
+	ECVUnlockContext(contextObj);
+	return r;
+}
+- (void)setTargetLatency:(NSTimeInterval)latency
 {
-	if(!frame) return;
 	CGLContextObj const contextObj = ECVLockContext([self openGLContext]);
-	if([_videoStorage dropFramesFromArray:_frames]) _frameDropStrength = 1.0f;
-	[_frames insertObject:frame atIndex:0];
+	_targetLatency = latency;
 	ECVUnlockContext(contextObj);
 }
+- (NSTimeInterval)bufferLatency
+{
+	CGLContextObj const contextObj = ECVLockContext([self openGLContext]);
+	NSTimeInterval const r = [self _bufferLatency];
+	ECVUnlockContext(contextObj);
+	return r;
+}
+- (NSTimeInterval)displayLatency
+{
+	CGLContextObj const contextObj = ECVLockContext([self openGLContext]);
+	NSTimeInterval const r = _displayLatency;
+	ECVUnlockContext(contextObj);
+	return r;
+}
+- (NSTimeInterval)renderTime
+{
+	CGLContextObj const contextObj = ECVLockContext([self openGLContext]);
+	NSTimeInterval const r = _renderTime;
+	ECVUnlockContext(contextObj);
+	return r;
+}
+- (NSTimeInterval)framePinTime
+{
+	CGLContextObj const contextObj = ECVLockContext([self openGLContext]);
+	NSTimeInterval const r = _framePinTime;
+	ECVUnlockContext(contextObj);
+	return r;
+}
+- (void)pushFrame:(ECVVideoFrame *)frame
+{
+	if(!frame) return;
+	NSTimeInterval const arrivalTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+	OSMemoryBarrier(); // Don't reuse a slot until the display link is done with it.
+	if((uint32_t)_mailboxHead - (uint32_t)_mailboxTail >= ECVVideoViewMailboxSize) {
+		OSAtomicIncrement32Barrier(&_mailboxOverflowCount);
+		return;
+	}
+	NSUInteger const i = (uint32_t)_mailboxHead % ECVVideoViewMailboxSize;
+	_mailbox[i] = [frame retain];
+	_mailboxArrivalTimes[i] = arrivalTime; // The display link updates the arrival statistics, since it holds the context lock.
+	OSAtomicIncrement32Barrier(&_mailboxHead);
+}
 
 #pragma mark -ECVVideoView(Private)
 
-- (GLuint)_textureNameAtIndex:(NSUInteger)i
+- (void)_receiveFrames
+{
+	while(_mailboxTail != _mailboxHead) {
+		OSMemoryBarrier(); // Make sure we see the frame that was stored before the head moved.
+		NSUInteger const i = (uint32_t)_mailboxTail % ECVVideoViewMailboxSize;
+		ECVVideoFrame *const frame = _mailbox[i];
+		_mailbox[i] = nil;
+		NSTimeInterval const presentationTime = [frame presentationTime];
+		if(presentationTime) {
+			NSTimeInterval const delay = _mailboxArrivalTimes[i] - presentationTime;
+			_arrivalDelay += (delay - _arrivalDelay) / 16.0;
+			_arrivalJitter += (fabs(delay - _arrivalDelay) - _arrivalJitter) / 16.0;
+		}
+		if([frame videoStorage] == _videoStorage) [_frames addObject:frame];
+		[frame release];
+		OSAtomicIncrement32Barrier(&_mailboxTail);
+	}
+	NSUInteger const count = [_frames count];
+	if(count > ECVVideoViewMaximumBufferedFrames) { // We aren't keeping up, or there's no clock to pace us.
+		NSUInteger const drop = [_videoStorage numberOfFramesToDropWithCount:count - ECVVideoViewMaximumBufferedFrames]; // Whole frame groups, oldest first.
+		[_frames removeObjectsInRange:NSMakeRange(0, drop)];
+		if(drop) _frameDropStrength = 1.0f;
+	}
+	int32_t const overflowCount = _mailboxOverflowCount;
+	if(overflowCount != _reportedOverflowCount) _frameDropStrength = 1.0f;
+	_reportedOverflowCount = overflowCount;
+}
+- (NSTimeInterval)_bufferLatency
+{
+	return MIN(MAX(_targetLatency, _arrivalDelay + 3.0 * _arrivalJitter), ECVVideoViewMaximumLatency);
+}
+- (ECVVideoFrame *)_lockedFrameForDeadline:(NSTimeInterval)deadline
+{
+	NSUInteger const count = [_frames count];
+	if(!count) return nil;
+	NSUInteger best = 0;
+	if([[_frames objectAtIndex:0] presentationTime]) {
+		// Frames are in presentation order, so the distance to the deadline shrinks and then grows.
+		NSTimeInterval bestDistance = _lastFrame && [_lastFrame presentationTime] ? fabs([_lastFrame presentationTime] - deadline) : DBL_MAX;
+		best = NSNotFound;
+		NSUInteger i = 0;
+		for(; i < count; i++) {
+			NSTimeInterval const distance = fabs([[_frames objectAtIndex:i] presentationTime] - deadline);
+			if(distance >= bestDistance) break;
+			best = i;
+			bestDistance = distance;
+		}
+		if(NSNotFound == best) return nil; // The frame on screen is still the best match.
+	} // Otherwise there's no clock, so show each frame in turn.
+	ECVVideoFrame *const frame = [[[_frames objectAtIndex:best] retain] autorelease];
+	[_frames removeObjectsInRange:NSMakeRange(0, best + 1)];
+	if(best) _frameDropStrength = 1.0f;
+	if(![frame lockIfHasBytes]) {
+		_frameDropStrength = 1.0f;
+		return nil;
+	}
+	return frame;
+}
+
+- (void)_uploadFrame:(ECVVideoFrame *)frame
 {
-	if(NSNotFound == i) return 0;
-	return ((GLuint *)[_textureNames mutableBytes])[i];
+	if(frame != _lastFrame) {
+		[_lastFrame release];
+		_lastFrame = [frame retain];
+	}
+	NSUInteger const i = (_textureIndex + 1) % ECVVideoViewTextureCount; // The last refresh drew the current texture, and the GPU may still be reading it.
+	ECVIntegerSize const s = [[_videoStorage videoFormat] frameSize];
+	OSType const f = [_videoStorage pixelFormat];
+	size_t const size = [_videoStorage bufferSize];
+
+	ECVGLError(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBufferNames[i]));
+	ECVGLError(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW)); // Orphan the old contents rather than waiting for them.
+	void *const bytes = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+	if(bytes) {
+		memcpy(bytes, [frame bytes], size);
+		ECVGLError(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+	} else {
+		ECVGLError(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0)); // Upload synchronously instead.
+	}
+	ECVGLError(glBindTexture(GL_TEXTURE_RECTANGLE_EXT, _textureNames[i]));
+	ECVGLError(glTexSubImage2D(GL_TEXTURE_RECTANGLE_EXT, 0, 0, 0, (GLint)s.width, (GLint)s.height, ECVPixelFormatToGLFormat(f), ECVPixelFormatToGLType(f), bytes ? NULL : [frame bytes]));
+	ECVGLError(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+	_textureIndex = i;
 }
 
 #pragma mark -
 
-- (void)_drawOneFrame
+- (void)_drawOneFrameAtTime:(NSTimeInterval)outputTime
 {
 	CGLContextObj const contextObj = ECVLockContext([self openGLContext]);
+	NSTimeInterval const startTime = [NSDate ECV_timeIntervalSinceReferenceDate];
 	glClear(GL_COLOR_BUFFER_BIT);
 
-	ECVVideoFrame *frame = nil;
-	while([_frames count]) {
-		frame = [[[_frames lastObject] retain] autorelease];
-		[_frames removeLastObject];
-		if([frame lockIfHasBytes]) break;
-		frame = nil;
-	}
-	if(!frame) {
+	[self _receiveFrames];
+	ECVVideoFrame *frame = [self _lockedFrameForDeadline:outputTime - [self _bufferLatency]];
+	if(frame) {
+		if([frame presentationTime]) _displayLatency += (outputTime - [frame presentationTime] - _displayLatency) / 16.0;
+	} else if(!_lastFrame) {
 		frame = [_videoStorage currentFrame];
 		if(![frame lockIfHasBytes]) frame = nil;
 	}
+	if(frame) {
+		_lastFrameTime = outputTime;
+		NSTimeInterval const lockTime = [NSDate ECV_timeIntervalSinceReferenceDate];
+		[self _uploadFrame:frame];
+		[frame unlock];
+		_framePinTime += ([NSDate ECV_timeIntervalSinceReferenceDate] - lockTime - _framePinTime) / 16.0;
+	}
 
-	[self _drawFrame:frame];
-	if(frame) _frameDropStrength *= 0.75f;
-	else _frameDropStrength = 1.0f;
+	[self _drawCurrentTexture];
+	NSTimeInterval const frameDuration = CMTimeGetSeconds([[_videoStorage videoFormat] frameRate]);
+	if(!_lastFrame || outputTime - _lastFrameTime > frameDuration * ECVVideoViewStallFrameCount) _frameDropStrength = 1.0f; // Refreshes without a new frame are normal when the display is faster than the source, but not this many.
+	else _frameDropStrength *= 0.75f;
 	[self _drawFrameDropIndicatorWithStrength:_frameDropStrength];
 	[[self cell] drawWithFrame:_outputRect inVideoView:self playing:YES];
 	[self _drawResizeHandle];
-	glFinish();
-	[frame unlock];
+	glFlush(); // Don't wait for the GPU. Nothing it reads from belongs to the storage anymore.
 
+	_renderTime += ([NSDate ECV_timeIntervalSinceReferenceDate] - startTime - _renderTime) / 16.0;
 	ECVUnlockContext(contextObj);
 }
-- (void)_drawFrame:(ECVVideoFrame *)frame
+- (void)_drawCurrentTexture
 {
-	if(!frame) return;
+	if(!_lastFrame) return;
 	ECVGLError(glEnable(GL_TEXTURE_RECTANGLE_EXT));
 	ECVIntegerSize const s = [[_videoStorage videoFormat] frameSize];
-	OSType const f = [_videoStorage pixelFormat];
-	ECVGLError(glBindTexture(GL_TEXTURE_RECTANGLE_EXT, [self _textureNameAtIndex:[frame bufferIndex]]));
-	ECVGLError(glTexSubImage2D(GL_TEXTURE_RECTANGLE_EXT, 0, 0, 0, (GLint)s.width, (GLint)s.height, ECVPixelFormatToGLFormat(f), ECVPixelFormatToGLType(f), [frame bytes]));
+	ECVGLError(glBindTexture(GL_TEXTURE_RECTANGLE_EXT, _textureNames[_textureIndex]));
 	glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
 	ECVGLDrawTextureInRectWithBounds(_outputRect, ECVScaledRect(_cropRect, ECVIntegerSizeToNSSize(s)));
 	ECVGLError(glDisable(GL_TEXTURE_RECTANGLE_EXT));
@@ -344,13 +488,15 @@ static CVReturn ECVDisplayLinkOutputCallback(CVDisplayLinkRef displayLink, const
 	CGLContextObj const contextObj = ECVLockContext([self openGLContext]);
 
 	glClear(GL_COLOR_BUFFER_BIT);
-	ECVVideoFrame *frame = [_videoStorage currentFrame];
-	if(![frame lockIfHasBytes]) frame = nil;
-	[self _drawFrame:frame];
+	ECVVideoFrame *const frame = [_videoStorage currentFrame];
+	if([frame lockIfHasBytes]) {
+		[self _uploadFrame:frame];
+		[frame unlock];
+	}
+	[self _drawCurrentTexture];
 	[[self cell] drawWithFrame:_outputRect inVideoView:self playing:CVDisplayLinkIsRunning(_displayLink)];
 	[self _drawResizeHandle];
-	glFinish();
-	[frame unlock];
+	glFlush();
 
 	ECVUnlockContext(contextObj);
 }
@@ -415,12 +561,15 @@ static CVReturn ECVDisplayLinkOutputCallback(CVDisplayLinkRef displayLink, const
 	[[NSNotificationCenter defaultCenter] removeObserver:self];
 	if(_displayLink && CVDisplayLinkIsRunning(_displayLink)) ECVCVReturn(CVDisplayLinkStop(_displayLink));
 
-	ECVGLError(glTextureRangeAPPLE(GL_TEXTURE_RECTANGLE_EXT, 0, NULL));
-	ECVGLError(glDeleteTextures((GLint)[[self videoStorage] numberOfBuffers], [_textureNames bytes]));
+	if(_textureNames[0]) {
+		ECVGLError(glDeleteTextures(ECVVideoViewTextureCount, _textureNames));
+		ECVGLError(glDeleteBuffers(ECVVideoViewTextureCount, _pixelBufferNames));
+	}
 
 	[_videoStorage release];
-	[_textureNames release];
 	[_frames release];
+	[_lastFrame release];
+	while(_mailboxTail != _mailboxHead) [_mailbox[(uint32_t)_mailboxTail++ % ECVVideoViewMailboxSize] release];
 	CVDisplayLinkRelease(_displayLink);
 	[_cell release];
 	[super dealloc];
@@ -19,12 +19,14 @@ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
 ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+#import "ECVControlQueue.h"
+
 @class ECVCaptureDevice;
 @class ECVVideoFormat;
 
 @protocol SAA711XDevice;
 
-@interface SAA711XChip : NSObject
+@interface SAA711XChip : NSObject <ECVControlQueueDelegate>
 {
 	@private
 	IBOutlet ECVCaptureDevice<SAA711XDevice> *device;
@@ -33,6 +35,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 	CGFloat _contrast;
 	CGFloat _saturation;
 	CGFloat _hue;
+	ECVControlQueue *_controlQueue;
+	NSLock *_registerLock;
+	int16_t _shadowRegisters[0x100];
+	BOOL _shadowValid[0x100];
 }
 
 - (ECVCaptureDevice<SAA711XDevice> *)device;
@@ -50,7 +56,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 - (CGFloat)hue;
 - (void)setHue:(CGFloat const)val;
 
-- (BOOL)initialize;
+- (BOOL)initialize; // Writes every register, regardless of what we think the chip already has.
 - (NSUInteger)versionNumber;
 - (NSSet *)supportedVideoFormats;
 - (ECVVideoFormat *)defaultVideoFormat;
@@ -62,4 +68,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 - (BOOL)writeSAA711XRegister:(u_int8_t const)reg value:(int16_t const)val;
 - (BOOL)readSAA711XRegister:(u_int8_t const)reg value:(out u_int8_t *const)outVal;
 
+@optional
+- (BOOL)writeSAA711XRegister:(u_int8_t const)reg values:(u_int8_t const *const)vals count:(NSUInteger const)count; // Consecutive registers in one transaction.
+
 @end
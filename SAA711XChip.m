@@ -123,8 +123,17 @@ enum {
 - (u_int8_t)_SAA711XLuminanceControl;
 - (u_int8_t)_SAAA711XRTP0OutputPolarity;
 
+- (void)_invalidateShadowRegisters;
+- (BOOL)_writeRegister:(u_int8_t const)reg value:(int16_t const)val;
+- (BOOL)_writeRegister:(u_int8_t const)reg values:(u_int8_t const *const)vals count:(NSUInteger const)count;
+
 @end
 
+#define SAA711XBrightnessValue(val) ((int16_t)round((val) * 0xff))
+#define SAA711XContrastValue(val) ((int16_t)round((val) * 0x7f))
+#define SAA711XSaturationValue(val) ((int16_t)round((val) * 0x7f))
+#define SAA711XHueValue(val) ((int16_t)round(((val) - 0.5f) * 0xff))
+
 @implementation SAA711XChip
 
 #pragma mark -SAA711XChip
@@ -135,7 +144,13 @@ enum {
 }
 - (void)setDevice:(ECVCaptureDevice<SAA711XDevice> *const)obj
 {
+	[_controlQueue invalidate];
+	[_controlQueue release];
+	_controlQueue = nil;
 	device = obj;
+	[self _invalidateShadowRegisters];
+	if(!device) return;
+	_controlQueue = [[ECVControlQueue alloc] initWithDelegate:self];
 	NSUserDefaults *const d = [NSUserDefaults standardUserDefaults];
 	[d registerDefaults:[NSDictionary dictionaryWithObjectsAndKeys:
 		[NSNumber numberWithDouble:0.5], ECVBrightnessKey,
@@ -169,7 +184,7 @@ enum {
 - (void)setBrightness:(CGFloat const)val
 {
 	_brightness = val;
-	(void)[device writeSAA711XRegister:0x0a value:round(val * 0xff)];
+	[_controlQueue setValue:SAA711XBrightnessValue(val) forControl:0x0a];
 	[[NSUserDefaults standardUserDefaults] setObject:[NSNumber numberWithDouble:val] forKey:ECVBrightnessKey];
 }
 - (CGFloat)contrast
@@ -179,7 +194,7 @@ enum {
 - (void)setContrast:(CGFloat const)val
 {
 	_contrast = val;
-	(void)[device writeSAA711XRegister:0x0b value:round(val * 0x7f)];
+	[_controlQueue setValue:SAA711XContrastValue(val) forControl:0x0b];
 	[[NSUserDefaults standardUserDefaults] setObject:[NSNumber numberWithDouble:val] forKey:ECVContrastKey];
 }
 - (CGFloat)saturation
@@ -189,7 +204,7 @@ enum {
 - (void)setSaturation:(CGFloat const)val
 {
 	_saturation = val;
-	(void)[device writeSAA711XRegister:0x0c value:round(val * 0x7f)];
+	[_controlQueue setValue:SAA711XSaturationValue(val) forControl:0x0c];
 	[[NSUserDefaults standardUserDefaults] setObject:[NSNumber numberWithDouble:val] forKey:ECVSaturationKey];
 }
 - (CGFloat)hue
@@ -199,7 +214,7 @@ enum {
 - (void)setHue:(CGFloat const)val
 {
 	_hue = val;
-	(void)[device writeSAA711XRegister:0x0d value:round((val - 0.5f) * 0xff)];
+	[_controlQueue setValue:SAA711XHueValue(val) forControl:0x0d];
 	[[NSUserDefaults standardUserDefaults] setObject:[NSNumber numberWithDouble:val] forKey:ECVHueKey];
 }
 
@@ -241,13 +256,16 @@ enum {
 		{0x83, 0x31},
 		{0x88, SAA711XSLM1ScalerDisabled | SAA711XSLM3AudioClockGenerationDisabled | [self _SAA711XCHXENOutputControl]},
 	};
+	[self _invalidateShadowRegisters];
 	NSUInteger i;
-	for(i = 0; i < numberof(settings); i++) if(![device writeSAA711XRegister:settings[i].reg value:settings[i].val]) return NO;
-	for(i = 0x41; i <= 0x57; i++) if(![device writeSAA711XRegister:i value:0xff]) return NO;
-	[self setBrightness:_brightness];
-	[self setContrast:_contrast];
-	[self setSaturation:_saturation];
-	[self setHue:_hue];
+	for(i = 0; i < numberof(settings); i++) if(![self _writeRegister:settings[i].reg value:settings[i].val]) return NO;
+	u_int8_t lineControl[0x57 - 0x41 + 1];
+	memset(lineControl, 0xff, sizeof(lineControl));
+	if(![self _writeRegister:0x41 values:lineControl count:numberof(lineControl)]) return NO;
+	(void)[self _writeRegister:0x0a value:SAA711XBrightnessValue(_brightness)];
+	(void)[self _writeRegister:0x0b value:SAA711XContrastValue(_contrast)];
+	(void)[self _writeRegister:0x0c value:SAA711XSaturationValue(_saturation)];
+	(void)[self _writeRegister:0x0d value:SAA711XHueValue(_hue)];
 	return YES;
 }
 - (NSUInteger)versionNumber
@@ -314,6 +332,56 @@ enum {
 	return [self polarityInverted] ? SAA711XRTP0OutputPolarityInverted : 0;
 }
 
+#pragma mark -
+
+- (void)_invalidateShadowRegisters
+{
+	[_registerLock lock];
+	memset(_shadowValid, NO, sizeof(_shadowValid));
+	[_registerLock unlock];
+}
+- (BOOL)_writeRegister:(u_int8_t const)reg value:(int16_t const)val
+{
+	BOOL success = YES;
+	[_registerLock lock]; // Also keeps the read thread and the control queue from interleaving transactions.
+	if(!_shadowValid[reg] || _shadowRegisters[reg] != val) {
+		success = [device writeSAA711XRegister:reg value:val];
+		_shadowRegisters[reg] = val;
+		_shadowValid[reg] = success;
+	}
+	[_registerLock unlock];
+	return success;
+}
+- (BOOL)_writeRegister:(u_int8_t const)reg values:(u_int8_t const *const)vals count:(NSUInteger const)count
+{
+	NSParameterAssert(reg + count <= numberof(_shadowRegisters));
+	if(![device respondsToSelector:@selector(writeSAA711XRegister:values:count:)]) {
+		NSUInteger i;
+		for(i = 0; i < count; i++) if(![self _writeRegister:reg + i value:vals[i]]) return NO;
+		return YES;
+	}
+	BOOL success = YES;
+	[_registerLock lock];
+	NSUInteger i;
+	for(i = 0; i < count; i++) if(!_shadowValid[reg + i] || _shadowRegisters[reg + i] != vals[i]) break;
+	if(i < count) {
+		success = [device writeSAA711XRegister:reg values:vals count:count];
+		for(i = 0; i < count; i++) {
+			_shadowRegisters[reg + i] = vals[i];
+			_shadowValid[reg + i] = success;
+		}
+	}
+	[_registerLock unlock];
+	return success;
+}
+
+#pragma mark -<ECVControlQueueDelegate>
+
+- (BOOL)controlQueue:(ECVControlQueue *const)queue writeValue:(NSInteger const)value forControl:(NSUInteger const)control
+{
+	return [self _writeRegister:control value:value];
+}
+
 #pragma mark -NSObject
 
 - (id)init
@@ -324,9 +392,17 @@ enum {
 		_contrast = 0.5;
 		_saturation = 0.5;
 		_hue = 0.5;
+		_registerLock = [[NSLock alloc] init];
 	}
 	return self;
 }
+- (void)dealloc
+{
+	[_controlQueue invalidate];
+	[_controlQueue release];
+	[_registerLock release];
+	[super dealloc];
+}
 
 @end
 
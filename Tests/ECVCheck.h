@@ -0,0 +1,42 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Shared by the standalone checks in this directory. Each check is a small program that asserts the behavior of pure routines from the app and prints "ok" when everything holds. Build and run one from the repository root, for example:
+// clang -x objective-c -include EasyCapViewer_Prefix.pch -I. -framework Cocoa -framework CoreVideo -framework OpenGL -framework QuartzCore Tests/ECVLosslessCodecCheck.m ECVLosslessCodec.m ECVPixelBuffer.m -o /tmp/ECVLosslessCodecCheck && /tmp/ECVLosslessCodecCheck
+// Each check lists the sources it needs at the top. Don't define NDEBUG.
+#import <assert.h>
+#import <stdlib.h>
+
+// Other Sources
+#import "ECVDebug.h"
+
+void ECVLog(ECVErrorLevel level, NSString *format, ...) // Stands in for ECVDebug.m, which needs the whole app.
+{
+	va_list arguments;
+	va_start(arguments, format);
+	NSLogv(format, arguments);
+	va_end(arguments);
+}
+
+NS_INLINE UInt8 ECVCheckRandomByte(void)
+{
+	return (UInt8)(random() & 0xff);
+}
@@ -0,0 +1,140 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sources: ECVClockRecovery.m
+#import "ECVCheck.h"
+
+// Other Sources
+#import "ECVClockRecovery.h"
+
+#define ECVCheckFieldDuration (1001.0 / 60000.0)
+#define ECVCheckSampleRate 48000.0
+#define ECVCheckBufferFrameCount 512
+#define ECVCheckVideoTolerance 0.0015 // Seconds.
+#define ECVCheckAudioTolerance 0.00075
+
+static NSTimeInterval ECVCheckJitter(NSTimeInterval const amplitude)
+{
+	return ((random() % 20001) / 10000.0 - 1.0) * amplitude; // Uniform in ±amplitude.
+}
+
+typedef struct {
+	NSUInteger lockIndex; // Every later output is within the tolerance.
+	NSTimeInterval maxResidual; // These three are over the second half, once any startup error is long gone.
+	NSTimeInterval residualDeviation;
+	double meanRateError; // Single estimates wander with the jitter.
+} ECVCheckResult;
+
+static void ECVCheckAccumulate(ECVCheckResult *const result, NSUInteger const i, NSUInteger const count, NSTimeInterval const residual, NSTimeInterval const tolerance, double const rateError, double *const sums)
+{
+	if(fabs(residual) > tolerance) result->lockIndex = i + 1;
+	if(i < count / 2) return;
+	result->maxResidual = MAX(result->maxResidual, fabs(residual));
+	sums[0] += residual;
+	sums[1] += residual * residual;
+	sums[2] += rateError;
+	sums[3]++;
+}
+static void ECVCheckFinish(ECVCheckResult *const result, double const *const sums)
+{
+	double const mean = sums[0] / sums[3];
+	result->residualDeviation = sqrt(MAX(sums[1] / sums[3] - mean * mean, 0.0));
+	result->meanRateError = sums[2] / sums[3];
+}
+static ECVCheckResult ECVCheckVideo(double const ppm, NSTimeInterval const jitter, BOOL const lossy)
+{
+	ECVClockRecovery *const clock = [[[ECVClockRecovery alloc] init] autorelease];
+	[clock resetWithFieldDuration:ECVCheckFieldDuration sampleRate:0.0];
+	NSTimeInterval const period = ECVCheckFieldDuration / (1.0 + ppm / 1e6);
+	NSUInteger const count = 36000; // Ten minutes.
+	ECVCheckResult result = {};
+	double sums[4] = {};
+	NSUInteger i = 0;
+	for(; i < count; i++) {
+		NSTimeInterval const time = 1000.0 + i * period;
+		if(lossy && 250 == i % 500) continue; // A whole field went missing.
+		NSTimeInterval const arrival = time + ECVCheckJitter(jitter) + (lossy && !(i % 97) ? 0.004 : 0.0) + (!i ? 0.006 : 0.0); // The occasional late transfer, and a slow first one to lock from.
+		NSTimeInterval const presentationTime = [clock presentationTimeForFieldAtTime:arrival];
+		ECVCheckAccumulate(&result, i, count, presentationTime - time, ECVCheckVideoTolerance, [clock videoRateError], sums);
+	}
+	ECVCheckFinish(&result, sums);
+	return result;
+}
+static ECVCheckResult ECVCheckAudio(double const ppm, NSTimeInterval const jitter, NSTimeInterval const jump)
+{
+	ECVClockRecovery *const clock = [[[ECVClockRecovery alloc] init] autorelease];
+	[clock resetWithFieldDuration:0.0 sampleRate:ECVCheckSampleRate];
+	double const rate = ECVCheckSampleRate * (1.0 + ppm / 1e6);
+	NSUInteger const count = 20000;
+	ECVCheckResult result = {};
+	double sums[4] = {};
+	NSUInteger i = 0;
+	for(; i < count; i++) {
+		Float64 const sampleTime = i * ECVCheckBufferFrameCount;
+		NSTimeInterval const time = 500.0 + sampleTime / rate + (i >= count / 4 ? jump : 0.0); // The device was unplugged, say.
+		NSTimeInterval const presentationTime = [clock presentationTimeForAudioSampleTime:sampleTime atTime:time + ECVCheckJitter(jitter) + (!i ? 0.003 : 0.0)];
+		ECVCheckAccumulate(&result, i, count, presentationTime - time, ECVCheckAudioTolerance, [clock audioRateError], sums);
+	}
+	ECVCheckFinish(&result, sums);
+	return result;
+}
+
+int main(int argc, char const *argv[])
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	srandom(1);
+
+	// A clean clock is followed exactly, however far it is off.
+	ECVCheckResult const clean = ECVCheckVideo(200.0, 0.0, NO);
+	assert(clean.lockIndex < 60);
+	assert(clean.maxResidual < 1e-6);
+	assert(fabs(clean.meanRateError - 200.0) < 1.0);
+
+	// USB delivery jitter of ±2 ms: lock within two seconds, then stay close with a fraction of the input jitter.
+	double const drifts[] = {200.0, -300.0, 1000.0};
+	NSUInteger i;
+	for(i = 0; i < sizeof(drifts) / sizeof(*drifts); i++) {
+		ECVCheckResult const jittered = ECVCheckVideo(drifts[i], 0.002, NO);
+		assert(jittered.lockIndex < 120);
+		assert(jittered.maxResidual < ECVCheckVideoTolerance);
+		assert(jittered.residualDeviation < 0.002 / sqrt(3.0) / 3.0); // The input's deviation is amplitude / sqrt(3).
+		assert(fabs(jittered.meanRateError - drifts[i]) < 10.0);
+	}
+
+	// Lost fields and late transfers don't knock it off.
+	ECVCheckResult const lossy = ECVCheckVideo(200.0, 0.002, YES);
+	assert(lossy.lockIndex < 120);
+	assert(lossy.maxResidual < ECVCheckVideoTolerance);
+	assert(fabs(lossy.meanRateError - 200.0) < 10.0);
+
+	// Audio buffers, with and without a discontinuity that forces a resync.
+	ECVCheckResult const audio = ECVCheckAudio(-150.0, 0.001, 0.0);
+	assert(audio.lockIndex < 100);
+	assert(audio.maxResidual < ECVCheckAudioTolerance);
+	assert(fabs(audio.meanRateError + 150.0) < 5.0);
+	ECVCheckResult const jumped = ECVCheckAudio(-150.0, 0.001, 0.5);
+	assert(jumped.lockIndex < 20000 / 4 + 100);
+	assert(jumped.maxResidual < ECVCheckAudioTolerance);
+
+	printf("ok\n");
+	[pool drain];
+	return EXIT_SUCCESS;
+}
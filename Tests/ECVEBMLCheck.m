@@ -0,0 +1,117 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sources: ECVEBML.m
+#import "ECVCheck.h"
+
+// Other Sources
+#import "ECVEBML.h"
+
+static NSUInteger ECVCheckDecodeSize(UInt8 const *const bytes, UInt64 *const outSize)
+{
+	NSUInteger length = 1;
+	while(length <= 8 && !(bytes[0] & (0x80 >> (length - 1)))) length++;
+	assert(length <= 8);
+	UInt64 size = bytes[0] & (0xFF >> length);
+	for(NSUInteger i = 1; i < length; i++) size = size << 8 | bytes[i];
+	*outSize = size;
+	return length;
+}
+static NSUInteger ECVCheckMinimumSizeLength(UInt64 const size)
+{
+	for(NSUInteger length = 1; length < 8; length++) if(size < (1ULL << (7 * length)) - 1) return length;
+	return 8;
+}
+static void ECVCheckSize(UInt64 const size)
+{
+	NSMutableData *const data = [NSMutableData data];
+	ECVEBMLAppendSize(data, size);
+	UInt64 decoded = 0;
+	NSUInteger const length = ECVCheckDecodeSize([data bytes], &decoded);
+	assert([data length] == length);
+	assert(ECVCheckMinimumSizeLength(size) == length);
+	assert(decoded == size);
+	assert(decoded != (1ULL << (7 * length)) - 1 || 8 == length); // Never mistaken for an unknown size.
+}
+static void ECVCheckBytes(NSData *const data, UInt8 const *const bytes, NSUInteger const length)
+{
+	assert([data length] == length);
+	assert(!memcmp([data bytes], bytes, length));
+}
+
+int main(int argc, char const *argv[])
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+
+	NSMutableData *data = [NSMutableData data];
+	ECVEBMLAppendSize(data, 0);
+	ECVEBMLAppendSize(data, 126);
+	ECVEBMLAppendSize(data, 127);
+	ECVEBMLAppendSize(data, 16382);
+	ECVEBMLAppendSize(data, 16383);
+	UInt8 const sizes[] = {0x80, 0xFE, 0x40, 0x7F, 0x7F, 0xFE, 0x20, 0x3F, 0xFF};
+	ECVCheckBytes(data, sizes, sizeof(sizes));
+
+	for(NSUInteger length = 1; length <= 8; length++) {
+		UInt64 const max = (1ULL << (7 * length)) - 1;
+		ECVCheckSize(max - 2);
+		ECVCheckSize(max - 1);
+		if(length < 8) ECVCheckSize(max);
+		if(length < 8) ECVCheckSize(max + 1);
+	}
+	for(NSUInteger i = 0; i < 100000; i++) {
+		UInt64 size = 0;
+		for(NSUInteger j = 0; j < 7; j++) size = size << 8 | ECVCheckRandomByte();
+		ECVCheckSize(size >> (ECVCheckRandomByte() % 56));
+	}
+
+	UInt8 size8[8];
+	ECVEBMLEncodeSize8(5, size8);
+	UInt8 const patched[] = {0x01, 0, 0, 0, 0, 0, 0, 0x05};
+	assert(!memcmp(size8, patched, sizeof(patched)));
+	ECVEBMLEncodeSize8(ECVEBMLUnknownSize, size8);
+	UInt8 const unknown[] = {0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+	assert(!memcmp(size8, unknown, sizeof(unknown)));
+
+	data = [NSMutableData data];
+	ECVEBMLAppendID(data, 0xA3);
+	ECVEBMLAppendID(data, 0x4286);
+	ECVEBMLAppendID(data, 0x2AD7B1);
+	ECVEBMLAppendID(data, 0x1A45DFA3);
+	UInt8 const IDs[] = {0xA3, 0x42, 0x86, 0x2A, 0xD7, 0xB1, 0x1A, 0x45, 0xDF, 0xA3};
+	ECVCheckBytes(data, IDs, sizeof(IDs));
+
+	data = [NSMutableData data];
+	ECVEBMLAppendUnsigned(data, 0xE7, 0);
+	ECVEBMLAppendUnsigned(data, 0xE7, 1000);
+	ECVEBMLAppendString(data, 0x4282, "matroska");
+	UInt8 const elements[] = {0xE7, 0x81, 0x00, 0xE7, 0x82, 0x03, 0xE8, 0x42, 0x82, 0x88, 'm', 'a', 't', 'r', 'o', 's', 'k', 'a'};
+	ECVCheckBytes(data, elements, sizeof(elements));
+
+	data = [NSMutableData data];
+	ECVEBMLAppendUnknownSizeMaster(data, 0x18538067);
+	UInt8 const master[] = {0x18, 0x53, 0x80, 0x67, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+	ECVCheckBytes(data, master, sizeof(master));
+
+	printf("ok\n");
+	[pool drain];
+	return EXIT_SUCCESS;
+}
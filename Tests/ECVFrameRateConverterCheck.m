@@ -0,0 +1,128 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sources: ECVFrameRateConverter.m ECVRational.m
+#import "ECVCheck.h"
+
+// Other Sources
+#import "ECVFrameRateConverter.h"
+
+#define ECVCheckFrameCount 1000000 // About 4.6 hours of fields.
+
+typedef struct {
+	int64_t sourceValue; // Frame durations, as the converter takes them.
+	int32_t sourceScale;
+	int64_t targetValue;
+	int32_t targetScale;
+} ECVCheckRates;
+
+static ECVFrameRateConverter *ECVCheckConverter(ECVCheckRates const rates)
+{
+	return [[[ECVFrameRateConverter alloc] initWithSourceFrameRate:CMTimeMake(rates.sourceValue, rates.sourceScale) targetFrameRate:CMTimeMake(rates.targetValue, rates.targetScale)] autorelease];
+}
+static void ECVCheckNominal(ECVCheckRates const rates)
+{
+	// After n source frames, exactly floor(n * ratio) target frames, with no rounding error building up.
+	ECVFrameRateConverter *const converter = ECVCheckConverter(rates);
+	int64_t const numer = rates.sourceValue * rates.targetScale;
+	int64_t const denom = rates.targetValue * rates.sourceScale;
+	uint64_t total = 0;
+	NSUInteger i;
+	for(i = 1; i <= ECVCheckFrameCount; i++) {
+		NSUInteger const count = [converter nextFrameRepeatCount];
+		assert(count == numer / denom || count == (numer + denom - 1) / denom);
+		total += count;
+		assert(total == (uint64_t)(i * numer / denom));
+	}
+}
+static void ECVCheckTimed(ECVCheckRates const rates, double const ppm, NSTimeInterval const jitter, BOOL const untimedRepeats, NSUInteger *const outCounts)
+{
+	// However the source clock runs, the target frame count stays within the hysteresis of the nominal pattern's bounds for the elapsed time.
+	ECVFrameRateConverter *const converter = ECVCheckConverter(rates);
+	NSTimeInterval const sourceDuration = (NSTimeInterval)rates.sourceValue / rates.sourceScale * (1.0 + ppm / 1e6);
+	NSTimeInterval const targetDuration = (NSTimeInterval)rates.targetValue / rates.targetScale;
+	NSTimeInterval const startTime = 1000.0;
+	uint64_t total = 0;
+	NSUInteger i;
+	for(i = 0; i < ECVCheckFrameCount; i++) {
+		NSTimeInterval const time = startTime + i * sourceDuration;
+		NSTimeInterval const offset = ((random() % 20001) / 10000.0 - 1.0) * jitter;
+		BOOL const untimed = untimedRepeats && i % 3 == 2 && !jitter; // Repeats follow the previous frame at the nominal rate, so only leave times out when that's where they'd be.
+		NSUInteger const count = [converter nextFrameRepeatCountForTime:untimed ? 0.0 : time + offset];
+		assert(count <= 3);
+		outCounts[count]++;
+		total += count;
+		double const due = (time - startTime + sourceDuration) / targetDuration;
+		double const slack = ECVFrameRateConverterHysteresis + 2.0 * jitter / targetDuration + 1e-6; // The first frame's jitter moves the origin.
+		assert((double)total - due <= slack && due - (double)total <= 1.0 + slack);
+	}
+}
+
+int main(int argc, char const *argv[])
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	srandom(1);
+
+	ECVCheckRates const fieldsToFrames = {1001, 60000, 1001, 30000};
+	ECVCheckRates const NTSCToPAL = {1001, 30000, 1, 25};
+	ECVCheckRates const PALToNTSC = {1, 25, 1001, 30000};
+	ECVCheckRates const same = {1001, 30000, 1001, 30000};
+	ECVCheckNominal(fieldsToFrames);
+	ECVCheckNominal(NTSCToPAL);
+	ECVCheckNominal(PALToNTSC);
+	ECVCheckNominal(same);
+
+	NSUInteger counts[4] = {};
+	ECVCheckTimed(fieldsToFrames, 0.0, 0.0, NO, counts);
+	assert(counts[0] + counts[1] == ECVCheckFrameCount);
+	assert(labs((long)counts[1] - ECVCheckFrameCount / 2) <= 1);
+	ECVCheckTimed(PALToNTSC, 0.0, 0.0, NO, (NSUInteger[4]){});
+
+	// A nominal clock with exact times gives one frame each; untimed repeats don't change that.
+	memset(counts, 0, sizeof(counts));
+	ECVCheckTimed(same, 0.0, 0.0, YES, counts);
+	assert(counts[1] == ECVCheckFrameCount);
+
+	// A device running 500 ppm slow gets one repeat per 2000 frames, and jitter under the hysteresis never adds a repeat that a drop then undoes.
+	memset(counts, 0, sizeof(counts));
+	ECVCheckTimed(same, 500.0, 0.002, NO, counts);
+	assert(!counts[0] && !counts[3]);
+	assert(labs((long)counts[2] - ECVCheckFrameCount / 2000) <= 1);
+	memset(counts, 0, sizeof(counts));
+	ECVCheckTimed(same, -500.0, 0.002, NO, counts);
+	assert(!counts[2] && !counts[3]);
+	assert(labs((long)counts[0] - ECVCheckFrameCount / 2000) <= 1);
+
+	// A long gap restarts the timeline instead of being filled with a minute of repeats. Frames missing without an untimed repeat in their place are made up once they're further behind than the hysteresis.
+	ECVFrameRateConverter *const converter = ECVCheckConverter(same);
+	NSTimeInterval const duration = 1001.0 / 30000.0;
+	assert(1 == [converter nextFrameRepeatCountForTime:10.0]);
+	assert(1 == [converter nextFrameRepeatCountForTime:10.0 + duration]);
+	assert(1 == [converter nextFrameRepeatCountForTime:70.0]);
+	assert(1 == [converter nextFrameRepeatCountForTime:70.0 + duration]);
+	assert(1 == [converter nextFrameRepeatCountForTime:0.0]);
+	assert(1 == [converter nextFrameRepeatCountForTime:70.0 + duration * 4.0]);
+	assert(2 == [converter nextFrameRepeatCountForTime:70.0 + duration * 6.0]);
+
+	printf("ok\n");
+	[pool drain];
+	return EXIT_SUCCESS;
+}
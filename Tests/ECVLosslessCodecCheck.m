@@ -0,0 +1,149 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sources: ECVLosslessCodec.m ECVPixelBuffer.m
+// Also a benchmark: prints the compression ratio and encode and decode rates for each pattern.
+#import "ECVCheck.h"
+
+// Models
+#import "ECVPixelBuffer.h"
+
+// Other Sources
+#import "ECVLosslessCodec.h"
+
+enum {
+	ECVPatternNoise,
+	ECVPatternGradient,
+	ECVPatternFlat,
+	ECVPatternExtremes,
+	ECVPatternCount,
+};
+typedef NSUInteger ECVPattern;
+
+static ECVDataPixelBuffer *ECVPatternPixelBuffer(ECVIntegerSize const size, OSType const pixelFormat, ECVPattern const pattern)
+{
+	size_t const bytesPerRow = size.width * 2 + 16; // Padding must survive untouched.
+	NSMutableData *const data = [NSMutableData dataWithLength:bytesPerRow * size.height];
+	UInt8 *const bytes = [data mutableBytes];
+	NSUInteger x, y;
+	for(y = 0; y < size.height; y++) for(x = 0; x < size.width * 2; x++) {
+		UInt8 *const byte = bytes + bytesPerRow * y + x;
+		switch(pattern) {
+			case ECVPatternNoise: *byte = ECVCheckRandomByte(); break;
+			case ECVPatternGradient: *byte = (UInt8)(x + y * 3 + (ECVCheckRandomByte() & 0x3)); break;
+			case ECVPatternFlat: *byte = x % 2 ? 0x10 : 0x80; break;
+			case ECVPatternExtremes: *byte = (x / 2 + y) % 2 ? 0xff : 0x00; break;
+		}
+	}
+	return [[[ECVDataPixelBuffer alloc] initWithPixelSize:size bytesPerRow:bytesPerRow pixelFormat:pixelFormat data:data offset:0] autorelease];
+}
+static NSData *ECVCheckRoundTrip(ECVIntegerSize const size, OSType const pixelFormat, ECVPattern const pattern)
+{
+	ECVDataPixelBuffer *const original = ECVPatternPixelBuffer(size, pixelFormat, pattern);
+	[original lock];
+	NSData *const encoded = ECVLosslessEncodePixelBuffer(original);
+	[original unlock];
+	assert(encoded);
+	assert(ECVEqualPixelSizes(ECVLosslessPixelSize(encoded), size));
+
+	ECVDataPixelBuffer *const decoded = ECVPatternPixelBuffer(size, pixelFormat, ECVPatternNoise);
+	[decoded lock];
+	assert(ECVLosslessDecodeToPixelBuffer(encoded, decoded));
+	[decoded unlock];
+	NSUInteger y;
+	for(y = 0; y < size.height; y++) assert(!memcmp((UInt8 const *)[original bytes] + [original bytesPerRow] * y, (UInt8 const *)[decoded bytes] + [decoded bytesPerRow] * y, size.width * 2));
+	return encoded;
+}
+
+static void ECVCheckBenchmark(ECVPattern const pattern, char const *const name)
+{
+	ECVIntegerSize const size = {720, 480};
+	NSUInteger const frameCount = 100;
+	double const megabytes = size.width * size.height * 2 * frameCount / 1.0e6;
+	ECVDataPixelBuffer *const source = ECVPatternPixelBuffer(size, k2vuyPixelFormat, pattern);
+	ECVDataPixelBuffer *const destination = ECVPatternPixelBuffer(size, k2vuyPixelFormat, ECVPatternFlat);
+	NSData *encoded = nil;
+	NSUInteger i;
+	[source lock];
+	[destination lock];
+	NSTimeInterval const encodeStartTime = [NSDate timeIntervalSinceReferenceDate];
+	for(i = 0; i < frameCount; i++) {
+		NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+		[encoded release];
+		encoded = [ECVLosslessEncodePixelBuffer(source) retain];
+		[pool drain];
+	}
+	NSTimeInterval const encodeTime = [NSDate timeIntervalSinceReferenceDate] - encodeStartTime;
+	NSTimeInterval const decodeStartTime = [NSDate timeIntervalSinceReferenceDate];
+	for(i = 0; i < frameCount; i++) assert(ECVLosslessDecodeToPixelBuffer(encoded, destination));
+	NSTimeInterval const decodeTime = [NSDate timeIntervalSinceReferenceDate] - decodeStartTime;
+	[destination unlock];
+	[source unlock];
+	printf("%s: %.2f:1, encode %.0f MB/s, decode %.0f MB/s\n", name, size.width * size.height * 2 / (double)[encoded length], megabytes / encodeTime, megabytes / decodeTime);
+	[encoded release];
+}
+
+int main(int argc, char const *argv[])
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	srandom(1);
+
+	ECVIntegerSize const sizes[] = {{720, 480}, {704, 472}, {2, 1}, {34, 7}, {640, 3}, {6, ECVLosslessSliceCount + 1}};
+	OSType const pixelFormats[] = {k2vuyPixelFormat, kYVYU422PixelFormat};
+	NSUInteger i, j;
+	ECVPattern pattern;
+	for(i = 0; i < numberof(sizes); i++) for(j = 0; j < numberof(pixelFormats); j++) for(pattern = 0; pattern < ECVPatternCount; pattern++) (void)ECVCheckRoundTrip(sizes[i], pixelFormats[j], pattern);
+
+	// Prediction has to leave almost nothing to code in a flat frame, and noise must not blow up much past its raw size.
+	ECVIntegerSize const size = {720, 480};
+	size_t const rawLength = size.width * size.height * 2;
+	assert([ECVCheckRoundTrip(size, k2vuyPixelFormat, ECVPatternFlat) length] < rawLength / 20); // The per-stream frequency tables dominate here.
+	assert([ECVCheckRoundTrip(size, k2vuyPixelFormat, ECVPatternNoise) length] < rawLength + rawLength / 20);
+
+	ECVCheckBenchmark(ECVPatternGradient, "gradient");
+	ECVCheckBenchmark(ECVPatternNoise, "noise");
+	ECVCheckBenchmark(ECVPatternFlat, "flat");
+
+	// Unsupported input is refused rather than mangled.
+	ECVDataPixelBuffer *const oddWidth = ECVPatternPixelBuffer((ECVIntegerSize){33, 4}, k2vuyPixelFormat, ECVPatternNoise);
+	[oddWidth lock];
+	assert(!ECVLosslessEncodePixelBuffer(oddWidth));
+	[oddWidth unlock];
+
+	// Truncated or mismatched data fails to decode instead of reading past the end.
+	ECVDataPixelBuffer *const source = ECVPatternPixelBuffer(size, k2vuyPixelFormat, ECVPatternGradient);
+	[source lock];
+	NSData *const encoded = ECVLosslessEncodePixelBuffer(source);
+	[source unlock];
+	ECVDataPixelBuffer *const destination = ECVPatternPixelBuffer(size, k2vuyPixelFormat, ECVPatternFlat);
+	ECVDataPixelBuffer *const smaller = ECVPatternPixelBuffer((ECVIntegerSize){size.width / 2, size.height}, k2vuyPixelFormat, ECVPatternFlat);
+	[destination lock];
+	[smaller lock];
+	assert(!ECVLosslessDecodeToPixelBuffer([encoded subdataWithRange:NSMakeRange(0, [encoded length] / 2)], destination));
+	assert(!ECVLosslessDecodeToPixelBuffer([encoded subdataWithRange:NSMakeRange(0, 8)], destination));
+	assert(!ECVLosslessDecodeToPixelBuffer(encoded, smaller));
+	[smaller unlock];
+	[destination unlock];
+
+	printf("ok\n");
+	[pool drain];
+	return EXIT_SUCCESS;
+}
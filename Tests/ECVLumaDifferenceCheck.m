@@ -0,0 +1,129 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sources: ECVLumaDifference.m ECVPixelBuffer.m
+#import "ECVCheck.h"
+
+// Models
+#import "ECVPixelBuffer.h"
+
+// Other Sources
+#import "ECVLumaDifference.h"
+
+static void ECVCheckRandomPlane(UInt8 *const plane, ECVIntegerSize const size)
+{
+	NSUInteger i = 0;
+	for(; i < size.width * size.height; i++) plane[i] = ECVCheckRandomByte();
+}
+static void ECVCheckBlockSADs(ECVIntegerSize const size, NSUInteger const blockSize)
+{
+	UInt8 *const a = malloc(size.width * size.height);
+	UInt8 *const b = malloc(size.width * size.height);
+	ECVCheckRandomPlane(a, size);
+	ECVCheckRandomPlane(b, size);
+	NSUInteger const columns = size.width / blockSize, rows = size.height / blockSize;
+	UInt32 *const SADs = malloc(sizeof(UInt32) * MAX(columns * rows, 1));
+	ECVLumaBlockSADs(a, b, size, blockSize, SADs);
+	UInt32 maxSAD = 0;
+	NSUInteger row, column, x, y;
+	for(row = 0; row < rows; row++) for(column = 0; column < columns; column++) {
+		UInt32 expected = 0;
+		for(y = row * blockSize; y < (row + 1) * blockSize; y++) for(x = column * blockSize; x < (column + 1) * blockSize; x++) expected += (UInt32)abs((int)a[y * size.width + x] - (int)b[y * size.width + x]);
+		assert(SADs[row * columns + column] == expected);
+		maxSAD = MAX(maxSAD, expected);
+	}
+	CGFloat const difference = ECVLumaMaxBlockDifference(a, b, size, blockSize);
+	assert(columns && rows ? difference == (CGFloat)maxSAD / (blockSize * blockSize) : 0.0 == difference); // Partial blocks at the edges are left out.
+	assert(0.0 == ECVLumaMaxBlockDifference(a, a, size, blockSize));
+	free(SADs);
+	free(b);
+	free(a);
+}
+static ECVDataPixelBuffer *ECVCheckLumaPixelBuffer(ECVIntegerSize const size, OSType const pixelFormat, UInt8 (^const luma)(NSUInteger x, NSUInteger y))
+{
+	size_t const bytesPerRow = size.width * 2 + 8;
+	NSMutableData *const data = [NSMutableData dataWithLength:bytesPerRow * size.height];
+	UInt8 *const bytes = [data mutableBytes];
+	NSUInteger const lumaOffset = k2vuyPixelFormat == pixelFormat ? 1 : 0; // UYVY or YUYV.
+	NSUInteger x, y;
+	for(y = 0; y < size.height; y++) for(x = 0; x < size.width; x++) {
+		bytes[bytesPerRow * y + x * 2 + lumaOffset] = luma(x, y);
+		bytes[bytesPerRow * y + x * 2 + 1 - lumaOffset] = ECVCheckRandomByte(); // Chroma must not leak in.
+	}
+	return [[[ECVDataPixelBuffer alloc] initWithPixelSize:size bytesPerRow:bytesPerRow pixelFormat:pixelFormat data:data offset:0] autorelease];
+}
+static void ECVCheckDecimation(OSType const pixelFormat)
+{
+	ECVIntegerSize const size = {70, 45}; // Partial blocks at the edges are left out.
+	ECVIntegerSize const lumaSize = ECVDecimatedLumaSize(size);
+	assert(lumaSize.width == size.width / ECVLumaDecimation && lumaSize.height == size.height / ECVLumaDecimation);
+	UInt8 *const original = malloc(size.width * size.height);
+	ECVCheckRandomPlane(original, size);
+	ECVDataPixelBuffer *const buffer = ECVCheckLumaPixelBuffer(size, pixelFormat, ^(NSUInteger x, NSUInteger y) {
+		return original[y * size.width + x];
+	});
+	UInt8 *const luma = malloc(lumaSize.width * lumaSize.height);
+	[buffer lock];
+	assert(ECVDecimateLuma(buffer, luma));
+	[buffer unlock];
+	NSUInteger x, y, i, j;
+	for(y = 0; y < lumaSize.height; y++) for(x = 0; x < lumaSize.width; x++) {
+		NSUInteger sum = 0;
+		for(j = 0; j < ECVLumaDecimation; j++) for(i = 0; i < ECVLumaDecimation; i++) sum += original[(y * ECVLumaDecimation + j) * size.width + x * ECVLumaDecimation + i];
+		assert(luma[y * lumaSize.width + x] == (sum + 8) / 16);
+	}
+	free(luma);
+	free(original);
+}
+
+int main(int argc, char const *argv[])
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	srandom(1);
+
+	ECVIntegerSize const sizes[] = {{180, 120}, {37, 21}, {8, 8}, {7, 30}};
+	NSUInteger const blockSizes[] = {1, 4, 8};
+	NSUInteger i, j;
+	for(i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) for(j = 0; j < sizeof(blockSizes) / sizeof(*blockSizes); j++) ECVCheckBlockSADs(sizes[i], blockSizes[j]);
+
+	// One changed block shows up at full strength, however large the frame.
+	ECVIntegerSize const size = {180, 120};
+	UInt8 *const a = calloc(size.width * size.height, 1);
+	UInt8 *const b = calloc(size.width * size.height, 1);
+	NSUInteger x, y;
+	for(y = 16; y < 24; y++) for(x = 40; x < 48; x++) b[y * size.width + x] = 30;
+	assert(30.0 == ECVLumaMaxBlockDifference(a, b, size, 8));
+	assert(30.0 / 4.0 == ECVLumaMaxBlockDifference(a, b, size, 16)); // Straddles a quarter of a larger block.
+	free(b);
+	free(a);
+
+	ECVCheckDecimation(k2vuyPixelFormat);
+	ECVCheckDecimation(kYVYU422PixelFormat);
+	ECVDataPixelBuffer *const unsupported = [[[ECVDataPixelBuffer alloc] initWithPixelSize:(ECVIntegerSize){16, 16} bytesPerRow:64 pixelFormat:k32ARGBPixelFormat data:[NSMutableData dataWithLength:64 * 16] offset:0] autorelease];
+	UInt8 luma[16];
+	[unsupported lock];
+	assert(!ECVDecimateLuma(unsupported, luma));
+	[unsupported unlock];
+
+	printf("ok\n");
+	[pool drain];
+	return EXIT_SUCCESS;
+}
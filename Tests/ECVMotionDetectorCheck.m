@@ -0,0 +1,173 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sources: ECVMotionDetector.m ECVLumaDifference.m ECVVideoFrame.m ECVPixelBuffer.m ECVFoundationAdditions.m
+#import "ECVCheck.h"
+
+// Models
+#import "ECVVideoFrame.h"
+
+// Other Sources
+#import "ECVMotionDetector.h"
+
+#define ECVCheckFrameRate 30
+#define ECVCheckPostRoll 1.0
+#define ECVCheckMotionStart 60
+#define ECVCheckMotionEnd 90 // The block is gone from this frame on.
+#define ECVCheckFrameCount 180
+
+@interface ECVMotionDetector(ECVCheck)
+
+- (void)_analyzeFrame:(ECVVideoFrame *const)frame;
+
+@end
+
+// Stands in for a frame from the capture device's storage.
+@interface ECVCheckFrame : ECVVideoFrame
+{
+	@private
+	ECVIntegerSize _size;
+	NSData *_data;
+}
+
+- (id)initWithPixelSize:(ECVIntegerSize const)size data:(NSData *const)data;
+
+@end
+
+@interface ECVCheckDelegate : NSObject <ECVMotionDetectorDelegate>
+{
+	@public
+	NSInteger startFrame;
+	NSInteger stopFrame;
+	NSInteger currentFrame;
+}
+
+@end
+
+static NSData *ECVCheckFrameData(ECVIntegerSize const size, NSUInteger const index)
+{
+	// A still gradient with some analog noise. While moving, a bright square crosses it.
+	NSMutableData *const data = [NSMutableData dataWithLength:size.width * 2 * size.height];
+	UInt8 *const bytes = [data mutableBytes];
+	BOOL const moving = index >= ECVCheckMotionStart && index < ECVCheckMotionEnd;
+	NSUInteger const left = 100 + (index - ECVCheckMotionStart) * 8;
+	NSUInteger x, y;
+	for(y = 0; y < size.height; y++) for(x = 0; x < size.width; x++) {
+		UInt8 *const p = bytes + (y * size.width + x) * 2;
+		int luma = 40 + (int)(x + y) / 8 + (int)(ECVCheckRandomByte() % 7) - 3;
+		if(moving && x >= left && x < left + 96 && y >= 120 && y < 216) luma = 235;
+		p[0] = 0x80; // UYVY.
+		p[1] = (UInt8)luma;
+	}
+	return data;
+}
+
+int main(int argc, char const *argv[])
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	srandom(1);
+
+	ECVMotionDetector *const detector = [[[ECVMotionDetector alloc] initWithPostRoll:ECVCheckPostRoll sensitivity:4.0] autorelease];
+	ECVCheckDelegate *const delegate = [[[ECVCheckDelegate alloc] init] autorelease];
+	delegate->startFrame = -1;
+	delegate->stopFrame = -1;
+	[detector setDelegate:delegate];
+
+	ECVIntegerSize const size = {720, 480};
+	NSUInteger i = 0;
+	for(; i < ECVCheckFrameCount; i++) {
+		NSAutoreleasePool *const innerPool = [[NSAutoreleasePool alloc] init];
+		ECVCheckFrame *const frame = [[[ECVCheckFrame alloc] initWithPixelSize:size data:ECVCheckFrameData(size, i)] autorelease];
+		[frame setPresentationTime:1.0 + (NSTimeInterval)i / ECVCheckFrameRate];
+		delegate->currentFrame = (NSInteger)i;
+		[detector _analyzeFrame:frame];
+		[innerPool release];
+	}
+
+	// Noise alone never counts as motion. The first frame with the square starts it, and it stops once the post-roll has passed after the last frame that changed.
+	assert(ECVCheckMotionStart == delegate->startFrame);
+	assert(ECVCheckMotionEnd + ECVCheckPostRoll * ECVCheckFrameRate == delegate->stopFrame);
+	assert(![detector isDetectingMotion]);
+
+	[detector setDelegate:nil];
+	printf("ok\n");
+	[pool drain];
+	return EXIT_SUCCESS;
+}
+
+@implementation ECVCheckFrame
+
+- (id)initWithPixelSize:(ECVIntegerSize const)size data:(NSData *const)data
+{
+	if((self = [super initWithVideoStorage:nil])) {
+		_size = size;
+		_data = [data retain];
+	}
+	return self;
+}
+- (ECVIntegerSize)pixelSize
+{
+	return _size;
+}
+- (size_t)bytesPerRow
+{
+	return _size.width * 2;
+}
+- (OSType)pixelFormat
+{
+	return k2vuyPixelFormat;
+}
+- (void const *)bytes
+{
+	return [_data bytes];
+}
+- (BOOL)hasBytes
+{
+	return YES;
+}
+- (BOOL)lockIfHasBytes
+{
+	return YES;
+}
+- (void)lock {}
+- (void)unlock {}
+- (void)dealloc
+{
+	[_data release];
+	[super dealloc];
+}
+
+@end
+
+@implementation ECVCheckDelegate
+
+- (void)motionDetectorDidStartDetectingMotion:(ECVMotionDetector *const)sender
+{
+	assert(-1 == startFrame);
+	startFrame = currentFrame;
+}
+- (void)motionDetectorDidStopDetectingMotion:(ECVMotionDetector *const)sender
+{
+	assert(-1 == stopFrame);
+	stopFrame = currentFrame;
+}
+
+@end
@@ -0,0 +1,281 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sources: ECVMovieRecorder.m ECVAudioPipe.m ECVFrameRateConverter.m ECVRational.m ECVLosslessCodec.m ECVLumaDifference.m ECVVideoFrame.m ECVPixelBuffer.m ECVFoundationAdditions.m
+#import "ECVCheck.h"
+
+#if !__LP64__
+
+// Models
+#import "ECVVideoFrame.h"
+
+// Other Sources
+#import "ECVLosslessCodec.h"
+#import "ECVMovieRecorder.h"
+
+#define ECVCheckFrameCount 300
+#define ECVCheckResumeFrameCount 20 // Less than a segment, so resuming writes exactly one more file.
+#define ECVCheckSegmentDuration 1.0
+#define ECVCheckFrameDuration 1001
+#define ECVCheckTimeScale 30000
+
+NSString *ECVOSStatusToString(OSStatus error) // ECVDebug.m needs the whole app.
+{
+	return [NSString stringWithFormat:@"%ld", (long)error];
+}
+NSString *ECVCVReturnToString(CVReturn error)
+{
+	return [NSString stringWithFormat:@"%ld", (long)error];
+}
+
+// Stand in for the capture device's format and storage, which is all the recorder asks about.
+@interface ECVCheckFormat : NSObject
+
+- (ECVIntegerSize)frameSize;
+- (CMTime)frameRate;
+
+@end
+
+@interface ECVCheckStorage : NSObject
+{
+	@private
+	ECVCheckFormat *_videoFormat;
+}
+
+- (ECVCheckFormat *)videoFormat;
+- (OSType)pixelFormat;
+
+@end
+
+@interface ECVCheckFrame : ECVVideoFrame
+{
+	@private
+	ECVIntegerSize _size;
+	NSData *_data;
+}
+
+- (id)initWithPixelSize:(ECVIntegerSize const)size data:(NSData *const)data;
+
+@end
+
+static NSData *ECVCheckFrameData(ECVIntegerSize const size, NSUInteger const index)
+{
+	// A gradient that moves every frame, so no two are alike.
+	NSMutableData *const data = [NSMutableData dataWithLength:size.width * 2 * size.height];
+	UInt8 *const bytes = [data mutableBytes];
+	NSUInteger x, y;
+	for(y = 0; y < size.height; y++) for(x = 0; x < size.width; x++) {
+		UInt8 *const p = bytes + (y * size.width + x) * 2;
+		p[0] = 0x80; // UYVY.
+		p[1] = (UInt8)(16 + (x + y + index) % 220);
+	}
+	return data;
+}
+static void ECVCheckAddFrames(ECVMovieRecorder *const recorder, ECVIntegerSize const size, NSUInteger const count, NSTimeInterval const startTime)
+{
+	NSUInteger i = 0;
+	for(; i < count; i++) {
+		NSAutoreleasePool *const innerPool = [[NSAutoreleasePool alloc] init];
+		ECVCheckFrame *const frame = [[[ECVCheckFrame alloc] initWithPixelSize:size data:ECVCheckFrameData(size, i)] autorelease];
+		[frame setPresentationTime:startTime + (NSTimeInterval)i * ECVCheckFrameDuration / ECVCheckTimeScale];
+		BOOL const ready = [recorder waitUntilReadyForMoreVideoFramesBeforeDate:[NSDate distantFuture]];
+		assert(ready);
+		[recorder addVideoFrame:frame];
+		[innerPool release];
+	}
+}
+static BOOL ECVCheckReadSegment(NSString *const path, long *const outSampleCount, TimeValue64 *const outDuration)
+{
+	// Read the closed file back, the way a player would open it.
+	if(![[NSFileManager defaultManager] fileExistsAtPath:path]) return NO;
+	Handle dataRef = NULL;
+	OSType dataRefType = 0;
+	Movie movie = NULL;
+	OSStatus const referenceError = QTNewDataReferenceFromCFURL((CFURLRef)[NSURL fileURLWithPath:path], kNilOptions, &dataRef, &dataRefType);
+	assert(noErr == referenceError);
+	OSErr const movieError = NewMovieFromDataRef(&movie, newMovieDontAskUnresolvedDataRefs, NULL, dataRef, dataRefType);
+	assert(noErr == movieError);
+	DisposeHandle(dataRef);
+	Track const track = GetMovieIndTrackType(movie, 1, VideoMediaType, movieTrackMediaType);
+	assert(track);
+	Media const media = GetTrackMedia(track);
+	*outSampleCount = GetMediaSampleCount(media);
+	*outDuration = GetMediaDisplayDuration(media);
+	DisposeMovie(movie);
+	return YES;
+}
+
+int main(int argc, char const *argv[])
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	srandom(1);
+
+	NSString *const directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"ECVMovieRecorderSegmentCheck %d", getpid()]];
+	BOOL const created = [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:NULL];
+	assert(created);
+
+	ECVCheckStorage *const storage = [[[ECVCheckStorage alloc] init] autorelease];
+	ECVMovieRecordingOptions *const options = [[[ECVMovieRecordingOptions alloc] init] autorelease];
+	[options setURL:[NSURL fileURLWithPath:[directory stringByAppendingPathComponent:@"Check.mov"]]];
+	[options setVideoStorage:(ECVVideoStorage *)storage];
+	[options setVideoCodec:ECVLosslessCodecType];
+	[options setFrameRate:[[storage videoFormat] frameRate]];
+	[options setEncoderCount:2]; // Frames come back out of order, so switches happen with some still in flight.
+	[options setSegmentDuration:ECVCheckSegmentDuration];
+	ECVMovieRecorder *const recorder = [[ECVMovieRecorder alloc] initWithOptions:options error:NULL];
+	assert(recorder);
+
+	// Record, pause the way motion-triggered recording does, then pick up again on the same recorder.
+	ECVIntegerSize const size = [[storage videoFormat] frameSize];
+	ECVCheckAddFrames(recorder, size, ECVCheckFrameCount, 1.0);
+	[recorder closeSegment];
+	NSUInteger const segmentCount = [recorder segmentCount];
+	ECVCheckAddFrames(recorder, size, ECVCheckResumeFrameCount, 60.0);
+	[recorder stopRecording];
+	assert(segmentCount + 1 == [recorder segmentCount]);
+	assert(![recorder droppedFrameCount] && ![recorder repeatedFrameCount]);
+	[recorder release];
+
+	// The next file is opened in the background, so a switch can slip to a later key frame, but never loses or repeats a frame.
+	TimeValue64 const minimumDuration = (TimeValue64)round(ECVCheckSegmentDuration * ECVCheckTimeScale);
+	long totalSampleCount = 0;
+	TimeValue64 totalDuration = 0;
+	NSUInteger i;
+	assert(segmentCount > 1 && segmentCount <= ECVCheckFrameCount * ECVCheckFrameDuration / minimumDuration); // Every segment but the last holds at least a second.
+	for(i = 0; i < segmentCount; i++) {
+		long sampleCount = 0;
+		TimeValue64 duration = 0;
+		BOOL const exists = ECVCheckReadSegment([directory stringByAppendingPathComponent:[NSString stringWithFormat:@"Check %03lu.mov", (unsigned long)i + 1]], &sampleCount, &duration);
+		assert(exists);
+		assert(duration == sampleCount * ECVCheckFrameDuration);
+		if(i + 1 < segmentCount) assert(duration >= minimumDuration);
+		totalSampleCount += sampleCount;
+		totalDuration += duration;
+	}
+	assert(ECVCheckFrameCount == totalSampleCount);
+	assert(ECVCheckFrameCount * ECVCheckFrameDuration == totalDuration);
+
+	// Nothing from before the pause carries over, and the gap isn't filled with repeats.
+	long resumedSampleCount = 0;
+	TimeValue64 resumedDuration = 0;
+	BOOL const resumed = ECVCheckReadSegment([directory stringByAppendingPathComponent:[NSString stringWithFormat:@"Check %03lu.mov", (unsigned long)segmentCount + 1]], &resumedSampleCount, &resumedDuration);
+	assert(resumed);
+	assert(ECVCheckResumeFrameCount == resumedSampleCount);
+	assert(ECVCheckResumeFrameCount * ECVCheckFrameDuration == resumedDuration);
+	assert(![[NSFileManager defaultManager] fileExistsAtPath:[directory stringByAppendingPathComponent:[NSString stringWithFormat:@"Check %03lu.mov", (unsigned long)segmentCount + 2]]]); // The file opened ahead was removed.
+
+	[[NSFileManager defaultManager] removeItemAtPath:directory error:NULL];
+	printf("ok\n");
+	[pool drain];
+	return EXIT_SUCCESS;
+}
+
+@implementation ECVCheckFormat
+
+- (ECVIntegerSize)frameSize
+{
+	return (ECVIntegerSize){320, 240};
+}
+- (CMTime)frameRate
+{
+	return CMTimeMake(ECVCheckFrameDuration, ECVCheckTimeScale);
+}
+
+@end
+
+@implementation ECVCheckStorage
+
+- (id)init
+{
+	if((self = [super init])) {
+		_videoFormat = [[ECVCheckFormat alloc] init];
+	}
+	return self;
+}
+- (ECVCheckFormat *)videoFormat
+{
+	return _videoFormat;
+}
+- (OSType)pixelFormat
+{
+	return k2vuyPixelFormat;
+}
+- (void)dealloc
+{
+	[_videoFormat release];
+	[super dealloc];
+}
+
+@end
+
+@implementation ECVCheckFrame
+
+- (id)initWithPixelSize:(ECVIntegerSize const)size data:(NSData *const)data
+{
+	if((self = [super initWithVideoStorage:nil])) {
+		_size = size;
+		_data = [data retain];
+	}
+	return self;
+}
+- (ECVIntegerSize)pixelSize
+{
+	return _size;
+}
+- (size_t)bytesPerRow
+{
+	return _size.width * 2;
+}
+- (OSType)pixelFormat
+{
+	return k2vuyPixelFormat;
+}
+- (void const *)bytes
+{
+	return [_data bytes];
+}
+- (BOOL)hasBytes
+{
+	return YES;
+}
+- (BOOL)lockIfHasBytes
+{
+	return YES;
+}
+- (void)lock {}
+- (void)unlock {}
+- (void)dealloc
+{
+	[_data release];
+	[super dealloc];
+}
+
+@end
+
+#else
+
+int main(int argc, char const *argv[])
+{
+	printf("skipped: QuickTime recording needs a 32-bit build\n");
+	return EXIT_SUCCESS;
+}
+
+#endif
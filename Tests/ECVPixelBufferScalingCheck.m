@@ -0,0 +1,92 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sources: ECVPixelBuffer.m
+#import "ECVCheck.h"
+
+// Models
+#import "ECVPixelBuffer.h"
+
+static ECVDataPixelBuffer *ECVCheckPixelBuffer(ECVIntegerSize const size, BOOL const random)
+{
+	size_t const bytesPerRow = size.width * 2;
+	NSMutableData *const data = [NSMutableData dataWithLength:bytesPerRow * size.height];
+	UInt8 *const bytes = [data mutableBytes];
+	NSUInteger i = 0;
+	if(random) for(; i < [data length]; i++) bytes[i] = ECVCheckRandomByte();
+	return [[[ECVDataPixelBuffer alloc] initWithPixelSize:size bytesPerRow:bytesPerRow pixelFormat:k2vuyPixelFormat data:data offset:0] autorelease];
+}
+static UInt8 ECVCheckLuma(ECVPixelBuffer *const buffer, NSUInteger const x, NSUInteger const y)
+{
+	return ((UInt8 const *)[buffer bytes])[y * [buffer bytesPerRow] + x * 2 + 1]; // UYVY.
+}
+
+int main(int argc, char const *argv[])
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	srandom(1);
+
+	ECVIntegerSize const size = {96, 64};
+	ECVDataPixelBuffer *const src = ECVCheckPixelBuffer(size, YES);
+	NSData *const srcData = [src mutableData];
+	ECVPixelBufferScalingFilter const filters[] = {ECVScaleBilinear, ECVScaleArea};
+	NSUInteger i, x, y;
+
+	// Same size, no crop: a straight copy.
+	for(i = 0; i < sizeof(filters) / sizeof(*filters); i++) {
+		ECVDataPixelBuffer *const dst = ECVCheckPixelBuffer(size, NO);
+		[dst drawPixelBuffer:src fromRect:NSMakeRect(0.0, 0.0, size.width, size.height) filter:filters[i]];
+		assert([[dst mutableData] isEqualToData:srcData]);
+	}
+
+	// A crop that lines up with the pixel pairs copies the rows it covers.
+	ECVDataPixelBuffer *const crop = ECVCheckPixelBuffer((ECVIntegerSize){64, 40}, NO);
+	[crop drawPixelBuffer:src fromRect:NSMakeRect(8.0, 12.0, 64.0, 40.0) filter:ECVScaleArea];
+	for(y = 0; y < 40; y++) assert(!memcmp((UInt8 const *)[crop bytes] + y * [crop bytesPerRow], (UInt8 const *)[src bytes] + (y + 12) * [src bytesPerRow] + 8 * 2, 64 * 2));
+
+	// Halving with area averages each 2x2 block, give or take the rounding between the passes.
+	ECVDataPixelBuffer *const half = ECVCheckPixelBuffer((ECVIntegerSize){size.width / 2, size.height / 2}, NO);
+	[half drawPixelBuffer:src fromRect:NSMakeRect(0.0, 0.0, size.width, size.height) filter:ECVScaleArea];
+	for(y = 0; y < size.height / 2; y++) for(x = 0; x < size.width / 2; x++) {
+		NSUInteger const sum = ECVCheckLuma(src, x * 2, y * 2) + ECVCheckLuma(src, x * 2 + 1, y * 2) + ECVCheckLuma(src, x * 2, y * 2 + 1) + ECVCheckLuma(src, x * 2 + 1, y * 2 + 1);
+		assert(abs((int)ECVCheckLuma(half, x, y) - (int)((sum + 2) / 4)) <= 1);
+	}
+
+	// A scaler reused across frames matches drawing each one from scratch, including when the geometry changes and changes back.
+	NSRect const rects[] = {{{0.0, 0.0}, {96.0, 64.0}}, {{3.5, 2.0}, {88.0, 60.0}}, {{3.5, 2.0}, {88.0, 60.0}}, {{0.0, 0.0}, {96.0, 64.0}}};
+	ECVIntegerSize const dstSizes[] = {{60, 34}, {60, 34}, {130, 90}, {60, 34}};
+	for(i = 0; i < sizeof(filters) / sizeof(*filters); i++) {
+		ECVPixelBufferScaler *const scaler = [[[ECVPixelBufferScaler alloc] initWithFilter:filters[i]] autorelease];
+		assert([scaler filter] == filters[i]);
+		NSUInteger j = 0;
+		for(; j < sizeof(rects) / sizeof(*rects); j++) {
+			ECVDataPixelBuffer *const expected = ECVCheckPixelBuffer(dstSizes[j], NO);
+			ECVDataPixelBuffer *const actual = ECVCheckPixelBuffer(dstSizes[j], NO);
+			[expected drawPixelBuffer:src fromRect:rects[j] filter:filters[i]];
+			[actual drawPixelBuffer:src fromRect:rects[j] scaler:scaler];
+			assert([[actual mutableData] isEqualToData:[expected mutableData]]);
+		}
+	}
+
+	printf("ok\n");
+	[pool drain];
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sources: ECVPreviewRenderer.m ECVPixelBuffer.m ECVFoundationAdditions.m
+// Also a benchmark and a headless preview tool: times a 4-up mosaic of quarter-size tiles, and writes the mosaic as a PNG when given a path.
+#import "ECVCheck.h"
+
+// Models
+#import "ECVPixelBuffer.h"
+
+// Other Sources
+#import "ECVPreviewRenderer.h"
+
+#define ECVCheckSourceSize ((ECVIntegerSize){720, 480})
+#define ECVCheckTileSize ((ECVIntegerSize){360, 240})
+#define ECVCheckMosaicFrameCount 300
+#define ECVCheckGuardByte 0x55
+
+static ECVDataPixelBuffer *ECVCheckPixelBuffer(ECVIntegerSize const size, OSType const pixelFormat, UInt8 const uniform)
+{
+	size_t const bytesPerRow = size.width * 2 + 16; // Padding must be skipped.
+	NSMutableData *const data = [NSMutableData dataWithLength:bytesPerRow * size.height];
+	UInt8 *const bytes = [data mutableBytes];
+	NSUInteger i = 0;
+	for(; i < [data length]; i++) bytes[i] = uniform ?: ECVCheckRandomByte();
+	return [[[ECVDataPixelBuffer alloc] initWithPixelSize:size bytesPerRow:bytesPerRow pixelFormat:pixelFormat data:data offset:0] autorelease];
+}
+static ECVDataPixelBuffer *ECVCheckBarsPixelBuffer(ECVIntegerSize const size, NSUInteger const shift)
+{
+	// 75% color bars, so a written mosaic is easy to check by eye.
+	static UInt8 const bars[8][3] = {{180, 128, 128}, {162, 44, 142}, {131, 156, 44}, {112, 72, 58}, {84, 184, 198}, {65, 100, 212}, {35, 212, 114}, {16, 128, 128}}; // Y', Cb, Cr.
+	ECVDataPixelBuffer *const buffer = ECVCheckPixelBuffer(size, k2vuyPixelFormat, 0x10);
+	UInt8 *const bytes = [buffer mutableBytes];
+	NSUInteger x, y;
+	for(y = 0; y < size.height; y++) for(x = 0; x < size.width; x += 2) {
+		UInt8 const *const bar = bars[(x * 8 / size.width + shift) % 8];
+		UInt8 *const p = bytes + y * [buffer bytesPerRow] + x * 2;
+		p[0] = bar[1];
+		p[1] = bar[0];
+		p[2] = bar[2];
+		p[3] = bar[0];
+	}
+	return buffer;
+}
+static UInt8 ECVCheckClamp(double const x)
+{
+	return x < 0.0 ? 0 : (x > 255.0 ? 255 : (UInt8)round(x));
+}
+static void ECVCheckReferencePixel(ECVPixelBuffer *const buffer, NSUInteger const x0, NSUInteger const y0, NSUInteger const width, NSUInteger const height, UInt8 *const outBGRA)
+{
+	// Straightforward floating point Rec. 601 on the box's averaged components. Only valid for boxes of whole pixel pairs.
+	BOOL const yvyu = kYVYU422PixelFormat == [buffer pixelFormat];
+	UInt8 const *const bytes = [buffer bytes];
+	NSUInteger lumaSum = 0, blueSum = 0, redSum = 0;
+	NSUInteger x, y;
+	for(y = y0; y < y0 + height; y++) for(x = x0; x < x0 + width; x += 2) {
+		UInt8 const *const p = bytes + y * [buffer bytesPerRow] + x * 2;
+		lumaSum += yvyu ? p[0] + p[2] : p[1] + p[3];
+		blueSum += yvyu ? p[3] : p[0];
+		redSum += yvyu ? p[1] : p[2];
+	}
+	NSUInteger const pairs = width * height / 2;
+	double const luma = round((double)lumaSum / (pairs * 2)) - 16.0;
+	double const blue = round((double)blueSum / pairs) - 128.0;
+	double const red = round((double)redSum / pairs) - 128.0;
+	outBGRA[0] = ECVCheckClamp(1.164 * luma + 2.017 * blue);
+	outBGRA[1] = ECVCheckClamp(1.164 * luma - 0.392 * blue - 0.813 * red);
+	outBGRA[2] = ECVCheckClamp(1.164 * luma + 1.596 * red);
+	outBGRA[3] = 0xff;
+}
+static void ECVCheckDownscale(OSType const pixelFormat)
+{
+	// Exact 4x4 boxes, so the reference can average them directly.
+	ECVDataPixelBuffer *const buffer = ECVCheckPixelBuffer(ECVCheckSourceSize, pixelFormat, 0);
+	ECVIntegerSize const size = {ECVCheckSourceSize.width / 4, ECVCheckSourceSize.height / 4};
+	size_t const bytesPerRow = size.width * 4;
+	UInt8 *const bytes = malloc(bytesPerRow * size.height);
+	[buffer lock];
+	[ECVPreviewRenderer drawPixelBuffer:buffer toBGRABytes:bytes bytesPerRow:bytesPerRow size:size];
+	NSUInteger x, y, i;
+	for(y = 0; y < size.height; y++) for(x = 0; x < size.width; x++) {
+		UInt8 expected[4];
+		ECVCheckReferencePixel(buffer, x * 4, y * 4, 4, 4, expected);
+		UInt8 const *const actual = bytes + y * bytesPerRow + x * 4;
+		for(i = 0; i < 4; i++) assert(abs((int)actual[i] - (int)expected[i]) <= 1); // Fixed point coefficients.
+	}
+	[buffer unlock];
+	free(bytes);
+}
+static void ECVCheckUniform(void)
+{
+	// Sizes that don't divide evenly still average a flat image to itself.
+	ECVDataPixelBuffer *const buffer = ECVCheckPixelBuffer(ECVCheckSourceSize, k2vuyPixelFormat, 0x80);
+	ECVIntegerSize const size = {173, 97};
+	size_t const bytesPerRow = size.width * 4;
+	UInt8 *const bytes = malloc(bytesPerRow * size.height);
+	UInt8 expected[4];
+	[buffer lock];
+	ECVCheckReferencePixel(buffer, 0, 0, 2, 1, expected);
+	[ECVPreviewRenderer drawPixelBuffer:buffer toBGRABytes:bytes bytesPerRow:bytesPerRow size:size];
+	[buffer unlock];
+	NSUInteger i = 0;
+	for(; i < bytesPerRow * size.height; i++) assert(abs((int)bytes[i] - (int)expected[i % 4]) <= 1);
+	free(bytes);
+}
+static void ECVCheckMosaic(NSArray *const buffers, UInt8 *const bytes, size_t const bytesPerRow)
+{
+	NSUInteger i = 0;
+	for(ECVPixelBuffer *const buffer in buffers) {
+		UInt8 *const tile = bytes + (i / 2) * ECVCheckTileSize.height * bytesPerRow + (i % 2) * ECVCheckTileSize.width * 4;
+		[buffer lock];
+		[ECVPreviewRenderer drawPixelBuffer:buffer toBGRABytes:tile bytesPerRow:bytesPerRow size:ECVCheckTileSize];
+		[buffer unlock];
+		i++;
+	}
+}
+static void ECVCheckWritePNG(UInt8 *const bytes, size_t const bytesPerRow, ECVIntegerSize const size, char const *const path)
+{
+	CGDataProviderRef const provider = CGDataProviderCreateWithData(NULL, bytes, bytesPerRow * size.height, NULL);
+	CGColorSpaceRef const colorSpace = CGColorSpaceCreateDeviceRGB();
+	CGImageRef const image = CGImageCreate(size.width, size.height, 8, 32, bytesPerRow, colorSpace, kCGImageAlphaNoneSkipFirst | kCGBitmapByteOrder32Little, provider, NULL, false, kCGRenderingIntentDefault);
+	NSURL *const URL = [NSURL fileURLWithPath:[NSString stringWithUTF8String:path]];
+	CGImageDestinationRef const destination = CGImageDestinationCreateWithURL((CFURLRef)URL, kUTTypePNG, 1, NULL);
+	assert(destination);
+	CGImageDestinationAddImage(destination, image, NULL);
+	assert(CGImageDestinationFinalize(destination));
+	CFRelease(destination);
+	CGImageRelease(image);
+	CGColorSpaceRelease(colorSpace);
+	CGDataProviderRelease(provider);
+}
+
+int main(int argc, char const *argv[])
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	srandom(1);
+
+	ECVCheckDownscale(k2vuyPixelFormat);
+	ECVCheckDownscale(kYVYU422PixelFormat);
+	ECVCheckUniform();
+
+	// A tile only touches its own part of the mosaic.
+	ECVIntegerSize const mosaicSize = {ECVCheckTileSize.width * 2, ECVCheckTileSize.height * 2};
+	size_t const bytesPerRow = mosaicSize.width * 4;
+	UInt8 *const bytes = malloc(bytesPerRow * mosaicSize.height);
+	memset(bytes, ECVCheckGuardByte, bytesPerRow * mosaicSize.height);
+	ECVCheckMosaic([NSArray arrayWithObject:ECVCheckPixelBuffer(ECVCheckSourceSize, k2vuyPixelFormat, 0)], bytes, bytesPerRow);
+	NSUInteger x, y;
+	for(y = 0; y < mosaicSize.height; y++) for(x = 0; x < mosaicSize.width; x++) {
+		BOOL const inTile = x < ECVCheckTileSize.width && y < ECVCheckTileSize.height;
+		assert(inTile == (0xff == bytes[y * bytesPerRow + x * 4 + 3]));
+	}
+
+	NSMutableArray *const buffers = [NSMutableArray array];
+	NSUInteger i;
+	for(i = 0; i < 4; i++) [buffers addObject:ECVCheckBarsPixelBuffer(ECVCheckSourceSize, i * 2)];
+	NSTimeInterval const startTime = [NSDate timeIntervalSinceReferenceDate];
+	for(i = 0; i < ECVCheckMosaicFrameCount; i++) ECVCheckMosaic(buffers, bytes, bytesPerRow);
+	NSTimeInterval const time = [NSDate timeIntervalSinceReferenceDate] - startTime;
+	printf("4-up %lux%lu mosaic: %.0f fps (30 needed), %.2f ms per frame\n", (unsigned long)mosaicSize.width, (unsigned long)mosaicSize.height, ECVCheckMosaicFrameCount / time, time / ECVCheckMosaicFrameCount * 1000.0);
+	if(argc > 1) ECVCheckWritePNG(bytes, bytesPerRow, mosaicSize, argv[1]);
+	free(bytes);
+
+	printf("ok\n");
+	[pool drain];
+	return EXIT_SUCCESS;
+}
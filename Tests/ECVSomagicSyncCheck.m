@@ -0,0 +1,123 @@
+/* Copyright (c) 2012, Ben Trask
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+// Sources: ECVSomagicSync.m
+// Also a benchmark: prints the scan rate next to the byte-at-a-time reference.
+#import "ECVCheck.h"
+
+// Other Sources
+#import "ECVSomagicSync.h"
+
+#define ECVCheckRowLength (720 * 2)
+#define ECVCheckPacketLength 1024
+
+NS_INLINE UInt64 ECVCheckRowStart(NSUInteger const offset, UInt8 const flags)
+{
+	return (UInt64)offset << 8 | flags;
+}
+static NSUInteger ECVCheckAppendSync(UInt8 *const bytes, UInt8 const flags)
+{
+	bytes[0] = 0xff;
+	bytes[1] = 0x00;
+	bytes[2] = 0x00;
+	bytes[3] = flags;
+	return 4;
+}
+static NSData *ECVCheckStream(NSUInteger const fieldCount, NSMutableData *const expected)
+{
+	NSUInteger const blankingRows = 19, activeRows = 240;
+	NSMutableData *const data = [NSMutableData dataWithLength:fieldCount * (blankingRows + activeRows) * (4 + ECVCheckRowLength + 4)];
+	UInt8 *const bytes = [data mutableBytes];
+	NSUInteger length = 0, field, row, i;
+	for(field = 0; field < fieldCount; field++) for(row = 0; row < blankingRows + activeRows; row++) {
+		UInt8 const flags = 0x80 | (field % 2 ? ECVSomagicLowField : 0) | (row < blankingRows ? ECVSomagicVerticalBlanking : 0);
+		length += ECVCheckAppendSync(bytes + length, flags);
+		UInt64 const start = ECVCheckRowStart(length, flags);
+		[expected appendBytes:&start length:sizeof(start)];
+		for(i = 0; i < ECVCheckRowLength; i++) bytes[length++] = (UInt8)(1 + ECVCheckRandomByte() % 0xfe); // Never 0xff in active video.
+		length += ECVCheckAppendSync(bytes + length, flags | ECVSomagicLineEnd); // End codes must not count as row starts.
+	}
+	[data setLength:length];
+	return data;
+}
+static BOOL ECVCheckReferenceGetStartOfRow(NSUInteger *const state, UInt8 *const pendingFlags, UInt8 const *const bytes, NSUInteger const length, NSUInteger *const outRow, UInt8 *const outFlags)
+{
+	NSUInteger i = 0;
+	for(; i < length; ++i) switch(*state) { // The scanner as it was before memchr().
+		case 0: if(0xff == bytes[i]) (*state)++; else *state = 0; break;
+		case 1: if(0x00 == bytes[i]) (*state)++; else *state = 0; break;
+		case 2: if(0x00 == bytes[i]) (*state)++; else *state = 0; break;
+		case 3: if(0x00 != bytes[i] && !(ECVSomagicLineEnd & bytes[i])) { (*state)++; *pendingFlags = bytes[i]; } else *state = 0; break;
+		case 4: *state = 0; *outRow = i; *outFlags = *pendingFlags; return YES;
+	}
+	return NO;
+}
+static NSData *ECVCheckScan(NSData *const stream, BOOL const reference, BOOL const randomPackets, NSTimeInterval *const outTime)
+{
+	NSMutableData *const starts = [NSMutableData data];
+	UInt8 const *const bytes = [stream bytes];
+	NSUInteger const length = [stream length];
+	NSUInteger state = 0;
+	UInt8 pendingFlags = 0;
+	NSTimeInterval const startTime = [NSDate timeIntervalSinceReferenceDate];
+	NSUInteger packet = 0;
+	while(packet < length) {
+		NSUInteger const packetLength = MIN(randomPackets ? 1 + random() % (ECVCheckPacketLength * 2) : ECVCheckPacketLength, length - packet); // Splits sync codes every possible way.
+		NSUInteger i = 0, row;
+		UInt8 flags;
+		while(i < packetLength && (reference ? ECVCheckReferenceGetStartOfRow : ECVSomagicGetStartOfRow)(&state, &pendingFlags, bytes + packet + i, packetLength - i, &row, &flags)) {
+			i += row;
+			UInt64 const start = ECVCheckRowStart(packet + i, flags);
+			[starts appendBytes:&start length:sizeof(start)];
+			i++;
+		}
+		packet += packetLength;
+	}
+	if(outTime) *outTime = [NSDate timeIntervalSinceReferenceDate] - startTime;
+	return starts;
+}
+
+int main(int argc, char const *argv[])
+{
+	NSAutoreleasePool *const pool = [[NSAutoreleasePool alloc] init];
+	srandom(1);
+
+	NSMutableData *const expected = [NSMutableData data];
+	NSData *const stream = ECVCheckStream(120, expected);
+	assert([ECVCheckScan(stream, YES, NO, NULL) isEqualToData:expected]);
+	assert([ECVCheckScan(stream, NO, NO, NULL) isEqualToData:expected]);
+	assert([ECVCheckScan(stream, NO, YES, NULL) isEqualToData:expected]);
+
+	NSTimeInterval referenceTime = 0.0, scanTime = 0.0, time;
+	NSUInteger i = 0;
+	for(; i < 10; i++) {
+		(void)ECVCheckScan(stream, YES, NO, &time);
+		referenceTime += time;
+		(void)ECVCheckScan(stream, NO, NO, &time);
+		scanTime += time;
+	}
+	double const megabytes = [stream length] * 10.0 / (1024.0 * 1024.0);
+	printf("byte at a time: %.0f MB/s, memchr(): %.0f MB/s\n", megabytes / referenceTime, megabytes / scanTime);
+
+	printf("ok\n");
+	[pool drain];
+	return EXIT_SUCCESS;
+}